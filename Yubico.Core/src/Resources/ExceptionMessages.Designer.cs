@@ -114,6 +114,15 @@ namespace Yubico.Core {
             }
         }
         
+        /// <summary>
+        ///   Looks up a localized string similar to The buffer length must be a positive multiple of the record length, with one checksum slot per record..
+        /// </summary>
+        internal static string CrcRecordLengthMismatch {
+            get {
+                return ResourceManager.GetString("CrcRecordLengthMismatch", resourceCulture);
+            }
+        }
+        
         /// <summary>
         ///   Looks up a localized string similar to The output span is not sufficient to contain the decoded output..
         /// </summary>
@@ -123,6 +132,42 @@ namespace Yubico.Core {
             }
         }
         
+        /// <summary>
+        ///   Looks up a localized string similar to The trace has no records that this replay device can use..
+        /// </summary>
+        internal static string DeviceTraceReplayEmpty {
+            get {
+                return ResourceManager.GetString("DeviceTraceReplayEmpty", resourceCulture);
+            }
+        }
+        
+        /// <summary>
+        ///   Looks up a localized string similar to The command does not match record {0} of the trace..
+        /// </summary>
+        internal static string DeviceTraceReplayMismatch {
+            get {
+                return ResourceManager.GetString("DeviceTraceReplayMismatch", resourceCulture);
+            }
+        }
+        
+        /// <summary>
+        ///   Looks up a localized string similar to The trace has no input report to return before the next output report, at record {0}..
+        /// </summary>
+        internal static string DeviceTraceReplayNoInputReport {
+            get {
+                return ResourceManager.GetString("DeviceTraceReplayNoInputReport", resourceCulture);
+            }
+        }
+        
+        /// <summary>
+        ///   Looks up a localized string similar to No record in the trace matches the command..
+        /// </summary>
+        internal static string DeviceTraceReplayNoMatch {
+            get {
+                return ResourceManager.GetString("DeviceTraceReplayNoMatch", resourceCulture);
+            }
+        }
+        
         /// <summary>
         ///   Looks up a localized string similar to The output span is not sufficient to contain the encoded output..
         /// </summary>
@@ -186,6 +231,15 @@ namespace Yubico.Core {
             }
         }
         
+        /// <summary>
+        ///   Looks up a localized string similar to An ATR prefix must be between 1 and 36 bytes long..
+        /// </summary>
+        internal static string InvalidAtrPrefix {
+            get {
+                return ResourceManager.GetString("InvalidAtrPrefix", resourceCulture);
+            }
+        }
+        
         /// <summary>
         ///   Looks up a localized string similar to The value, 0x{0x2}, is not a valid Base32 digit..
         /// </summary>
@@ -204,6 +258,15 @@ namespace Yubico.Core {
             }
         }
         
+        /// <summary>
+        ///   Looks up a localized string similar to The file is not a device trace, or was written by an incompatible version of the SDK..
+        /// </summary>
+        internal static string InvalidDeviceTraceFile {
+            get {
+                return ResourceManager.GetString("InvalidDeviceTraceFile", resourceCulture);
+            }
+        }
+        
         /// <summary>
         ///   Looks up a localized string similar to Invalid digit (0x{0}). Digit value must be 0x0 to 0x{1}..
         /// </summary>
@@ -222,6 +285,15 @@ namespace Yubico.Core {
             }
         }
         
+        /// <summary>
+        ///   Looks up a localized string similar to Reader name patterns must be non-empty, must contain only ASCII characters, and must not contain NUL characters..
+        /// </summary>
+        internal static string InvalidReaderNamePattern {
+            get {
+                return ResourceManager.GetString("InvalidReaderNamePattern", resourceCulture);
+            }
+        }
+        
         /// <summary>
         ///   Looks up a localized string similar to The buffer length must be large enough to hold the report, plus one additional byte that specifies a nonzero report ID or zero..
         /// </summary>
@@ -384,6 +456,15 @@ namespace Yubico.Core {
             }
         }
         
+        /// <summary>
+        ///   Looks up a localized string similar to The PC/SC provider could not be loaded..
+        /// </summary>
+        internal static string SCardProviderNotLoaded {
+            get {
+                return ResourceManager.GetString("SCardProviderNotLoaded", resourceCulture);
+            }
+        }
+        
         /// <summary>
         ///   Looks up a localized string similar to Unable to reconnect to the smart card..
         /// </summary>
@@ -393,6 +474,15 @@ namespace Yubico.Core {
             }
         }
         
+        /// <summary>
+        ///   Looks up a localized string similar to An error occurred while attempting to read the status of a connected smart card..
+        /// </summary>
+        internal static string SCardStatusFailed {
+            get {
+                return ResourceManager.GetString("SCardStatusFailed", resourceCulture);
+            }
+        }
+        
         /// <summary>
         ///   Looks up a localized string similar to Unable to begin a transaction with the given smart card..
         /// </summary>
@@ -411,6 +501,24 @@ namespace Yubico.Core {
             }
         }
         
+        /// <summary>
+        ///   Looks up a localized string similar to This smart card connection can only be used from the thread that opened it..
+        /// </summary>
+        internal static string SmartCardConnectionWrongThread {
+            get {
+                return ResourceManager.GetString("SmartCardConnectionWrongThread", resourceCulture);
+            }
+        }
+        
+        /// <summary>
+        ///   Looks up a localized string similar to The underlying smart card connection cannot report its status..
+        /// </summary>
+        internal static string SmartCardStatusNotSupported {
+            get {
+                return ResourceManager.GetString("SmartCardStatusNotSupported", resourceCulture);
+            }
+        }
+        
         /// <summary>
         ///   Looks up a localized string similar to The input does not build a valid schema..
         /// </summary>
@@ -456,6 +564,15 @@ namespace Yubico.Core {
             }
         }
         
+        /// <summary>
+        ///   Looks up a localized string similar to A device trace recorder is already active. Stop it before starting another..
+        /// </summary>
+        internal static string TraceRecorderAlreadyActive {
+            get {
+                return ResourceManager.GetString("TraceRecorderAlreadyActive", resourceCulture);
+            }
+        }
+        
         /// <summary>
         ///   Looks up a localized string similar to An unspecified error has been raised during the issuance of a command APDU..
         /// </summary>
@@ -33,66 +33,63 @@ namespace Yubico.Core.Buffers
     /// </remarks>
     public class Base16 : ITextEncoding
     {
+        private static readonly Base16 _sharedInstance = new Base16();
+
         private readonly Memory<char> _characterSet = "0123456789ABCDEF".ToCharArray();
+        private LookupTables? _lookupTables;
 
         /// <summary>
         /// The set of characters that correspond to numbers 0 - 16.
         /// </summary>
+        /// <remarks>
+        /// The set is read once, the first time an instance encodes or
+        /// decodes, and turned into that instance's lookup tables. An override
+        /// must always return the same characters, but they need not be
+        /// ASCII.
+        /// </remarks>
         protected virtual Span<char> CharacterSet => _characterSet.Span;
 
         /// <summary>
         /// Indicates the default case of characters for this encoding.
         /// </summary>
         /// <remarks>
-        /// This is used when decoding data to check for characters that are in
-        /// an unexpected case. To match nibbles (4-bit values) to a character,
-        /// we must change the case of the character to match what's expected.
-        /// For example, the reference string for ModHex is <c>cbdefghijklnrtuv</c>.
-        /// If we receive a 16-bit value in ModHex that looks like <c>CCCB</c>,
-        /// then the matching algorithm needs to know to change each character
-        /// as it is being evaluated to <c>cccb</c>.
+        /// Decoding is case-insensitive whatever this says. For example, the
+        /// reference string for ModHex is <c>cbdefghijklnrtuv</c>, and the
+        /// ModHex value <c>CCCB</c> decodes the same as <c>cccb</c>.
         /// </remarks>
         protected virtual bool DefaultLowerCase => false;
 
+        // Both tables are built from CharacterSet, so they serve Base16 and the
+        // encodings derived from it. A race to build them is harmless: both
+        // threads build the same tables.
+        private LookupTables Tables => _lookupTables ??= new LookupTables(CharacterSet);
+
         #region ITextEncoding Version
         /// <inheritdoc/>
         public void Encode(ReadOnlySpan<byte> data, Span<char> encoded)
         {
-            if (data.Length > (encoded.Length * 2))
+            if (encoded.Length < data.Length * 2)
             {
                 throw new ArgumentException(
                     nameof(encoded),
                     ExceptionMessages.EncodingOverflow);
             }
+
+            uint[] encodeTable = Tables.Encode;
+
             for (int i = 0; i < data.Length; ++i)
             {
-                int highestDigit = CharacterSet.Length - 1;
-                int digit1 = data[i] >> 4;
-                // Checking these so that BCD encode throws the right exception.
-                if (digit1 > highestDigit)
-                {
-                    throw new ArgumentException(
-                        string.Format(
-                            CultureInfo.CurrentCulture,
-                            ExceptionMessages.InvalidDigit,
-                            _characterSet.Span[digit1],
-                            _characterSet.Span[highestDigit]),
-                        nameof(data));
-                }
-                encoded[i * 2] = CharacterSet[digit1];
+                uint characters = encodeTable[data[i]];
 
-                int digit2 = data[i] & 0x0f;
-                if (digit2 > highestDigit)
+                // A nibble with no character (BCD digits above 9) leaves its
+                // half of the entry zero.
+                if ((characters & 0xFFFF) == 0 || (characters >> 16) == 0)
                 {
-                    throw new ArgumentException(
-                        string.Format(
-                            CultureInfo.CurrentCulture,
-                            ExceptionMessages.InvalidDigit,
-                            _characterSet.Span[digit2],
-                            _characterSet.Span[highestDigit]),
-                        nameof(data));
+                    throw InvalidDigitException(data[i], nameof(data));
                 }
-                encoded[(i * 2) + 1] = CharacterSet[digit2];
+
+                encoded[i * 2] = (char)(characters >> 16);
+                encoded[(i * 2) + 1] = (char)characters;
             }
         }
 
@@ -116,30 +113,11 @@ namespace Yubico.Core.Buffers
                 throw new ArgumentException(ExceptionMessages.DecodingOverflow);
             }
 
-            for (int i = 0; i < encoded.Length; ++i)
-            {
-                data[i / 2] = (byte)((GetNibble(encoded[i]) << 4) + GetNibble(encoded[++i]));
-            }
-
-            // The decoding needs to be case-insensitive. This lets us handle that
-            // in cases where the norm is upper or lower.
-            char HandleCase(char c) =>
-                DefaultLowerCase
-                ? (char)((c - 0x40) * (0x5b - c) > 0 ? c + 0x20 : c)
-                : (char)((c - 0x60) * (0x7b - c) > 0 ? c - 0x20 : c);
+            sbyte[] decodeTable = Tables.Decode;
 
-            int GetNibble(char c)
+            for (int i = 0; i < encoded.Length; i += 2)
             {
-                int n = CharacterSet.IndexOf(HandleCase(c));
-                if (n == -1)
-                {
-                    throw new ArgumentException(
-                        string.Format(
-                            CultureInfo.CurrentCulture,
-                            ExceptionMessages.IllegalCharacter,
-                            c));
-                }
-                return n;
+                data[i / 2] = (byte)((GetNibble(decodeTable, encoded[i]) << 4) | GetNibble(decodeTable, encoded[i + 1]));
             }
         }
 
@@ -159,19 +137,93 @@ namespace Yubico.Core.Buffers
         #region Static Version
         /// <inheritdoc cref="Encode(ReadOnlySpan{byte}, Span{char})"/>
         public static void EncodeBytes(ReadOnlySpan<byte> data, Span<char> encoded) =>
-            new Base16().Encode(data, encoded);
+            _sharedInstance.Encode(data, encoded);
 
         /// <inheritdoc cref="Encode(ReadOnlySpan{byte})"/>
         public static string EncodeBytes(ReadOnlySpan<byte> data) =>
-            new Base16().Encode(data);
+            _sharedInstance.Encode(data);
 
         /// <inheritdoc cref="Decode(ReadOnlySpan{char}, Span{byte})"/>
         public static void DecodeText(ReadOnlySpan<char> encoded, Span<byte> data) =>
-            new Base16().Decode(encoded, data);
+            _sharedInstance.Decode(encoded, data);
 
         /// <inheritdoc cref="Decode(string)"/>
         public static byte[] DecodeText(string encoded) =>
-            new Base16().Decode(encoded);
+            _sharedInstance.Decode(encoded);
         #endregion
+
+        private static int GetNibble(sbyte[] decodeTable, char c)
+        {
+            int nibble = c < decodeTable.Length ? decodeTable[c] : -1;
+
+            if (nibble < 0)
+            {
+                throw new ArgumentException(
+                    string.Format(
+                        CultureInfo.CurrentCulture,
+                        ExceptionMessages.IllegalCharacter,
+                        c));
+            }
+
+            return nibble;
+        }
+
+        private ArgumentException InvalidDigitException(byte value, string paramName)
+        {
+            int highestDigit = Tables.DigitCount - 1;
+            int digit = (value >> 4) > highestDigit ? value >> 4 : value & 0x0f;
+
+            return new ArgumentException(
+                string.Format(
+                    CultureInfo.CurrentCulture,
+                    ExceptionMessages.InvalidDigit,
+                    _characterSet.Span[digit],
+                    _characterSet.Span[highestDigit]),
+                paramName);
+        }
+
+        private sealed class LookupTables
+        {
+            // The number of characters in the set; BCD has fewer than 16.
+            public readonly int DigitCount;
+
+            // For each byte value, its high nibble's character in the upper 16
+            // bits and its low nibble's character in the lower 16 bits.
+            public readonly uint[] Encode = new uint[256];
+
+            // For each character up to the highest one in the set, the nibble
+            // it stands for in either case, or -1.
+            public readonly sbyte[] Decode;
+
+            public LookupTables(ReadOnlySpan<char> characterSet)
+            {
+                DigitCount = characterSet.Length;
+
+                int highest = 0;
+
+                foreach (char c in characterSet)
+                {
+                    highest = Math.Max(highest, Math.Max(char.ToUpperInvariant(c), char.ToLowerInvariant(c)));
+                }
+
+                Decode = new sbyte[highest + 1];
+
+                for (int value = 0; value < Encode.Length; value++)
+                {
+                    uint high = (value >> 4) < DigitCount ? characterSet[value >> 4] : 0u;
+                    uint low = (value & 0x0f) < DigitCount ? characterSet[value & 0x0f] : 0u;
+                    Encode[value] = (high << 16) | low;
+                }
+
+                Decode.AsSpan().Fill(-1);
+
+                for (int nibble = 0; nibble < DigitCount; nibble++)
+                {
+                    char c = characterSet[nibble];
+                    Decode[char.ToUpperInvariant(c)] = (sbyte)nibble;
+                    Decode[char.ToLowerInvariant(c)] = (sbyte)nibble;
+                }
+            }
+        }
     }
 }
@@ -24,6 +24,14 @@ namespace Yubico.Core.Buffers
     public class Base32 : ITextEncoding
     {
         private const int Base32Mask = 0x1f;
+        private const string Alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+
+        // For each ASCII character, the five bits it stands for, or -1. Base32
+        // isn't supposed to include lower-case letters, but some of our tests
+        // do, so both cases are accepted.
+        private static readonly sbyte[] _decodeTable = CreateDecodeTable();
+
+        private static readonly Base32 _sharedInstance = new Base32();
 
         #region ITextEncoding Version
         /// <inheritdoc />
@@ -49,28 +57,42 @@ namespace Yubico.Core.Buffers
                     ExceptionMessages.EncodingOverflow);
             }
 
-            int ch = 0, bits = 5, index = 0;
-            foreach (byte b in data)
+            // Every five bytes are exactly eight digits, so take them forty
+            // bits at a time.
+            int index = 0, offset = 0;
+            for (; offset + 5 <= data.Length; offset += 5)
             {
-                ch |= b >> (8 - bits);
-                encoded[index++] = EncodeBase32Digit(ch);
+                ulong block =
+                    ((ulong)data[offset] << 32)
+                    | ((ulong)data[offset + 1] << 24)
+                    | ((ulong)data[offset + 2] << 16)
+                    | ((ulong)data[offset + 3] << 8)
+                    | data[offset + 4];
 
-                if (bits < 4)
+                for (int shift = 35; shift >= 0; shift -= 5)
                 {
-                    ch = (b >> (3 - bits)) & Base32Mask;
-                    encoded[index++] = EncodeBase32Digit(ch);
-                    bits += 5;
+                    encoded[index++] = Alphabet[(int)(block >> shift) & Base32Mask];
                 }
-
-                bits -= 3;
-                ch = (b << bits) & Base32Mask;
             }
 
-            // Handle stray bits at the end.
-            if (index != encodedSize)
+            // Handle stray bytes at the end: their bits padded out with zeros
+            // to whole digits, then '=' up to a multiple of eight digits.
+            int remaining = data.Length - offset;
+            if (remaining > 0)
             {
-                encoded[index++] = EncodeBase32Digit(ch);
-                encoded[index..].Fill('=');
+                ulong block = 0;
+                for (int i = 0; i < remaining; i++)
+                {
+                    block |= (ulong)data[offset + i] << (32 - (8 * i));
+                }
+
+                int digitCount = ((remaining * 8) + 4) / 5;
+                for (int i = 0; i < digitCount; i++)
+                {
+                    encoded[index++] = Alphabet[(int)(block >> (35 - (5 * i))) & Base32Mask];
+                }
+
+                encoded[index..encodedSize].Fill('=');
             }
         }
 
@@ -87,56 +109,53 @@ namespace Yubico.Core.Buffers
             // the right padding. I don't think we need to, though.
             encoded = StripPadding(encoded);
 
-            byte curByte = 0, bits = 8;
-            int mask, index = 0;
-            foreach (int c in encoded)
+            // Eight digits are exactly five bytes.
+            int index = 0, offset = 0;
+            for (; offset + 8 <= encoded.Length; offset += 8)
             {
-                // Base32 isn't supposed to include lower-case letters, but
-                // some of our tests do, so we'll just do a cheap ToUpper.
-                int base32 = (c - 0x60) * (0x7b - c) > 0
-                    ? c - 0x20
-                    : c;
-
-                // The five bits (0 - 0x1f) are represented by A-Z and 2-7.
-                if ((base32 - 0x40) * (0x5b - base32) > 0) // Handle A-Z.
+                ulong block = 0;
+                int invalid = 0;
+                for (int i = 0; i < 8; i++)
                 {
-                    base32 -= 0x41;
+                    int digit = LookUpDigit(encoded[offset + i]);
+                    invalid |= digit;
+                    block = (block << 5) | (uint)(digit & Base32Mask);
                 }
-                else if ((base32 - 0x31) * (0x38 - base32) > 0) // Handle 2 - 7.
-                {
-                    base32 -= 0x18;
-                }
-                else
+
+                if (invalid < 0)
                 {
-                    throw new ArgumentException(
-                        string.Format(
-                            CultureInfo.CurrentCulture,
-                            ExceptionMessages.IllegalCharacter,
-                            c),
-                            nameof(encoded));
+                    throw IllegalCharacterException(encoded.Slice(offset, 8), nameof(encoded));
                 }
 
-                if (bits > 5)
+                data[index] = (byte)(block >> 32);
+                data[index + 1] = (byte)(block >> 24);
+                data[index + 2] = (byte)(block >> 16);
+                data[index + 3] = (byte)(block >> 8);
+                data[index + 4] = (byte)block;
+                index += 5;
+            }
+
+            // The digits left over make whole bytes plus fewer than eight stray
+            // bits, which are dropped.
+            uint buffer = 0;
+            int bits = 0;
+            for (; offset < encoded.Length; offset++)
+            {
+                int digit = LookUpDigit(encoded[offset]);
+                if (digit < 0)
                 {
-                    mask = base32 << (bits - 5);
-                    curByte = (byte)(curByte | mask);
-                    bits -= 5;
+                    throw IllegalCharacterException(encoded.Slice(offset, 1), nameof(encoded));
                 }
-                else
+
+                buffer = (buffer << 5) | (uint)digit;
+                bits += 5;
+
+                if (bits >= 8)
                 {
-                    mask = base32 >> (5 - bits);
-                    curByte = (byte)(curByte | mask);
-                    data[index++] = curByte;
-                    curByte = (byte)(base32 << (3 + bits));
-                    bits += 3;
+                    bits -= 8;
+                    data[index++] = (byte)(buffer >> bits);
                 }
             }
-
-            // If there are stray bits, handle them.
-            if (index != byteCount)
-            {
-                data[index] = curByte;
-            }
         }
 
         /// <inheritdoc />
@@ -156,19 +175,19 @@ namespace Yubico.Core.Buffers
         #region Static Version
         /// <inheritdoc cref="Encode(ReadOnlySpan{byte}, Span{char})"/>
         public static void EncodeBytes(ReadOnlySpan<byte> data, Span<char> encoded) =>
-            new Base32().Encode(data, encoded);
+            _sharedInstance.Encode(data, encoded);
 
         /// <inheritdoc cref="Encode(ReadOnlySpan{byte})" />
         public static string EncodeBytes(ReadOnlySpan<byte> data) =>
-            new Base32().Encode(data);
+            _sharedInstance.Encode(data);
 
         /// <inheritdoc cref="Decode(ReadOnlySpan{char}, Span{byte})"/>
         public static void DecodeText(ReadOnlySpan<char> encoded, Span<byte> data) =>
-            new Base32().Decode(encoded, data);
+            _sharedInstance.Decode(encoded, data);
 
         /// <inheritdoc cref="Decode(string)"/>
         public static byte[] DecodeText(string encoded) =>
-            new Base32().Decode(encoded);
+            _sharedInstance.Decode(encoded);
         #endregion
 
         #region Static Utility Methods
@@ -208,16 +227,41 @@ namespace Yubico.Core.Buffers
             return encoded.Slice(0, length);
         }
 
-        private static char EncodeBase32Digit(int b) =>
-            b < 0x1a // If the value is less than 0x1a, it's an upper case letter.
-            ? (char)(b + 0x41) // So add the value of 'A'.
-            : b < 0x20 // Otherwise, if the value is less than 0x20, it's a number (2 - 7).
-                ? (char)(b + 0x18) // So add the value of '2'.
-                : throw new ArgumentException( // Nope, no soup for you.
-                    string.Format(
-                        CultureInfo.CurrentCulture,
-                        ExceptionMessages.InvalidBase32Digit, b),
-                        nameof(b));
+        private static int LookUpDigit(char c) => c < _decodeTable.Length ? _decodeTable[c] : -1;
+
+        private static ArgumentException IllegalCharacterException(ReadOnlySpan<char> digits, string paramName)
+        {
+            int c = digits[0];
+            foreach (char digit in digits)
+            {
+                if (LookUpDigit(digit) < 0)
+                {
+                    c = digit;
+                    break;
+                }
+            }
+
+            return new ArgumentException(
+                string.Format(
+                    CultureInfo.CurrentCulture,
+                    ExceptionMessages.IllegalCharacter,
+                    c),
+                    paramName);
+        }
+
+        private static sbyte[] CreateDecodeTable()
+        {
+            sbyte[] table = new sbyte[128];
+            table.AsSpan().Fill(-1);
+
+            for (int digit = 0; digit < Alphabet.Length; digit++)
+            {
+                table[Alphabet[digit]] = (sbyte)digit;
+                table[char.ToLowerInvariant(Alphabet[digit])] = (sbyte)digit;
+            }
+
+            return table;
+        }
         #endregion
     }
 }
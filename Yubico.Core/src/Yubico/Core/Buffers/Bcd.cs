@@ -31,6 +31,8 @@ namespace Yubico.Core.Buffers
         // things that Base16 doesn't, like checking for digits out of range.
         // It seems worth the slight mismatch to not have to duplicate a bunch
         // of code.
+        private static readonly Bcd _sharedInstance = new Bcd();
+
         private readonly Memory<char> _characterSet = "0123456789".ToCharArray();
 
         /// <inheritdoc/>
@@ -39,19 +41,19 @@ namespace Yubico.Core.Buffers
         #region Static Version
         /// <inheritdoc />
         public static new void EncodeBytes(ReadOnlySpan<byte> data, Span<char> encoded) =>
-            new Bcd().Encode(data, encoded);
+            _sharedInstance.Encode(data, encoded);
 
         /// <inheritdoc />
         public static new string EncodeBytes(ReadOnlySpan<byte> data) =>
-            new Bcd().Encode(data);
+            _sharedInstance.Encode(data);
 
         /// <inheritdoc />
         public static new void DecodeText(ReadOnlySpan<char> encoded, Span<byte> data) =>
-            new Bcd().Decode(encoded, data);
+            _sharedInstance.Decode(encoded, data);
 
         /// <inheritdoc />
         public static new byte[] DecodeText(string encoded) =>
-            new Bcd().Decode(encoded);
+            _sharedInstance.Decode(encoded);
         #endregion
     }
 }
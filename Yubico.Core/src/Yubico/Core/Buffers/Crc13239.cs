@@ -19,36 +19,128 @@ namespace Yubico.Core.Buffers
     /// <summary>
     /// Utility class for calculating and verifying the CRC13239 checksum used in YubiKey products.
     /// </summary>
+    /// <remarks>
+    /// The checksum is computed eight bytes at a time using the slicing-by-8 method: eight 256-entry tables give the
+    /// contribution of a byte at each of the eight positions in a block, so a block costs eight lookups instead of
+    /// sixty-four shift-and-test steps. The result is identical to the bit-at-a-time definition.
+    /// </remarks>
     public static class Crc13239
     {
         private const ushort InitialValue = 0xFFFF;
         private const ushort GeneratorPolynomial = 0x8408;
 
+        private const int TableSize = 256;
+        private const int SliceCount = 8;
+
+        // Table k (at offset k * TableSize) holds the CRC of a byte followed by k zero bytes.
+        private static readonly ushort[] _tables = CreateTables();
+
         /// <summary>
         /// Calculates a CRC13239 checksum over a byte buffer.
         /// </summary>
         /// <param name="buffer">The buffer to be checksummed.</param>
         /// <returns>A two byte CRC checksum.</returns>
-        public static short Calculate(ReadOnlySpan<byte> buffer)
+        public static short Calculate(ReadOnlySpan<byte> buffer) => unchecked((short)Update(InitialValue, buffer));
+
+        /// <summary>
+        /// Calculates a CRC13239 checksum for each of a sequence of equally sized records, such as OTP tickets.
+        /// </summary>
+        /// <param name="records">The records to be checksummed, laid out back to back.</param>
+        /// <param name="recordLength">The length, in bytes, of each record.</param>
+        /// <param name="checksums">
+        /// Receives the checksum of each record, in order. It must have room for <c>records.Length / recordLength</c>
+        /// values.
+        /// </param>
+        /// <returns>The number of checksums written.</returns>
+        /// <exception cref="ArgumentException">
+        /// <paramref name="recordLength"/> is not positive, <paramref name="records"/> is not a whole number of
+        /// records, or <paramref name="checksums"/> is too small.
+        /// </exception>
+        public static int Calculate(ReadOnlySpan<byte> records, int recordLength, Span<short> checksums)
+        {
+            if (recordLength <= 0)
+            {
+                throw new ArgumentException(ExceptionMessages.CrcRecordLengthMismatch, nameof(recordLength));
+            }
+
+            int recordCount = records.Length / recordLength;
+
+            if (recordCount * recordLength != records.Length)
+            {
+                throw new ArgumentException(ExceptionMessages.CrcRecordLengthMismatch, nameof(records));
+            }
+
+            if (checksums.Length < recordCount)
+            {
+                throw new ArgumentException(ExceptionMessages.CrcRecordLengthMismatch, nameof(checksums));
+            }
+
+            for (int i = 0; i < recordCount; i++)
+            {
+                checksums[i] = unchecked((short)Update(InitialValue, records.Slice(i * recordLength, recordLength)));
+            }
+
+            return recordCount;
+        }
+
+        private static ushort Update(ushort crc, ReadOnlySpan<byte> buffer)
         {
-            ushort remainderPolynomial = InitialValue;
+            ushort[] tables = _tables;
+            int offset = 0;
+
+            for (; buffer.Length - offset >= SliceCount; offset += SliceCount)
+            {
+                crc = (ushort)(
+                    tables[(7 * TableSize) + (byte)(buffer[offset] ^ crc)]
+                    ^ tables[(6 * TableSize) + (byte)(buffer[offset + 1] ^ (crc >> 8))]
+                    ^ tables[(5 * TableSize) + buffer[offset + 2]]
+                    ^ tables[(4 * TableSize) + buffer[offset + 3]]
+                    ^ tables[(3 * TableSize) + buffer[offset + 4]]
+                    ^ tables[(2 * TableSize) + buffer[offset + 5]]
+                    ^ tables[TableSize + buffer[offset + 6]]
+                    ^ tables[buffer[offset + 7]]);
+            }
 
-            foreach (byte currentByte in buffer)
+            for (; offset < buffer.Length; offset++)
             {
-                remainderPolynomial ^= currentByte;
+                crc = (ushort)((crc >> 8) ^ tables[(byte)(crc ^ buffer[offset])]);
+            }
+
+            return crc;
+        }
+
+        private static ushort[] CreateTables()
+        {
+            ushort[] tables = new ushort[SliceCount * TableSize];
+
+            for (int value = 0; value < TableSize; value++)
+            {
+                ushort remainderPolynomial = (ushort)value;
+
                 for (int bitCounter = 0; bitCounter < 8; bitCounter++)
                 {
-                    byte leastSignificantBit = (byte)(remainderPolynomial & 1);
+                    bool leastSignificantBit = (remainderPolynomial & 1) != 0;
                     remainderPolynomial >>= 1;
 
-                    if (leastSignificantBit != 0)
+                    if (leastSignificantBit)
                     {
                         remainderPolynomial ^= GeneratorPolynomial;
                     }
                 }
+
+                tables[value] = remainderPolynomial;
+            }
+
+            for (int slice = 1; slice < SliceCount; slice++)
+            {
+                for (int value = 0; value < TableSize; value++)
+                {
+                    ushort previous = tables[((slice - 1) * TableSize) + value];
+                    tables[(slice * TableSize) + value] = (ushort)((previous >> 8) ^ tables[(byte)previous]);
+                }
             }
 
-            return unchecked((short)remainderPolynomial);
+            return tables;
         }
     }
 }
@@ -21,6 +21,8 @@ namespace Yubico.Core.Buffers
     /// </summary>
     public class ModHex : Base16
     {
+        private static readonly ModHex _sharedInstance = new ModHex();
+
         private readonly Memory<char> _characterSet = "cbdefghijklnrtuv".ToCharArray();
 
         /// <inheritdoc/>
@@ -32,19 +34,19 @@ namespace Yubico.Core.Buffers
         #region Static Version
         /// <inheritdoc />
         public static new void EncodeBytes(ReadOnlySpan<byte> data, Span<char> encoded) =>
-            new ModHex().Encode(data, encoded);
+            _sharedInstance.Encode(data, encoded);
 
         /// <inheritdoc />
         public static new string EncodeBytes(ReadOnlySpan<byte> data) =>
-            new ModHex().Encode(data);
+            _sharedInstance.Encode(data);
 
         /// <inheritdoc />
         public static new void DecodeText(ReadOnlySpan<char> encoded, Span<byte> data) =>
-            new ModHex().Decode(encoded, data);
+            _sharedInstance.Decode(encoded, data);
 
         /// <inheritdoc />
         public static new byte[] DecodeText(string encoded) =>
-            new ModHex().Decode(encoded);
+            _sharedInstance.Decode(encoded);
         #endregion
 
     }
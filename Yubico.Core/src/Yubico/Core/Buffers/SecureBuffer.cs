@@ -0,0 +1,112 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using System.Security.Cryptography;
+using System.Threading;
+
+namespace Yubico.Core.Buffers
+{
+    /// <summary>
+    /// A buffer rented from a <see cref="SecureBufferPool"/>. Disposing it zeroes its contents and returns it to the
+    /// pool.
+    /// </summary>
+    /// <remarks>
+    /// A pooled buffer is a slice of memory shared with the pool's other buffers. Once it has been disposed, the same
+    /// memory can be handed to another caller in a new <see cref="SecureBuffer"/>, so every member of this one that
+    /// exposes the contents throws <see cref="ObjectDisposedException"/> from then on.
+    /// </remarks>
+    public sealed class SecureBuffer : IDisposable
+    {
+        private readonly ArraySegment<byte> _segment;
+        private readonly SecureBufferPool? _pool;
+        private int _rented;
+
+        internal SecureBuffer(ArraySegment<byte> segment, SecureBufferPool? pool, bool isLocked)
+        {
+            _segment = segment;
+            _pool = pool;
+            _rented = 1;
+            IsLocked = isLocked;
+        }
+
+        /// <summary>
+        /// The buffer as a segment of its underlying array.
+        /// </summary>
+        /// <remarks>
+        /// Use this only to pass the buffer to an API that takes an array, an offset and a count. The array is shared
+        /// with other buffers: touch only the range the segment covers, and do not keep a reference to it after the
+        /// buffer has been disposed.
+        /// </remarks>
+        /// <exception cref="ObjectDisposedException">The buffer has been disposed.</exception>
+        public ArraySegment<byte> Segment
+        {
+            get
+            {
+                ThrowIfDisposed();
+
+                return _segment;
+            }
+        }
+
+        /// <summary>
+        /// The length of the buffer, in bytes.
+        /// </summary>
+        public int Length => _segment.Count;
+
+        /// <summary>
+        /// The buffer as a <see cref="Span{T}"/>.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">The buffer has been disposed.</exception>
+        public Span<byte> Span => Segment.AsSpan();
+
+        /// <summary>
+        /// The buffer as a <see cref="Memory{T}"/>.
+        /// </summary>
+        /// <exception cref="ObjectDisposedException">The buffer has been disposed.</exception>
+        public Memory<byte> Memory => Segment.AsMemory();
+
+        /// <summary>
+        /// Whether the buffer's pages are locked into physical memory, and therefore never written to swap.
+        /// </summary>
+        public bool IsLocked { get; }
+
+        /// <summary>
+        /// Whether the buffer is pinned and will be reused by its pool once disposed.
+        /// </summary>
+        public bool IsPooled => !(_pool is null);
+
+        /// <summary>
+        /// Zeroes the buffer and returns it to its pool. Calling this more than once has no further effect.
+        /// </summary>
+        public void Dispose()
+        {
+            if (Interlocked.Exchange(ref _rented, 0) == 0)
+            {
+                return;
+            }
+
+            CryptographicOperations.ZeroMemory(_segment.AsSpan());
+            _pool?.Return(_segment);
+        }
+
+        private void ThrowIfDisposed()
+        {
+            if (Volatile.Read(ref _rented) == 0)
+            {
+                throw new ObjectDisposedException(nameof(SecureBuffer));
+            }
+        }
+    }
+}
@@ -0,0 +1,188 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using System.Security.Cryptography;
+using Yubico.PlatformInterop;
+
+namespace Yubico.Core.Buffers
+{
+    /// <summary>
+    /// A pool of pinned, page-locked buffers for short-lived secrets such as PINs, management keys and session keys.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// A buffer allocated with <c>new byte[]</c> can be moved by the garbage collector before it is zeroed, leaving
+    /// copies of its contents elsewhere in the managed heap, and its pages can be written to swap. The first time a
+    /// buffer is rented, the pool allocates a single slab on the large object heap, pins it and locks its first
+    /// <see cref="MaximumPinnedBytes"/> bytes into physical memory through the native shim where the platform allows
+    /// it. Every pooled buffer is a slice of that slab, so neither can happen to it. Every buffer is zeroed when it is
+    /// disposed.
+    /// </para>
+    /// <para>
+    /// Slices are pooled by exact length. Each rental gets a new <see cref="SecureBuffer"/>, so a buffer that has been
+    /// disposed keeps throwing <see cref="ObjectDisposedException"/> even after its slice has been handed out again. Pass <see cref="SecureBuffer.Span"/> or <see cref="SecureBuffer.Memory"/>
+    /// to APIs that accept them, and <see cref="SecureBuffer.Segment"/> to APIs that take an array, offset and count.
+    /// Once the slab is used up, further rentals are served with ordinary arrays that are still zeroed on disposal,
+    /// but are not pinned or locked and are not pooled.
+    /// </para>
+    /// </remarks>
+    public sealed class SecureBufferPool
+    {
+        /// <summary>
+        /// The default value of <see cref="MaximumPinnedBytes"/>, 64 KiB.
+        /// </summary>
+        public const int DefaultMaximumPinnedBytes = 64 * 1024;
+
+        // Arrays this large go straight to the large object heap, which is not compacted, so pinning the slab for the
+        // life of the pool does not fragment the generations the collector compacts often.
+        private const int LargeObjectHeapThreshold = 85000;
+
+        private static bool _lockingUnavailable;
+
+        private readonly object _syncRoot = new object();
+        private readonly Dictionary<int, Stack<ArraySegment<byte>>> _available =
+            new Dictionary<int, Stack<ArraySegment<byte>>>();
+        private byte[]? _slab;
+        private GCHandle _slabHandle;
+        private bool _slabLocked;
+        private int _slabUsed;
+
+        /// <summary>
+        /// The pool shared by the SDK.
+        /// </summary>
+        public static SecureBufferPool Shared { get; } = new SecureBufferPool(DefaultMaximumPinnedBytes);
+
+        /// <summary>
+        /// The number of pinned bytes that pooled buffers are carved from.
+        /// </summary>
+        public int MaximumPinnedBytes { get; }
+
+        /// <summary>
+        /// Creates a pool that pins at most <paramref name="maximumPinnedBytes"/> bytes.
+        /// </summary>
+        /// <param name="maximumPinnedBytes">The pinned memory budget, in bytes.</param>
+        /// <exception cref="ArgumentOutOfRangeException">
+        /// <paramref name="maximumPinnedBytes"/> is negative.
+        /// </exception>
+        public SecureBufferPool(int maximumPinnedBytes)
+        {
+            if (maximumPinnedBytes < 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(maximumPinnedBytes));
+            }
+
+            MaximumPinnedBytes = maximumPinnedBytes;
+        }
+
+        // Only reached for pools other than Shared. No buffer can still be in use: every SecureBuffer carved from the
+        // slab holds a reference to this pool.
+        ~SecureBufferPool()
+        {
+            if (_slabHandle.IsAllocated)
+            {
+                CryptographicOperations.ZeroMemory(_slab);
+                _slabHandle.Free();
+            }
+        }
+
+        /// <summary>
+        /// Rents a zeroed buffer of exactly <paramref name="length"/> bytes.
+        /// </summary>
+        /// <remarks>
+        /// Dispose the buffer, typically with a <c>using</c> statement, to zero it and return it to the pool. The
+        /// buffer must not be used after it has been disposed.
+        /// </remarks>
+        /// <param name="length">The length of the buffer, in bytes.</param>
+        /// <returns>A zeroed buffer of the requested length.</returns>
+        /// <exception cref="ArgumentOutOfRangeException">
+        /// <paramref name="length"/> is negative.
+        /// </exception>
+        public SecureBuffer Rent(int length)
+        {
+            if (length < 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(length));
+            }
+
+            lock (_syncRoot)
+            {
+                if (_available.TryGetValue(length, out Stack<ArraySegment<byte>>? segments) && segments.Count > 0)
+                {
+                    return new SecureBuffer(segments.Pop(), this, _slabLocked);
+                }
+
+                if (length == 0 || _slabUsed + length > MaximumPinnedBytes)
+                {
+                    return new SecureBuffer(new ArraySegment<byte>(new byte[length]), null, false);
+                }
+
+                if (_slab is null)
+                {
+                    CreateSlab();
+                }
+
+                var segment = new ArraySegment<byte>(_slab!, _slabUsed, length);
+                _slabUsed += length;
+
+                return new SecureBuffer(segment, this, _slabLocked);
+            }
+        }
+
+        // Called by SecureBuffer.Dispose, after the slice has been zeroed.
+        internal void Return(ArraySegment<byte> segment)
+        {
+            lock (_syncRoot)
+            {
+                if (!_available.TryGetValue(segment.Count, out Stack<ArraySegment<byte>>? segments))
+                {
+                    segments = new Stack<ArraySegment<byte>>();
+                    _available.Add(segment.Count, segments);
+                }
+
+                segments.Push(segment);
+            }
+        }
+
+        // One allocation, one pin and one lock call for the life of the pool, however many buffers are carved from it.
+        private void CreateSlab()
+        {
+            _slab = new byte[Math.Max(MaximumPinnedBytes, LargeObjectHeapThreshold)];
+            _slabHandle = GCHandle.Alloc(_slab, GCHandleType.Pinned);
+            _slabLocked = TryLockMemory(_slabHandle.AddrOfPinnedObject(), MaximumPinnedBytes);
+        }
+
+        private static bool TryLockMemory(IntPtr address, int length)
+        {
+            if (_lockingUnavailable)
+            {
+                return false;
+            }
+
+            try
+            {
+                return NativeMethods.LockMemory(address, (UIntPtr)length) == 0;
+            }
+            catch (Exception e) when (e is DllNotFoundException || e is EntryPointNotFoundException)
+            {
+                // An older native shim, or none at all. The buffers are still pinned and zeroed.
+                _lockingUnavailable = true;
+
+                return false;
+            }
+        }
+    }
+}
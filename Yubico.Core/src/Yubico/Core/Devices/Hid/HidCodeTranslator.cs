@@ -33,8 +33,24 @@ namespace Yubico.Core.Devices.Hid
             Dictionary<byte, char> byCode,
             KeyboardLayout keyboardLayout)
         {
-            _byChar = byChar;
-            _byCode = byCode;
+            // The layout files are easiest to read and generate as dictionaries,
+            // but every lookup goes through dense tables indexed by the HID code
+            // or character. No layout maps HID code 0x00 or the NUL character,
+            // so zero marks an unmapped entry.
+            _charByCode = new char[256];
+            foreach (KeyValuePair<byte, char> pair in byCode)
+            {
+                _charByCode[pair.Key] = pair.Value;
+            }
+
+            _codeByChar = new byte[byChar.Keys.Max() + 1];
+            foreach (KeyValuePair<char, byte> pair in byChar)
+            {
+                _codeByChar[pair.Key] = pair.Value;
+            }
+
+            _supportedCharacters = new string(byChar.Keys.ToArray());
+            _supportedHidCodes = byCode.Keys.ToArray();
             Layout = keyboardLayout;
         }
         #endregion
@@ -52,8 +68,10 @@ namespace Yubico.Core.Devices.Hid
                 [KeyboardLayout.sv_SE] = GetSV_SE(),
                 [KeyboardLayout.ModHex] = GetModHex()
             };
-        private readonly Dictionary<char, byte> _byChar;
-        private readonly Dictionary<byte, char> _byCode;
+        private readonly char[] _charByCode;
+        private readonly byte[] _codeByChar;
+        private readonly string _supportedCharacters;
+        private readonly byte[] _supportedHidCodes;
         #endregion
 
         #region Index operators for chars and HID codes
@@ -72,9 +90,9 @@ namespace Yubico.Core.Devices.Hid
         {
             get
             {
-                if (_byChar.TryGetValue(ch, out byte value))
+                if (ch < _codeByChar.Length && _codeByChar[ch] != 0)
                 {
-                    return value;
+                    return _codeByChar[ch];
                 }
                 throw new ArgumentOutOfRangeException(
                     string.Format(
@@ -98,7 +116,8 @@ namespace Yubico.Core.Devices.Hid
         {
             get
             {
-                if (_byCode.TryGetValue(hidCode, out char value))
+                char value = _charByCode[hidCode];
+                if (value != '\0')
                 {
                     return value;
                 }
@@ -122,6 +141,9 @@ namespace Yubico.Core.Devices.Hid
         // afterwards.
         private const byte _shift = 0x80;
 
+        // Longest string GetString will assemble on the stack.
+        private const int _maxStackChars = 256;
+
         #region Instance Properties
         /// <summary>
         /// Gets a <see cref="KeyboardLayout"/> specific instance of this class.
@@ -140,20 +162,23 @@ namespace Yubico.Core.Devices.Hid
         /// A string representation of all of the characters supported by this
         /// <see cref="HidCodeTranslator"/> instance.
         /// </summary>
-        public string SupportedCharactersString => new string(_byChar.Keys.ToArray());
+        public string SupportedCharactersString => _supportedCharacters;
 
         /// <summary>
         /// An array of chars respresenting all of the characters supported
         /// by this <see cref="HidCodeTranslator"/> instance.
         /// </summary>
-        public IEnumerable<char> SupportedCharacters => _byChar.Keys;
+        public IEnumerable<char> SupportedCharacters => _supportedCharacters;
 
         /// <summary>
         /// An array of bytes representing all of the HID codes supported
         /// by this <see cref="HidCodeTranslator"/> instance.
         /// </summary>
+        /// <remarks>
+        /// Each access returns a new copy of the array.
+        /// </remarks>
 #pragma warning disable CA1819 // Justification: SupportedHidCodes should be a byte array
-        public byte[] SupportedHidCodes => _byCode.Keys.ToArray();
+        public byte[] SupportedHidCodes => (byte[])_supportedHidCodes.Clone();
 #pragma warning restore CA1819
         #endregion
 
@@ -174,7 +199,40 @@ namespace Yubico.Core.Devices.Hid
         /// instance.
         /// </exception>
         public string GetString(byte[] hidCodes)
-            => new string(hidCodes.Select(b => this[b]).ToArray());
+        {
+            if (hidCodes is null)
+            {
+                throw new ArgumentNullException(nameof(hidCodes));
+            }
+
+            return GetString(hidCodes.AsSpan());
+        }
+
+        /// <summary>
+        /// Given a span of HID codes, returns the string that it would produce.
+        /// </summary>
+        /// <remarks>
+        /// Only HID codes that are mapped in this <see cref="KeyboardLayout"/>
+        /// should be in this span.
+        /// </remarks>
+        /// <param name="hidCodes">A span of keyboard HID codes.</param>
+        /// <returns>
+        /// A string of characters that would have been generated by the keyboard HID codes.
+        /// </returns>
+        /// <exception cref="ArgumentOutOfRangeException">
+        /// At least one of the HID codes was not mapped in this <see cref="HidCodeTranslator"/>
+        /// instance.
+        /// </exception>
+        public string GetString(ReadOnlySpan<byte> hidCodes)
+        {
+            Span<char> characters = hidCodes.Length <= _maxStackChars
+                ? stackalloc char[hidCodes.Length]
+                : new char[hidCodes.Length];
+
+            _ = GetCharacters(hidCodes, characters);
+
+            return characters.ToString();
+        }
 
         /// <summary>
         /// Given a collection of HID codes, returns an <see cref="IList{T}"/> of characters
@@ -189,7 +247,51 @@ namespace Yubico.Core.Devices.Hid
         /// instance.
         /// </exception>
         public IEnumerable<char> GetCharacters(byte[] hidCodes)
-            => new List<char>(hidCodes.Select(b => this[b]));
+        {
+            if (hidCodes is null)
+            {
+                throw new ArgumentNullException(nameof(hidCodes));
+            }
+
+            char[] characters = new char[hidCodes.Length];
+            _ = GetCharacters(hidCodes, characters);
+
+            return new List<char>(characters);
+        }
+
+        /// <summary>
+        /// Translates a span of HID codes into the characters that would be
+        /// produced by the keyboard layout in this class.
+        /// </summary>
+        /// <param name="hidCodes">A span of keyboard HID codes.</param>
+        /// <param name="characters">
+        /// Receives the characters. It must be at least as long as <paramref name="hidCodes"/>.
+        /// </param>
+        /// <returns>The number of characters written.</returns>
+        /// <exception cref="ArgumentException">
+        /// <paramref name="characters"/> is shorter than <paramref name="hidCodes"/>.
+        /// </exception>
+        /// <exception cref="ArgumentOutOfRangeException">
+        /// At least one of the HID codes was not mapped in this <see cref="HidCodeTranslator"/>
+        /// instance.
+        /// </exception>
+        public int GetCharacters(ReadOnlySpan<byte> hidCodes, Span<char> characters)
+        {
+            if (characters.Length < hidCodes.Length)
+            {
+                throw new ArgumentException(ExceptionMessages.DecodingOverflow, nameof(characters));
+            }
+
+            char[] charByCode = _charByCode;
+
+            for (int i = 0; i < hidCodes.Length; i++)
+            {
+                char value = charByCode[hidCodes[i]];
+                characters[i] = value != '\0' ? value : this[hidCodes[i]];
+            }
+
+            return hidCodes.Length;
+        }
 
         /// <summary>
         /// Given a collection of characters, returns the corresponding HID codes
@@ -204,6 +306,41 @@ namespace Yubico.Core.Devices.Hid
         public byte[] GetHidCodes(IEnumerable<char> characters)
             => characters.Select(c => this[c]).ToArray();
 
+        /// <summary>
+        /// Translates a span of characters into the corresponding HID codes
+        /// for the keyboard layout.
+        /// </summary>
+        /// <param name="characters">The characters to convert.</param>
+        /// <param name="hidCodes">
+        /// Receives the HID codes. It must be at least as long as <paramref name="characters"/>.
+        /// </param>
+        /// <returns>The number of HID codes written.</returns>
+        /// <exception cref="ArgumentException">
+        /// <paramref name="hidCodes"/> is shorter than <paramref name="characters"/>.
+        /// </exception>
+        /// <exception cref="ArgumentOutOfRangeException">
+        /// At least one of the characters is not in the map for this
+        /// <see cref="HidCodeTranslator"/> instance.
+        /// </exception>
+        public int GetHidCodes(ReadOnlySpan<char> characters, Span<byte> hidCodes)
+        {
+            if (hidCodes.Length < characters.Length)
+            {
+                throw new ArgumentException(ExceptionMessages.EncodingOverflow, nameof(hidCodes));
+            }
+
+            byte[] codeByChar = _codeByChar;
+
+            for (int i = 0; i < characters.Length; i++)
+            {
+                char ch = characters[i];
+                byte value = ch < codeByChar.Length ? codeByChar[ch] : (byte)0;
+                hidCodes[i] = value != 0 ? value : this[ch];
+            }
+
+            return characters.Length;
+        }
+
         /// <summary>
         /// Given a string, returns the corresponding HID codes for the individual
         /// characters in the string for the keyboard layout.
@@ -221,7 +358,10 @@ namespace Yubico.Core.Devices.Hid
                 throw new ArgumentNullException(nameof(value));
             }
 
-            return GetHidCodes(value.ToCharArray());
+            byte[] hidCodes = new byte[value.Length];
+            _ = GetHidCodes(value.AsSpan(), hidCodes);
+
+            return hidCodes;
         }
         #endregion
     }
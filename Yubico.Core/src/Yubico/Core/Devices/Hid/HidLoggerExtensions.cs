@@ -12,6 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#if ENABLE_SENSITIVE_LOG
+using System;
+using Microsoft.Extensions.Logging;
+using Yubico.Core.Buffers;
+#endif
 using Yubico.Core.Logging;
 using Yubico.PlatformInterop;
 
@@ -19,6 +24,74 @@ namespace Yubico.Core.Devices.Hid
 {
     internal static class HidLoggerExtensions
     {
+#if ENABLE_SENSITIVE_LOG
+        // Reports go by 64 bytes at a time, so these are defined once up front. The hex conversion only happens if
+        // someone is actually listening.
+        private static readonly Action<ILogger, string, int, Exception?> _ioReportSent =
+            LoggerMessage.Define<string, int>(LogLevel.Information, default, "Sending IO report> {report}, Length = {length}");
+
+        private static readonly Action<ILogger, string, Exception?> _ioReportReceived =
+            LoggerMessage.Define<string>(LogLevel.Information, default, "Receiving IO report< {report}");
+
+        private static readonly Action<ILogger, string, Exception?> _featureReportSent =
+            LoggerMessage.Define<string>(LogLevel.Information, default, "Sending feature report> {report}");
+
+        private static readonly Action<ILogger, string, Exception?> _featureReportReceived =
+            LoggerMessage.Define<string>(LogLevel.Information, default, "Receiving feature report< {report}");
+#endif
+
+        public static void SensitiveIOReportSent(this Logger logger, byte[] report)
+        {
+#if ENABLE_SENSITIVE_LOG
+            if (logger.IsEnabled(LogLevel.Information))
+            {
+                _ioReportSent(logger, Hex.BytesToHex(report), report.Length, null);
+            }
+#else
+            _ = logger;
+            _ = report;
+#endif
+        }
+
+        public static void SensitiveIOReportReceived(this Logger logger, byte[] report)
+        {
+#if ENABLE_SENSITIVE_LOG
+            if (logger.IsEnabled(LogLevel.Information))
+            {
+                _ioReportReceived(logger, Hex.BytesToHex(report), null);
+            }
+#else
+            _ = logger;
+            _ = report;
+#endif
+        }
+
+        public static void SensitiveFeatureReportSent(this Logger logger, byte[] report)
+        {
+#if ENABLE_SENSITIVE_LOG
+            if (logger.IsEnabled(LogLevel.Information))
+            {
+                _featureReportSent(logger, Hex.BytesToHex(report), null);
+            }
+#else
+            _ = logger;
+            _ = report;
+#endif
+        }
+
+        public static void SensitiveFeatureReportReceived(this Logger logger, byte[] report)
+        {
+#if ENABLE_SENSITIVE_LOG
+            if (logger.IsEnabled(LogLevel.Information))
+            {
+                _featureReportReceived(logger, Hex.BytesToHex(report), null);
+            }
+#else
+            _ = logger;
+            _ = report;
+#endif
+        }
+
         public static void IOKitApiCall(this Logger logger, string apiName, kern_return_t result)
         {
             if (result == kern_return_t.KERN_SUCCESS)
@@ -15,6 +15,7 @@
 using System;
 using System.Runtime.InteropServices;
 using System.Collections.Generic;
+using Yubico.Core.Devices.Tracing;
 using Yubico.Core.Logging;
 using Yubico.PlatformInterop;
 
@@ -315,7 +316,7 @@ namespace Yubico.Core.Devices.Hid
         /// <returns>An open <see cref="IHidConnection"/>.</returns>
         public override IHidConnection ConnectToFeatureReports()
         {
-            return new LinuxHidFeatureReportConnection(_devnode);
+            return DeviceTraceRecorder.AttachFeatureReports(new LinuxHidFeatureReportConnection(_devnode));
         }
 
         /// <summary>
@@ -324,7 +325,7 @@ namespace Yubico.Core.Devices.Hid
         /// <returns>An open <see cref="IHidConnection"/>.</returns>
         public override IHidConnection ConnectToIOReports()
         {
-            return new LinuxHidIOReportConnection(_devnode);
+            return DeviceTraceRecorder.AttachIOReports(new LinuxHidIOReportConnection(_devnode));
         }
     }
 }
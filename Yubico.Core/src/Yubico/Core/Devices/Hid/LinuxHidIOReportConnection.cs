@@ -14,7 +14,6 @@
 
 using System;
 using System.Globalization;
-using System.Security.Cryptography;
 using Yubico.Core.Buffers;
 using Yubico.Core.Logging;
 using Yubico.PlatformInterop;
@@ -57,7 +56,7 @@ namespace Yubico.Core.Devices.Hid
         // exactly 64 bytes long.
         public void SetReport(byte[] report)
         {
-            _log.SensitiveLogInformation("Sending IO report> {report}, Length = {length}", Hex.BytesToHex(report), report.Length);
+            _log.SensitiveIOReportSent(report);
             if (report.Length != YubiKeyIOReportSize)
             {
                 throw new InvalidOperationException(
@@ -68,11 +67,14 @@ namespace Yubico.Core.Devices.Hid
 
             // HIDRAW expects the first byte to be the frame number - or in cases where a frame number is not used,
             // like with the YubiKey, the first byte should be zero.
-            byte[] paddedBuffer = new byte[YubiKeyIOReportSize + 1];
-            report.CopyTo(paddedBuffer.AsSpan(1)); // Leave the first byte as 00
+            // The buffer comes from the secure pool, which zeroes it when it is disposed.
+            int bytesWritten;
+            using (SecureBuffer paddedBuffer = SecureBufferPool.Shared.Rent(YubiKeyIOReportSize + 1))
+            {
+                report.CopyTo(paddedBuffer.Span.Slice(1)); // Leave the first byte as 00
 
-            int bytesWritten = NativeMethods.write(_handle.DangerousGetHandle().ToInt32(), paddedBuffer, paddedBuffer.Length);
-            CryptographicOperations.ZeroMemory(paddedBuffer);
+                bytesWritten = NativeMethods.write(_handle.DangerousGetHandle().ToInt32(), paddedBuffer.Span);
+            }
 
             if (bytesWritten >= 0)
             {
@@ -96,7 +98,7 @@ namespace Yubico.Core.Devices.Hid
             int bytesRead = NativeMethods.read(_handle, outputBuffer, YubiKeyIOReportSize);
             if (bytesRead >= 0)
             {
-                _log.SensitiveLogInformation("Receiving IO report< {report}", Hex.BytesToHex(outputBuffer));
+                _log.SensitiveIOReportReceived(outputBuffer);
                 return outputBuffer;
             }
 
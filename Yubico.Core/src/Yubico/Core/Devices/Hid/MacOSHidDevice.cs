@@ -16,6 +16,7 @@ using System;
 using System.Collections.Generic;
 using System.Globalization;
 using System.Linq;
+using Yubico.Core.Devices.Tracing;
 using Yubico.Core.Logging;
 using Yubico.PlatformInterop;
 
@@ -103,7 +104,7 @@ namespace Yubico.Core.Devices.Hid
         /// An active connection object.
         /// </returns>
         public override IHidConnection ConnectToFeatureReports() =>
-            new MacOSHidFeatureReportConnection(_entryId);
+            DeviceTraceRecorder.AttachFeatureReports(new MacOSHidFeatureReportConnection(_entryId));
 
         /// <summary>
         /// Establishes a connection capable of transmitting IO reports to a FIDO device.
@@ -112,7 +113,7 @@ namespace Yubico.Core.Devices.Hid
         /// An active connection object.
         /// </returns>
         public override IHidConnection ConnectToIOReports() =>
-            new MacOSHidIOReportConnection(_entryId);
+            DeviceTraceRecorder.AttachIOReports(new MacOSHidIOReportConnection(_entryId));
 
         internal static long GetEntryId(IntPtr device)
         {
@@ -13,7 +13,6 @@
 // limitations under the License.
 
 using System;
-using Yubico.Core.Buffers;
 using Yubico.Core.Logging;
 using Yubico.PlatformInterop;
 using static Yubico.PlatformInterop.NativeMethods;
@@ -139,9 +138,7 @@ namespace Yubico.Core.Devices.Hid
                     ExceptionMessages.IOKitOperationFailed);
             }
 
-            _log.SensitiveLogInformation(
-                "GetReport returned buffer: {Report}",
-                Hex.BytesToHex(buffer));
+            _log.SensitiveFeatureReportReceived(buffer);
 
             return buffer;
         }
@@ -157,9 +154,7 @@ namespace Yubico.Core.Devices.Hid
         /// </exception>
         public void SetReport(byte[] report)
         {
-            _log.SensitiveLogInformation(
-                "Calling SetReport with data: {Report}",
-                Hex.BytesToHex(report));
+            _log.SensitiveFeatureReportSent(report);
 
             int result = IOHIDDeviceSetReport(
                 _deviceHandle,
@@ -17,7 +17,6 @@ using System.Globalization;
 using System.Linq;
 using System.Runtime.InteropServices;
 using System.Text;
-using Yubico.Core.Buffers;
 using Yubico.Core.Logging;
 using Yubico.PlatformInterop;
 using static Yubico.PlatformInterop.NativeMethods;
@@ -167,9 +166,7 @@ namespace Yubico.Core.Devices.Hid
 
                 IOHIDDeviceUnscheduleFromRunLoop(_deviceHandle, runLoop, _loopId);
 
-                _log.SensitiveLogInformation(
-                    "GetReport returned buffer: {Report}",
-                    Hex.BytesToHex(readBuffer));
+                _log.SensitiveIOReportReceived(readBuffer);
 
                 // Return a copy of the report
                 return readBuffer.ToArray();
@@ -285,9 +282,7 @@ namespace Yubico.Core.Devices.Hid
                 throw new ArgumentNullException(nameof(report));
             }
 
-            _log.SensitiveLogInformation(
-                "Calling SetReport with data: {Report}",
-                Hex.BytesToHex(report));
+            _log.SensitiveIOReportSent(report);
 
             int result = IOHIDDeviceSetReport(
                 _deviceHandle,
@@ -17,6 +17,7 @@ using System.Collections.Generic;
 using System.Diagnostics.CodeAnalysis;
 using System.Globalization;
 using System.Linq;
+using Yubico.Core.Devices.Tracing;
 using Yubico.PlatformInterop;
 
 namespace Yubico.Core.Devices.Hid
@@ -99,13 +100,13 @@ namespace Yubico.Core.Devices.Hid
         /// </summary>
         /// <returns>An open <see cref="IHidConnection"/>.</returns>
         public override IHidConnection ConnectToFeatureReports() =>
-            new WindowsHidFeatureReportConnection(Path);
+            DeviceTraceRecorder.AttachFeatureReports(new WindowsHidFeatureReportConnection(Path));
 
         /// <summary>
         /// Opens an active connection to the Windows HID device.
         /// </summary>
         /// <returns>An open <see cref="IHidConnection"/>.</returns>
         public override IHidConnection ConnectToIOReports() =>
-            new WindowsHidIOReportConnection(Path);
+            DeviceTraceRecorder.AttachIOReports(new WindowsHidIOReportConnection(Path));
     }
 }
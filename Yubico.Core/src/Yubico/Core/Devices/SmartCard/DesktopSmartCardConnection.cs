@@ -13,6 +13,8 @@
 // limitations under the License.
 
 using System;
+using System.Diagnostics;
+using System.Globalization;
 using Yubico.Core.Iso7816;
 using Yubico.Core.Logging;
 using Yubico.PlatformInterop;
@@ -21,13 +23,33 @@ using static Yubico.PlatformInterop.NativeMethods;
 
 namespace Yubico.Core.Devices.SmartCard
 {
-    public class DesktopSmartCardConnection : ISmartCardConnection
+    public class DesktopSmartCardConnection : ISmartCardConnection, ISmartCardConnectionStatus
     {
         private readonly Logger _log = Log.GetLogger();
         private readonly SCardContext _context;
         private readonly SCardCardHandle _cardHandle;
+        private readonly string _readerName;
+        private readonly SCARD_SHARE _shareMode;
+        private readonly int? _ownerThreadId;
         private SCARD_PROTOCOL _activeProtocol;
 
+        // The longest ATR ISO 7816-3 allows is 33 bytes; PC/SC buffers are 36.
+        private const int MaxAtrLength = 36;
+
+        // Set once the native shim turns out to predate Native_SCardStatus.
+        private static bool _statusUnavailable;
+
+        // Handed out by BeginTransaction on exclusive connections, where there is no transaction to end.
+        private sealed class ExclusiveScope : IDisposable
+        {
+            public static readonly ExclusiveScope Instance = new ExclusiveScope();
+
+            public void Dispose()
+            {
+
+            }
+        }
+
         private class TransactionScope : IDisposable
         {
             private readonly Logger _log = Log.GetLogger();
@@ -78,26 +100,43 @@ namespace Yubico.Core.Devices.SmartCard
         internal DesktopSmartCardConnection(
             SCardContext context,
             SCardCardHandle cardHandle,
-            SCARD_PROTOCOL activeProtocol)
+            string readerName,
+            SCARD_PROTOCOL activeProtocol,
+            SmartCardConnectionOptions options)
         {
             _context = context;
             _cardHandle = cardHandle;
+            _readerName = readerName;
             _activeProtocol = activeProtocol;
+            _shareMode = options.Exclusive ? SCARD_SHARE.EXCLUSIVE : SCARD_SHARE.SHARED;
+            _ownerThreadId = options.ThreadAffinity ? Environment.CurrentManagedThreadId : (int?)null;
         }
 
         /// <summary>
         /// Begins a transacted connection to the smart card.
         /// </summary>
         /// <remarks>
-        /// This method has no effect on platforms which do not support transactions.
+        /// This method has no effect on platforms which do not support transactions, or on connections opened with
+        /// <see cref="SmartCardConnectionOptions.Exclusive"/>, which no other connection can interleave with.
         /// </remarks>
         /// <returns>An IDisposable that represents the transaction.</returns>
         /// <exception cref="SCardException">
         /// Thrown when the underlying platform smart card subsystem encounters an error.
         /// </exception>
+        /// <exception cref="InvalidOperationException">
+        /// The connection is pinned to another thread.
+        /// </exception>
         public IDisposable BeginTransaction(out bool cardWasReset)
         {
+            EnsureOwnerThread();
+
             cardWasReset = false;
+
+            if (_shareMode == SCARD_SHARE.EXCLUSIVE)
+            {
+                return ExclusiveScope.Instance;
+            }
+
             uint result = SCardBeginTransaction(_cardHandle);
             _log.SCardApiCall(nameof(SCardBeginTransaction), result);
 
@@ -133,6 +172,9 @@ namespace Yubico.Core.Devices.SmartCard
         /// <exception cref="SCardException">
         /// Thrown when the underlying platform smart card subsystem encounters an error.
         /// </exception>
+        /// <exception cref="InvalidOperationException">
+        /// The connection is pinned to another thread.
+        /// </exception>
         public ResponseApdu Transmit(CommandApdu commandApdu)
         {
             if (commandApdu is null)
@@ -140,14 +182,21 @@ namespace Yubico.Core.Devices.SmartCard
                 throw new ArgumentNullException(nameof(commandApdu));
             }
 
+            EnsureOwnerThread();
+
+            using Activity? activity = SmartCardActivitySource.Source.StartActivity(nameof(SCardTransmit));
+
             // The YubiKey likely will never return a buffer larger than 512 bytes without instead
             // using response chaining.
             byte[] outputBuffer = new byte[512];
+            byte[] commandBuffer = commandApdu.AsByteArray();
+
+            _ = activity?.SetTag(SmartCardActivitySource.SendLengthTag, commandBuffer.Length);
 
             uint result = SCardTransmit(
                 _cardHandle,
                 new SCARD_IO_REQUEST(_activeProtocol),
-                commandApdu.AsByteArray(),
+                commandBuffer,
                 IntPtr.Zero,
                 outputBuffer,
                 out int outputBufferSize
@@ -156,19 +205,30 @@ namespace Yubico.Core.Devices.SmartCard
 
             if (result != ErrorCode.SCARD_S_SUCCESS)
             {
+                SmartCardActivitySource.SetSCardError(activity, result);
                 throw new SCardException(ExceptionMessages.SCardTransmitFailure, result);
             }
 
             Array.Resize(ref outputBuffer, outputBufferSize);
 
-            return new ResponseApdu(outputBuffer);
+            var responseApdu = new ResponseApdu(outputBuffer);
+
+            if (!(activity is null))
+            {
+                _ = activity.SetTag(SmartCardActivitySource.ReceiveLengthTag, outputBufferSize);
+                _ = activity.SetTag(SmartCardActivitySource.StatusWordTag, responseApdu.SW.ToString("X4", CultureInfo.InvariantCulture));
+            }
+
+            return responseApdu;
         }
 
         public void Reconnect()
         {
+            EnsureOwnerThread();
+
             uint result = SCardReconnect(
                 _cardHandle,
-                SCARD_SHARE.SHARED,
+                _shareMode,
                 SCARD_PROTOCOL.T1,
                 SCARD_DISPOSITION.RESET_CARD,
                 out SCARD_PROTOCOL updatedActiveProtocol);
@@ -182,6 +242,115 @@ namespace Yubico.Core.Devices.SmartCard
             _activeProtocol = updatedActiveProtocol;
         }
 
+        /// <summary>
+        /// Reads the state, protocol and ATR of the card, and the reader's event count, without sending the card a
+        /// command.
+        /// </summary>
+        /// <exception cref="InvalidOperationException">
+        /// The connection is pinned to a different thread.
+        /// </exception>
+        /// <exception cref="SCardException">
+        /// The card was removed or reset, or the smart card subsystem encountered an error.
+        /// </exception>
+        public SmartCardConnectionStatus GetStatus()
+        {
+            EnsureOwnerThread();
+
+            if (_statusUnavailable)
+            {
+                return GetReaderStatus();
+            }
+
+            Span<byte> atrBuffer = stackalloc byte[MaxAtrLength];
+            uint result;
+            SCARD_STATUS state;
+            SCARD_PROTOCOL protocol;
+            int atrLength;
+
+            try
+            {
+                result = SCardStatus(_cardHandle, out state, out protocol, atrBuffer, out atrLength);
+            }
+            catch (EntryPointNotFoundException)
+            {
+                _log.LogWarning("The native shim does not support SCardStatus. Reading the reader's state instead.");
+                _statusUnavailable = true;
+
+                return GetReaderStatus();
+            }
+
+            _log.SCardApiCall(nameof(SCardStatus), result);
+
+            if (result != ErrorCode.SCARD_S_SUCCESS)
+            {
+                throw new SCardException(ExceptionMessages.SCardStatusFailed, result);
+            }
+
+            return new SmartCardConnectionStatus(
+                (SmartCardState)state,
+                ToSmartCardProtocol(protocol),
+                atrLength > 0 ? new AnswerToReset(atrBuffer.Slice(0, atrLength)) : null,
+                GetReaderState(out SCARD_READER_STATE readerState) == ErrorCode.SCARD_S_SUCCESS
+                    ? readerState.EventSequence
+                    : 0);
+        }
+
+        // For shims without SCardStatus. The reader's state shows whether a card is in it and which one, but not
+        // whether this connection's handle is still good, so a reset by another application goes unnoticed.
+        private SmartCardConnectionStatus GetReaderStatus()
+        {
+            uint result = GetReaderState(out SCARD_READER_STATE readerState);
+
+            if (result != ErrorCode.SCARD_S_SUCCESS)
+            {
+                throw new SCardException(ExceptionMessages.SCardStatusFailed, result);
+            }
+
+            if ((readerState.EventState & SCARD_STATE.PRESENT) == 0)
+            {
+                return new SmartCardConnectionStatus(
+                    SmartCardState.Absent,
+                    SmartCardProtocol.Unknown,
+                    null,
+                    readerState.EventSequence);
+            }
+
+            return new SmartCardConnectionStatus(
+                SmartCardState.Specific,
+                ToSmartCardProtocol(_activeProtocol),
+                readerState.Atr,
+                readerState.EventSequence);
+        }
+
+        // SCardStatus does not report the reader's event count, but an immediate SCardGetStatusChange on this
+        // connection's own context does, in the upper half of the event state.
+        private uint GetReaderState(out SCARD_READER_STATE readerState)
+        {
+            SCARD_READER_STATE[] readerStates = SCARD_READER_STATE.CreateFromReaderNames(new[] { _readerName });
+
+            uint result = SCardGetStatusChange(_context, 0, readerStates, readerStates.Length);
+            _log.SCardApiCall(nameof(SCardGetStatusChange), result);
+
+            readerState = readerStates[0];
+
+            return result;
+        }
+
+        private static SmartCardProtocol ToSmartCardProtocol(SCARD_PROTOCOL protocol) => protocol switch
+        {
+            SCARD_PROTOCOL.T0 => SmartCardProtocol.T0,
+            SCARD_PROTOCOL.T1 => SmartCardProtocol.T1,
+            _ => SmartCardProtocol.Unknown
+        };
+
+        private void EnsureOwnerThread()
+        {
+            if (_ownerThreadId.HasValue && _ownerThreadId.Value != Environment.CurrentManagedThreadId)
+            {
+                throw new InvalidOperationException(ExceptionMessages.SmartCardConnectionWrongThread);
+            }
+        }
+
         #region IDisposable Support
         private bool _disposed;
 
@@ -202,7 +371,7 @@ namespace Yubico.Core.Devices.SmartCard
             if (disposing)
             {
                 _cardHandle.Dispose();
-                _context.Dispose();
+                SCardContextPool.Shared.Return(_context);
             }
 
             _disposed = true;
@@ -16,6 +16,7 @@ using System;
 using System.Collections.Generic;
 using System.Globalization;
 using System.Linq;
+using Yubico.Core.Devices.Tracing;
 using Yubico.Core.Iso7816;
 using Yubico.Core.Logging;
 using Yubico.PlatformInterop;
@@ -34,19 +35,21 @@ namespace Yubico.Core.Devices.SmartCard
             Logger log = Log.GetLogger();
             using IDisposable logScope = log.BeginScope("SmartCardDevice.GetList()");
 
-            uint result = SCardEstablishContext(SCARD_SCOPE.USER, out SCardContext context);
-            log.SCardApiCall(nameof(SCardEstablishContext), result);
-
-            if (result != ErrorCode.SCARD_S_SUCCESS)
-            {
-                throw new SCardException(
-                    ExceptionMessages.SCardCantEstablish,
-                    result);
-            }
+            SCardContext context = RentContext(log);
 
             try
             {
-                result = SCardListReaders(context, null, out string[] readerNames);
+                var readerIds = new List<int>();
+                uint result = SCardListReaders(context, null, readerIds);
+
+                if (SCardContextPool.IsContextLost(result))
+                {
+                    // A pooled context can outlive the smart card service that issued it. Start over with a new one.
+                    SCardContextPool.Shared.Clear();
+                    context.Dispose();
+                    context = RentContext(log);
+                    result = SCardListReaders(context, null, readerIds);
+                }
 
                 if (result != ErrorCode.SCARD_E_NO_READERS_AVAILABLE)
                 {
@@ -55,13 +58,13 @@ namespace Yubico.Core.Devices.SmartCard
                 
                 // It's OK if there are no readers on the system. Treat this the same as if we
                 // didn't find any devices.
-                if (result == ErrorCode.SCARD_E_NO_READERS_AVAILABLE || readerNames.Length == 0)
+                if (result == ErrorCode.SCARD_E_NO_READERS_AVAILABLE || readerIds.Count == 0)
                 {
                     log.LogInformation("No smart card devices found.");
                     return new List<ISmartCardDevice>();
                 }
 
-                log.LogInformation("Found {NumSmartCards} smart card devices.", readerNames.Length);
+                log.LogInformation("Found {NumSmartCards} smart card devices.", readerIds.Count);
 
                 if (result != ErrorCode.SCARD_S_SUCCESS)
                 {
@@ -70,7 +73,7 @@ namespace Yubico.Core.Devices.SmartCard
                         result);
                 }
 
-                SCARD_READER_STATE[] readerStates = SCARD_READER_STATE.CreateFromReaderNames(readerNames);
+                SCARD_READER_STATE[] readerStates = SCARD_READER_STATE.CreateFromReaderIds(readerIds);
 
                 result = SCardGetStatusChange(
                     context,
@@ -93,10 +96,34 @@ namespace Yubico.Core.Devices.SmartCard
             }
             finally
             {
-                context.Dispose();
+                SCardContextPool.Shared.Return(context);
             }
         }
 
+        private static SCardContext RentContext(Logger log)
+        {
+            SCardContext? context = SCardContextPool.Shared.TryRent();
+
+            if (!(context is null))
+            {
+                return context;
+            }
+
+            uint result = SCardContextPool.Shared.Establish(out SCardContext newContext);
+            log.SCardApiCall(nameof(SCardEstablishContext), result);
+
+            if (result != ErrorCode.SCARD_S_SUCCESS)
+            {
+                newContext.Dispose();
+
+                throw new SCardException(
+                    ExceptionMessages.SCardCantEstablish,
+                    result);
+            }
+
+            return newContext;
+        }
+
         private static ISmartCardDevice NewSmartCardDevice(string readerName, AnswerToReset? atr) => SdkPlatformInfo.OperatingSystem switch
         {
             SdkPlatform.Windows => new DesktopSmartCardDevice(readerName, atr),
@@ -112,30 +139,31 @@ namespace Yubico.Core.Devices.SmartCard
             _log = Log.GetLogger();
         }
 
-        public override ISmartCardConnection Connect()
-        {
-            uint result = SCardEstablishContext(SCARD_SCOPE.USER, out SCardContext? context);
-            _log.SCardApiCall(nameof(SCardEstablishContext), result);
+        public override ISmartCardConnection Connect() => Connect(new SmartCardConnectionOptions());
 
-            if (result != ErrorCode.SCARD_S_SUCCESS)
+        public override ISmartCardConnection Connect(SmartCardConnectionOptions options)
+        {
+            if (options is null)
             {
-                throw new SCardException(
-                    ExceptionMessages.SCardCantEstablish,
-                    result);
+                throw new ArgumentNullException(nameof(options));
             }
 
+            SCardContext? context = RentContext(_log);
             SCardCardHandle? cardHandle = null;
 
             try
             {
-                result = SCardConnect(
-                    context,
-                    _readerName,
-                    SCARD_SHARE.SHARED,
-                    SCARD_PROTOCOL.Tx,
-                    out cardHandle,
-                    out SCARD_PROTOCOL activeProtocol);
-                _log.SCardApiCall(nameof(SCardConnect), result);
+                uint result = ConnectCard(context, options, out cardHandle, out SCARD_PROTOCOL activeProtocol);
+
+                if (SCardContextPool.IsContextLost(result))
+                {
+                    // A pooled context can outlive the smart card service that issued it. Start over with a new one.
+                    SCardContextPool.Shared.Clear();
+                    cardHandle.Dispose();
+                    context.Dispose();
+                    context = RentContext(_log);
+                    result = ConnectCard(context, options, out cardHandle, out activeProtocol);
+                }
 
                 if (result != ErrorCode.SCARD_S_SUCCESS)
                 {
@@ -148,36 +176,57 @@ namespace Yubico.Core.Devices.SmartCard
                 }
 
                 _log.LogInformation(
-                    "Connected to smart card [{ReaderName}]. Active protocol is [{ActiveProtocol}]",
+                    "Connected to smart card [{ReaderName}]. Active protocol is [{ActiveProtocol}], exclusive is [{Exclusive}]",
                     _readerName,
-                    activeProtocol);
+                    activeProtocol,
+                    options.Exclusive);
 
                 var connection = new DesktopSmartCardConnection(
                     context,
                     cardHandle,
-                    activeProtocol);
+                    _readerName,
+                    activeProtocol,
+                    options);
 
                 // We are transferring ownership to SmartCardConnection
                 _log.LogInformation("Transferred context and cardHandle to connection instance.");
                 context = null;
                 cardHandle = null;
 
-                return connection;
+                return DeviceTraceRecorder.Attach(connection);
             }
             finally
             {
-                if (context != null)
-                {
-                    context?.Dispose();
-                    _log.LogInformation("Context disposed.");
-                }
-
                 if (cardHandle != null)
                 {
                     cardHandle?.Dispose();
                     _log.LogInformation("CardHandle disposed.");
                 }
+
+                if (context != null)
+                {
+                    SCardContextPool.Shared.Return(context);
+                    _log.LogInformation("Context returned to the pool.");
+                }
             }
         }
+
+        private uint ConnectCard(
+            SCardContext context,
+            SmartCardConnectionOptions options,
+            out SCardCardHandle cardHandle,
+            out SCARD_PROTOCOL activeProtocol)
+        {
+            uint result = SCardConnect(
+                context,
+                _readerName,
+                options.Exclusive ? SCARD_SHARE.EXCLUSIVE : SCARD_SHARE.SHARED,
+                SCARD_PROTOCOL.Tx,
+                out cardHandle,
+                out activeProtocol);
+            _log.SCardApiCall(nameof(SCardConnect), result);
+
+            return result;
+        }
     }
 }
@@ -14,7 +14,6 @@
 
 using System;
 using System.Collections.Generic;
-using System.Diagnostics.CodeAnalysis;
 using System.Linq;
 using System.Threading;
 using Yubico.Core.Logging;
@@ -40,13 +39,25 @@ namespace Yubico.Core.Devices.SmartCard
         private bool _isListening;
         private Thread? _listenerThread;
 
+        // Reused by every reader enumeration on the listener thread.
+        private readonly List<int> _readerIds = new List<int>();
+
+        // The ID of the PnP notification pseudo-reader in SCardReaderNames.
+        private static readonly int _pnpNotificationReaderId = SCardReaderNames.Intern("\\\\?PnP?\\Notification");
+
+        // Evaluated by the shim on every status change wait. Cleared if the shim is too old to support it.
+        private SmartCardReaderFilter? _readerFilter;
+
         /// <summary>
-        /// Constructs a <see cref="SmartCardDeviceListener"/>.
+        /// Constructs a <see cref="SmartCardDeviceListener"/> that only watches the readers and cards allowed by
+        /// <paramref name="readerFilter"/>.
         /// </summary>
-        public DesktopSmartCardDeviceListener()
+        /// <param name="readerFilter">The filter to apply, or null to watch every reader.</param>
+        public DesktopSmartCardDeviceListener(SmartCardReaderFilter? readerFilter)
         {
             _log.LogInformation("Creating DesktopSmartCardDeviceListener.");
             Status = DeviceListenerStatus.Stopped;
+            _readerFilter = readerFilter;
 
             uint result = SCardEstablishContext(SCARD_SCOPE.USER, out SCardContext context);
             _log.SCardApiCall(nameof(SCardEstablishContext), result);
@@ -168,7 +179,7 @@ namespace Yubico.Core.Devices.SmartCard
 
             var newStates = (SCARD_READER_STATE[])_readerStates.Clone();
 
-            uint getStatusChangeResult = SCardGetStatusChange(_context, timeout, newStates, newStates.Length);
+            uint getStatusChangeResult = GetStatusChange(timeout, newStates);
 
             if (getStatusChangeResult == ErrorCode.SCARD_E_CANCELLED)
             {
@@ -183,7 +194,7 @@ namespace Yubico.Core.Devices.SmartCard
             }
 
             _log.SCardApiCall(nameof(SCardGetStatusChange), getStatusChangeResult);
-            _log.LogInformation("Reader states:\n{States}", newStates);
+            _log.ReaderStates(newStates);
 
             while (ReaderListChangeDetected(ref newStates, usePnpWorkaround))
             {
@@ -217,7 +228,7 @@ namespace Yubico.Core.Devices.SmartCard
                 if (addedReaderStates.Any())
                 {
                     _log.LogInformation("Additional smart card readers were found. Calling GetStatusChange for more information.");
-                    getStatusChangeResult = SCardGetStatusChange(_context, 0, updatedStates, updatedStates.Length);
+                    getStatusChangeResult = GetStatusChange(0, updatedStates);
 
                     if (getStatusChangeResult == ErrorCode.SCARD_E_CANCELLED)
                     {
@@ -232,7 +243,7 @@ namespace Yubico.Core.Devices.SmartCard
                     }
 
                     _log.SCardApiCall(nameof(SCardGetStatusChange), getStatusChangeResult);
-                    _log.LogInformation("Reader states:\n{States}", newStates);
+                    _log.ReaderStates(newStates);
                 }
 
                 newStates = updatedStates;
@@ -240,7 +251,7 @@ namespace Yubico.Core.Devices.SmartCard
 
             if (RelevantChangesDetected(newStates))
             {
-                getStatusChangeResult = SCardGetStatusChange(_context, 0, newStates, newStates.Length);
+                getStatusChangeResult = GetStatusChange(0, newStates);
                 if (getStatusChangeResult == ErrorCode.SCARD_E_CANCELLED)
                 {
                     _log.LogInformation("GetStatusChange indicated SCARD_E_CANCELLED.");
@@ -254,7 +265,7 @@ namespace Yubico.Core.Devices.SmartCard
                 }
 
                 _log.SCardApiCall(nameof(SCardGetStatusChange), getStatusChangeResult);
-                _log.LogInformation("Reader states:\n{States}", newStates);
+                _log.ReaderStates(newStates);
             }
 
             if (sendEvents)
@@ -271,6 +282,39 @@ namespace Yubico.Core.Devices.SmartCard
             return true;
         }
 
+        /// <summary>
+        /// Waits for a change in the given readers, applying the reader filter if there is one.
+        /// </summary>
+        /// <param name="timeout">The timeout in milliseconds, or -1 to wait indefinitely.</param>
+        /// <param name="states">The reader states to wait on and update.</param>
+        /// <returns>The PC/SC result code.</returns>
+        private uint GetStatusChange(int timeout, SCARD_READER_STATE[] states)
+        {
+            if (!(_readerFilter is null))
+            {
+                byte[]? atrPrefixes = _readerFilter.EncodedAtrPrefixes;
+
+                try
+                {
+                    return SCardGetStatusChangeFiltered(
+                        _context,
+                        timeout,
+                        states,
+                        states.Length,
+                        _readerFilter.EncodedReaderNamePatterns,
+                        atrPrefixes,
+                        atrPrefixes?.Length ?? 0);
+                }
+                catch (EntryPointNotFoundException)
+                {
+                    _log.LogWarning("The native shim does not support reader filtering. Watching every reader instead.");
+                    _readerFilter = null;
+                }
+            }
+
+            return SCardGetStatusChange(_context, timeout, states, states.Length);
+        }
+
         // So apparently not all platforms implement the virtual pnp reader semantics the same. They will still wait on
         // GetStatusChange, returning when a new reader is added, they just don't mark the CHANGED flag all the time.
         // Weird. Anyways, it seems like a reasonable workaround is to detect the type of system (by seeing if it returns
@@ -296,13 +340,13 @@ namespace Yubico.Core.Devices.SmartCard
         {
             if (usePnpWorkaround)
             {
-                uint result = SCardListReaders(_context, null, out string[] readerNames);
+                uint result = SCardListReaders(_context, null, _readerIds);
                 if (result != ErrorCode.SCARD_E_NO_READERS_AVAILABLE)
                 {
                     _log.SCardApiCall(nameof(SCardListReaders), result);
                 }
 
-                return readerNames.Length != newStates.Length - 1;
+                return _readerIds.Count != newStates.Length - 1;
             }
 
             if (newStates[0].EventState.HasFlag(SCARD_STATE.CHANGED))
@@ -352,7 +396,7 @@ namespace Yubico.Core.Devices.SmartCard
 
                 if (diffState.HasFlag(SCARD_STATE.PRESENT) && entry.CurrentState.HasFlag(SCARD_STATE.PRESENT))
                 {
-                    IEnumerable<SCARD_READER_STATE> states = originalStates.Where(e => e.ReaderName == entry.ReaderName);
+                    IEnumerable<SCARD_READER_STATE> states = originalStates.Where(e => e.ReaderId == entry.ReaderId);
                     ISmartCardDevice smartCardDevice =
                         SmartCardDevice.Create(entry.ReaderName, states.FirstOrDefault().Atr);
                     removedDevices.Add(smartCardDevice);
@@ -396,21 +440,15 @@ namespace Yubico.Core.Devices.SmartCard
         /// <returns><see cref="SCARD_READER_STATE"/></returns>
         private SCARD_READER_STATE[] GetReaderStateList()
         {
-            uint result = SCardListReaders(_context, null, out string[] readerNames);
+            uint result = SCardListReaders(_context, null, _readerIds);
             if (result != ErrorCode.SCARD_E_NO_READERS_AVAILABLE)
             {
                 _log.SCardApiCall(nameof(SCardListReaders), result);
             }
 
-            // We use this workaround as .NET 4.7 doesn't really support all of .NET Standard 2.0
-            var allReaders = new List<string>(readerNames.Length + 1)
-            {
-                "\\\\?PnP?\\Notification"
-            };
-
-            allReaders.AddRange(readerNames);
+            _readerIds.Insert(0, _pnpNotificationReaderId);
 
-            return SCARD_READER_STATE.CreateFromReaderNames(allReaders);
+            return SCARD_READER_STATE.CreateFromReaderIds(_readerIds);
         }
 
         /// <summary>
@@ -450,12 +488,12 @@ namespace Yubico.Core.Devices.SmartCard
             }
         }
 
+        // Reader states are matched by their interned reader ID rather than by name.
         private class ReaderStateComparer : IEqualityComparer<SCARD_READER_STATE>
         {
-            public bool Equals(SCARD_READER_STATE x, SCARD_READER_STATE y) => x.ReaderName == y.ReaderName;
+            public bool Equals(SCARD_READER_STATE x, SCARD_READER_STATE y) => x.ReaderId == y.ReaderId;
 
-            [SuppressMessage("Globalization", "CA1307:Specify StringComparison for clarity", Justification = "Method needs to compile for both netstandard 2.0 and 2.1")]
-            public int GetHashCode(SCARD_READER_STATE obj) => obj.ReaderName.GetHashCode();
+            public int GetHashCode(SCARD_READER_STATE obj) => obj.ReaderId;
         }
     }
 }
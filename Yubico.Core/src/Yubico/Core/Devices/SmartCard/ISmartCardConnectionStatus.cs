@@ -0,0 +1,38 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+namespace Yubico.Core.Devices.SmartCard
+{
+    /// <summary>
+    /// A smart card connection that can report the state of its card without sending it a command.
+    /// </summary>
+    /// <remarks>
+    /// This is meant for connection pools and caches that need to check that a connection they are holding is still
+    /// good. Not every <see cref="ISmartCardConnection"/> implements it, so test for it before use.
+    /// </remarks>
+    public interface ISmartCardConnectionStatus
+    {
+        /// <summary>
+        /// Reads the state, protocol and ATR of the card behind this connection without sending it a command.
+        /// </summary>
+        /// <remarks>
+        /// It costs a call to the smart card service, but no command is sent to the card.
+        /// </remarks>
+        /// <exception cref="Yubico.PlatformInterop.SCardException">
+        /// The connection is no longer valid, for example because the card was removed or reset.
+        /// </exception>
+        SmartCardConnectionStatus GetStatus();
+    }
+}
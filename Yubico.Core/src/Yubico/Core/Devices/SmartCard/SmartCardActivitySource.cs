@@ -0,0 +1,53 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System.Diagnostics;
+using System.Globalization;
+
+namespace Yubico.Core.Devices.SmartCard
+{
+    /// <summary>
+    /// The source of the "Yubico.Core" tracing spans emitted around native PC/SC calls.
+    /// </summary>
+    /// <remarks>
+    /// The length tags count the raw buffers handed to and returned by SCardTransmit, APDU header and status word
+    /// included. They are deliberately named apart from the "Yubico.YubiKey" source's APDU length tags, which count
+    /// only the data field. The status word tag means the same thing in both sources and shares its name.
+    /// </remarks>
+    internal static class SmartCardActivitySource
+    {
+        public const string Name = "Yubico.Core";
+
+        public const string SendLengthTag = "scard.transmit.send.length";
+        public const string ReceiveLengthTag = "scard.transmit.receive.length";
+        public const string StatusWordTag = "yubikey.apdu.sw";
+        public const string ResultTag = "scard.result";
+
+        public static readonly ActivitySource Source = new ActivitySource(Name);
+
+        /// <summary>
+        /// Records the outcome of a PC/SC call that failed on an activity, if there is one.
+        /// </summary>
+        public static void SetSCardError(Activity? activity, uint result)
+        {
+            if (activity is null)
+            {
+                return;
+            }
+
+            _ = activity.SetTag(ResultTag, result.ToString("X8", CultureInfo.InvariantCulture));
+            _ = activity.SetStatus(ActivityStatusCode.Error);
+        }
+    }
+}
@@ -0,0 +1,49 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+namespace Yubico.Core.Devices.SmartCard
+{
+    /// <summary>
+    /// Options that control how a connection to a smart card is opened.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// By default a connection shares the card with other applications, and every command is wrapped in a PC/SC
+    /// transaction so that no other application can interleave its own commands. Each transaction costs a round trip
+    /// to the smart card service.
+    /// </para>
+    /// <para>
+    /// Setting <see cref="Exclusive"/> takes the card for this connection alone. No other connection, in this process
+    /// or any other, can be opened to the card until this one is disposed, so the per-command transactions are
+    /// skipped. This is meant for dedicated keys, such as those in a signing appliance, that nothing else uses.
+    /// </para>
+    /// </remarks>
+    public sealed class SmartCardConnectionOptions
+    {
+        /// <summary>
+        /// Connect with exclusive access to the card, and do not begin a transaction for each command.
+        /// </summary>
+        public bool Exclusive { get; set; }
+
+        /// <summary>
+        /// Only allow the connection to be used from the thread that opened it.
+        /// </summary>
+        /// <remarks>
+        /// An exclusive connection no longer relies on transactions to keep commands from different callers apart.
+        /// Pinning it to one worker thread makes a stray call from another thread fail with an
+        /// <see cref="System.InvalidOperationException"/> instead of interleaving with that worker's commands.
+        /// </remarks>
+        public bool ThreadAffinity { get; set; }
+    }
+}
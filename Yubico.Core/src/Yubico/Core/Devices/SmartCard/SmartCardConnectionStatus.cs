@@ -0,0 +1,62 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using Yubico.Core.Iso7816;
+
+namespace Yubico.Core.Devices.SmartCard
+{
+    /// <summary>
+    /// The state of the card behind a smart card connection, as returned by
+    /// <see cref="ISmartCardConnectionStatus.GetStatus"/>.
+    /// </summary>
+    public sealed class SmartCardConnectionStatus
+    {
+        /// <summary>
+        /// How far the card has progressed towards being ready for commands. A connection that can be used right away
+        /// reports <see cref="SmartCardState.Specific"/>.
+        /// </summary>
+        public SmartCardState State { get; }
+
+        /// <summary>
+        /// The protocol the connection is using.
+        /// </summary>
+        public SmartCardProtocol Protocol { get; }
+
+        /// <summary>
+        /// The card's answer to reset, or null if the reader did not return one.
+        /// </summary>
+        public AnswerToReset? Atr { get; }
+
+        /// <summary>
+        /// The number of card insertions and removals the smart card service has seen on the reader, modulo 65536.
+        /// </summary>
+        /// <remarks>
+        /// Two statuses with the same event count were taken while the same card stayed in the reader. Zero if the
+        /// platform does not report the count.
+        /// </remarks>
+        public int EventCount { get; }
+
+        /// <summary>
+        /// Creates a status from its parts.
+        /// </summary>
+        public SmartCardConnectionStatus(SmartCardState state, SmartCardProtocol protocol, AnswerToReset? atr, int eventCount)
+        {
+            State = state;
+            Protocol = protocol;
+            Atr = atr;
+            EventCount = eventCount;
+        }
+    }
+}
@@ -91,6 +91,16 @@ namespace Yubico.Core.Devices.SmartCard
         /// <returns>An already opened connection to the smart card reader.</returns>
         public abstract ISmartCardConnection Connect();
 
+        /// <summary>
+        /// Establishes an active connection to the smart card, opened as described by <paramref name="options"/>.
+        /// </summary>
+        /// <remarks>
+        /// Implementations that cannot honor the options ignore them, which is what this default implementation does.
+        /// </remarks>
+        /// <param name="options">How the connection is to be opened.</param>
+        /// <returns>An already opened connection to the smart card reader.</returns>
+        public virtual ISmartCardConnection Connect(SmartCardConnectionOptions options) => Connect();
+
         public override string ToString() => $"Smart Card: {Path}";
     }
 }
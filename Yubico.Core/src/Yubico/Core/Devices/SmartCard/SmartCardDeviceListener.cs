@@ -63,12 +63,29 @@ namespace Yubico.Core.Devices.SmartCard
         /// the operating system or platform that you are attempting to run this does not have a smart card device notification
         /// support.
         /// </exception>
-        public static SmartCardDeviceListener Create() =>
+        public static SmartCardDeviceListener Create() => Create(null);
+
+        /// <summary>
+        /// Creates an instance of a <see cref="SmartCardDeviceListener"/> that only watches the readers and cards
+        /// allowed by <paramref name="readerFilter"/>.
+        /// </summary>
+        /// <param name="readerFilter">
+        /// The filter to apply, or null to watch every reader and report every card.
+        /// </param>
+        /// <returns>
+        /// An instance of DesktopSmartCardDeviceListener.
+        /// </returns>
+        /// <exception cref="PlatformNotSupportedException">
+        /// This class depends on operating system specific support being present. If this exception is being raised,
+        /// the operating system or platform that you are attempting to run this does not have a smart card device notification
+        /// support.
+        /// </exception>
+        public static SmartCardDeviceListener Create(SmartCardReaderFilter? readerFilter) =>
             SdkPlatformInfo.OperatingSystem switch
             {
-                SdkPlatform.Windows => new DesktopSmartCardDeviceListener(),
-                SdkPlatform.MacOS => new DesktopSmartCardDeviceListener(),
-                SdkPlatform.Linux => new DesktopSmartCardDeviceListener(),
+                SdkPlatform.Windows => new DesktopSmartCardDeviceListener(readerFilter),
+                SdkPlatform.MacOS => new DesktopSmartCardDeviceListener(readerFilter),
+                SdkPlatform.Linux => new DesktopSmartCardDeviceListener(readerFilter),
                 _ => throw new PlatformNotSupportedException()
             };
 
@@ -1,6 +1,7 @@
 ﻿// Copyright (c) Yubico AB
 
 using System;
+using Microsoft.Extensions.Logging;
 using Yubico.Core.Logging;
 using Yubico.PlatformInterop;
 
@@ -8,6 +9,17 @@ namespace Yubico.Core.Devices.SmartCard
 {
     internal static class SmartCardLoggerExtensions
     {
+        // SCardApiCall runs on every transmit, so its messages are parsed once here rather than on every call, and
+        // nothing is boxed or formatted unless a provider has the level enabled.
+        private static readonly Action<ILogger, string, Exception?> _apiCallSucceeded =
+            LoggerMessage.Define<string>(LogLevel.Information, default, "{ApiName} called successfully.");
+
+        private static readonly Action<ILogger, string, uint, Exception?> _apiCallFailed =
+            LoggerMessage.Define<string, uint>(LogLevel.Error, default, "{ApiName} called and FAILED. Result = {Result:X}");
+
+        private static readonly Action<ILogger, SCARD_READER_STATE[], Exception?> _readerStates =
+            LoggerMessage.Define<SCARD_READER_STATE[]>(LogLevel.Information, default, "Reader states:\n{States}");
+
         public static IDisposable BeginTransactionScope(this Logger logger, IDisposable transactionScope) =>
             logger.BeginScope("Transaction[{TransactionID}]", transactionScope.GetHashCode());
 
@@ -15,11 +27,22 @@ namespace Yubico.Core.Devices.SmartCard
         {
             if (result == ErrorCode.SCARD_S_SUCCESS)
             {
-                logger.LogInformation("{ApiName} called successfully.", apiName);
+                if (logger.IsEnabled(LogLevel.Information))
+                {
+                    _apiCallSucceeded(logger, apiName, null);
+                }
+            }
+            else if (logger.IsEnabled(LogLevel.Error))
+            {
+                _apiCallFailed(logger, apiName, result, null);
             }
-            else
+        }
+
+        public static void ReaderStates(this Logger logger, SCARD_READER_STATE[] states)
+        {
+            if (logger.IsEnabled(LogLevel.Information))
             {
-                logger.LogError("{ApiName} called and FAILED. Result = {Result:X}", apiName, result);
+                _readerStates(logger, states, null);
             }
         }
 
@@ -0,0 +1,38 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+namespace Yubico.Core.Devices.SmartCard
+{
+    /// <summary>
+    /// The transmission protocol a smart card connection is using.
+    /// </summary>
+    public enum SmartCardProtocol
+    {
+        /// <summary>
+        /// No protocol is active, or the reader reported one the SDK does not know.
+        /// </summary>
+        Unknown = 0,
+
+        /// <summary>
+        /// T=0, the character-oriented protocol.
+        /// </summary>
+        T0 = 1,
+
+        /// <summary>
+        /// T=1, the block-oriented protocol.
+        /// </summary>
+        T1 = 2,
+    }
+}
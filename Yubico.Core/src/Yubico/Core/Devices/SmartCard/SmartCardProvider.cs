@@ -0,0 +1,64 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using Yubico.PlatformInterop;
+
+using static Yubico.PlatformInterop.NativeMethods;
+
+namespace Yubico.Core.Devices.SmartCard
+{
+    /// <summary>
+    /// Chooses the PC/SC library that smart card devices are reached through.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// On Linux the native shim does not link pcsc-lite. It opens it the first time a smart card function is called,
+    /// so processes that only use HID devices never load it, and the shim still loads on hosts where pcsc-lite is not
+    /// installed. Any other library that exports the PC/SC API, such as an emulator or a provider that replays a
+    /// recorded trace, can be used instead, either by naming it in the <c>YUBICO_PCSC_LIBRARY</c> environment
+    /// variable or by calling <see cref="Select"/>.
+    /// </para>
+    /// <para>
+    /// On Windows and macOS the platform's PC/SC library is always used.
+    /// </para>
+    /// </remarks>
+    public static class SmartCardProvider
+    {
+        /// <summary>
+        /// Sends all later smart card calls to the PC/SC library at <paramref name="libraryPath"/>.
+        /// </summary>
+        /// <remarks>
+        /// Connections and listeners opened through the previous provider must not be used afterwards.
+        /// </remarks>
+        /// <param name="libraryPath">
+        /// The file name or path of the library, or null for the default: <c>libpcsclite.so.1</c>, or the library named
+        /// by <c>PCSC_LIB</c> when the native shim was built with it.
+        /// </param>
+        /// <exception cref="SCardException">
+        /// The library could not be opened, or it does not export every PC/SC function the SDK needs, or this platform
+        /// does not support choosing the provider.
+        /// </exception>
+        public static void Select(string? libraryPath)
+        {
+            // Contexts established through the previous provider mean nothing to the new one, so the pool releases
+            // its idle ones first, and holds off new ones until the switch is done.
+            uint result = SCardContextPool.Shared.SwitchProvider(() => SCardSelectBackend(libraryPath));
+
+            if (result != ErrorCode.SCARD_S_SUCCESS)
+            {
+                throw new SCardException(ExceptionMessages.SCardProviderNotLoaded, result);
+            }
+        }
+    }
+}
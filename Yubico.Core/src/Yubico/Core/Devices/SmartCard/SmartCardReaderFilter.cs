@@ -0,0 +1,140 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Text;
+using Yubico.Core.Buffers;
+using Yubico.Core.Iso7816;
+
+namespace Yubico.Core.Devices.SmartCard
+{
+    /// <summary>
+    /// Restricts the readers and cards that a <see cref="SmartCardDeviceListener"/> watches.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// The filter is evaluated by the native PC/SC shim. Readers whose names match none of the
+    /// <see cref="ReaderNamePatterns"/> are left out of the set of readers the listener waits on, so changes in them
+    /// never wake the listener. A card whose ATR does not start with one of the <see cref="AtrPrefixes"/> is treated
+    /// as if its reader were empty, so its arrival and removal raise no events.
+    /// </para>
+    /// <para>
+    /// In a reader name pattern, <c>*</c> matches any run of characters and <c>?</c> matches any single character.
+    /// Matching is case-insensitive. Patterns are matched against the names from PC/SC's ANSI interface, so they
+    /// must be ASCII. An empty list of patterns matches every reader, and an empty list of prefixes matches every
+    /// card.
+    /// </para>
+    /// </remarks>
+    public sealed class SmartCardReaderFilter
+    {
+        // The longest ATR that PC/SC can report.
+        private const int MaxAtrLength = 36;
+
+        /// <summary>
+        /// The patterns that a reader's name must match for the reader to be watched.
+        /// </summary>
+        public IReadOnlyList<string> ReaderNamePatterns { get; }
+
+        /// <summary>
+        /// The prefixes that a card's ATR must start with for the card to be reported.
+        /// </summary>
+        public IReadOnlyList<AnswerToReset> AtrPrefixes { get; }
+
+        // The patterns as the ANSI multi-string the shim expects, or null if every reader matches.
+        internal byte[]? EncodedReaderNamePatterns { get; }
+
+        // The prefixes packed as a length byte followed by the prefix bytes, or null if every card matches.
+        internal byte[]? EncodedAtrPrefixes { get; }
+
+        /// <summary>
+        /// Constructs a <see cref="SmartCardReaderFilter"/>.
+        /// </summary>
+        /// <param name="readerNamePatterns">
+        /// The reader name patterns. Null or empty to watch every reader.
+        /// </param>
+        /// <param name="atrPrefixes">
+        /// The ATR prefixes. Null or empty to report every card.
+        /// </param>
+        /// <exception cref="ArgumentException">
+        /// A pattern is null, empty or contains a NUL or non-ASCII character, or a prefix is empty or longer than 36 bytes.
+        /// </exception>
+        public SmartCardReaderFilter(IEnumerable<string>? readerNamePatterns, IEnumerable<AnswerToReset>? atrPrefixes)
+        {
+            string[] patterns = readerNamePatterns?.ToArray() ?? Array.Empty<string>();
+            AnswerToReset[] prefixes = atrPrefixes?.ToArray() ?? Array.Empty<AnswerToReset>();
+
+            foreach (string pattern in patterns)
+            {
+                if (string.IsNullOrEmpty(pattern) || !IsValidPattern(pattern))
+                {
+                    throw new ArgumentException(ExceptionMessages.InvalidReaderNamePattern, nameof(readerNamePatterns));
+                }
+            }
+
+            int encodedPrefixesLength = 0;
+
+            foreach (AnswerToReset prefix in prefixes)
+            {
+                int length = prefix is null ? 0 : prefix.AsSpan().Length;
+
+                if (length == 0 || length > MaxAtrLength)
+                {
+                    throw new ArgumentException(ExceptionMessages.InvalidAtrPrefix, nameof(atrPrefixes));
+                }
+
+                encodedPrefixesLength += 1 + length;
+            }
+
+            ReaderNamePatterns = patterns;
+            AtrPrefixes = prefixes;
+
+            if (patterns.Length > 0)
+            {
+                EncodedReaderNamePatterns = MultiString.GetBytes(patterns, Encoding.ASCII);
+            }
+
+            if (prefixes.Length > 0)
+            {
+                byte[] encodedPrefixes = new byte[encodedPrefixesLength];
+                int offset = 0;
+
+                foreach (AnswerToReset prefix in prefixes)
+                {
+                    ReadOnlySpan<byte> bytes = prefix.AsSpan();
+                    encodedPrefixes[offset++] = (byte)bytes.Length;
+                    bytes.CopyTo(encodedPrefixes.AsSpan(offset));
+                    offset += bytes.Length;
+                }
+
+                EncodedAtrPrefixes = encodedPrefixes;
+            }
+        }
+
+        // Encoding.ASCII would turn any other character into '?', which the shim would then treat as a wildcard.
+        private static bool IsValidPattern(string pattern)
+        {
+            foreach (char c in pattern)
+            {
+                if (c == '\0' || c > 0x7F)
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    }
+}
@@ -0,0 +1,58 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+namespace Yubico.Core.Devices.SmartCard
+{
+    /// <summary>
+    /// How far a smart card in a reader has progressed towards being ready for commands.
+    /// </summary>
+    public enum SmartCardState
+    {
+        /// <summary>
+        /// The reader driver does not know the state of the card.
+        /// </summary>
+        Unknown = 0,
+
+        /// <summary>
+        /// There is no card in the reader.
+        /// </summary>
+        Absent = 1,
+
+        /// <summary>
+        /// There is a card in the reader, but it has not been moved into position for use.
+        /// </summary>
+        Present = 2,
+
+        /// <summary>
+        /// There is a card in the reader in position for use, but it is not powered.
+        /// </summary>
+        Swallowed = 3,
+
+        /// <summary>
+        /// The card is powered, but the reader driver does not know its mode.
+        /// </summary>
+        Powered = 4,
+
+        /// <summary>
+        /// The card has been reset and is waiting for protocol negotiation.
+        /// </summary>
+        Negotiable = 5,
+
+        /// <summary>
+        /// The card has been reset and a communication protocol has been established.
+        /// </summary>
+        Specific = 6,
+    }
+}
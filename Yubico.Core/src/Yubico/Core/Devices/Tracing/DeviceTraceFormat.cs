@@ -0,0 +1,99 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using System.Buffers.Binary;
+using System.Diagnostics;
+
+namespace Yubico.Core.Devices.Tracing
+{
+    // The on-disk layout shared by DeviceTraceRecorder and DeviceTraceReader. All integers are little endian.
+    //
+    //  File header (64 bytes)
+    //    0  u32  magic "YKTR"
+    //    4  u16  format version
+    //    6  u16  reserved
+    //    8  i64  start time, UTC DateTime ticks
+    //   16  i64  offset of the end of the record data
+    //   24  i64  number of records
+    //   32  i64  offset of the record index, 0 if the index was not written
+    //   40  i64  number of records dropped because the ring or file was full
+    //   48  16 bytes reserved
+    //
+    //  Record header (20 bytes), followed by the command bytes and then the response bytes
+    //    0  u8   DeviceTraceRecordKind
+    //    1  u8   flags
+    //    2  u16  connection ID
+    //    4  i64  timestamp, microseconds since the start time
+    //   12  u32  elapsed microseconds
+    //   16  u16  command length
+    //   18  u16  response length
+    //
+    //  Index: one i64 file offset per record, written when the recorder is disposed.
+    internal static class DeviceTraceFormat
+    {
+        public const uint Magic = 0x52544B59; // "YKTR"
+        public const ushort Version = 1;
+
+        public const int FileHeaderSize = 64;
+        public const int RecordHeaderSize = 20;
+
+        public const int DataEndOffset = 16;
+        public const int RecordCountOffset = 24;
+        public const int IndexOffsetOffset = 32;
+        public const int DroppedCountOffset = 40;
+
+        public const byte FlagRedacted = 0x01;
+        public const byte FlagTruncated = 0x02;
+
+        public static void WriteFileHeader(Span<byte> header, DateTime startTimeUtc, long dataEnd, long recordCount, long indexOffset, long droppedCount)
+        {
+            header.Slice(0, FileHeaderSize).Clear();
+            BinaryPrimitives.WriteUInt32LittleEndian(header, Magic);
+            BinaryPrimitives.WriteUInt16LittleEndian(header.Slice(4), Version);
+            BinaryPrimitives.WriteInt64LittleEndian(header.Slice(8), startTimeUtc.Ticks);
+            BinaryPrimitives.WriteInt64LittleEndian(header.Slice(DataEndOffset), dataEnd);
+            BinaryPrimitives.WriteInt64LittleEndian(header.Slice(RecordCountOffset), recordCount);
+            BinaryPrimitives.WriteInt64LittleEndian(header.Slice(IndexOffsetOffset), indexOffset);
+            BinaryPrimitives.WriteInt64LittleEndian(header.Slice(DroppedCountOffset), droppedCount);
+        }
+
+        public static void WriteRecordHeader(
+            Span<byte> header,
+            DeviceTraceRecordKind kind,
+            byte flags,
+            ushort connectionId,
+            long timestampMicroseconds,
+            uint elapsedMicroseconds,
+            int commandLength,
+            int responseLength)
+        {
+            header[0] = (byte)kind;
+            header[1] = flags;
+            BinaryPrimitives.WriteUInt16LittleEndian(header.Slice(2), connectionId);
+            BinaryPrimitives.WriteInt64LittleEndian(header.Slice(4), timestampMicroseconds);
+            BinaryPrimitives.WriteUInt32LittleEndian(header.Slice(12), elapsedMicroseconds);
+            BinaryPrimitives.WriteUInt16LittleEndian(header.Slice(16), (ushort)commandLength);
+            BinaryPrimitives.WriteUInt16LittleEndian(header.Slice(18), (ushort)responseLength);
+        }
+
+        public static int GetRecordLength(ReadOnlySpan<byte> header) =>
+            RecordHeaderSize
+            + BinaryPrimitives.ReadUInt16LittleEndian(header.Slice(16))
+            + BinaryPrimitives.ReadUInt16LittleEndian(header.Slice(18));
+
+        public static long ToMicroseconds(long stopwatchTicks) =>
+            (long)(stopwatchTicks * (1_000_000.0 / Stopwatch.Frequency));
+    }
+}
@@ -0,0 +1,85 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+
+namespace Yubico.Core.Devices.Tracing
+{
+    /// <summary>
+    /// Latency statistics for every exchange in a trace that used the same instruction.
+    /// </summary>
+    /// <remarks>
+    /// For <see cref="DeviceTraceRecordKind.Apdu"/> the instruction is the INS byte of the command APDU, and the
+    /// latency is that of a single APDU. For <see cref="DeviceTraceRecordKind.HidOutputReport"/> the instruction is the
+    /// CTAPHID command, and the latency runs from the initialization packet of the request until the last report read
+    /// before the next request on the same connection, which includes any time spent waiting for the user to touch
+    /// the key.
+    /// </remarks>
+    public sealed class DeviceTraceInstructionSummary
+    {
+        /// <summary>
+        /// Whether <see cref="Instruction"/> is an APDU INS byte or a CTAPHID command.
+        /// </summary>
+        public DeviceTraceRecordKind Kind { get; }
+
+        /// <summary>
+        /// The APDU INS byte, or the CTAPHID command with the initialization packet bit cleared.
+        /// </summary>
+        public byte Instruction { get; }
+
+        /// <summary>
+        /// The number of exchanges.
+        /// </summary>
+        public int Count { get; }
+
+        /// <summary>
+        /// The mean latency.
+        /// </summary>
+        public TimeSpan Mean { get; }
+
+        /// <summary>
+        /// The median latency.
+        /// </summary>
+        public TimeSpan Median { get; }
+
+        /// <summary>
+        /// The 95th percentile latency.
+        /// </summary>
+        public TimeSpan Percentile95 { get; }
+
+        /// <summary>
+        /// The longest latency.
+        /// </summary>
+        public TimeSpan Max { get; }
+
+        internal DeviceTraceInstructionSummary(DeviceTraceRecordKind kind, byte instruction, long[] sortedTicks)
+        {
+            Kind = kind;
+            Instruction = instruction;
+            Count = sortedTicks.Length;
+
+            long total = 0;
+
+            foreach (long ticks in sortedTicks)
+            {
+                total += ticks;
+            }
+
+            Mean = TimeSpan.FromTicks(total / sortedTicks.Length);
+            Median = TimeSpan.FromTicks(sortedTicks[(sortedTicks.Length - 1) / 2]);
+            Percentile95 = TimeSpan.FromTicks(sortedTicks[(int)Math.Ceiling(sortedTicks.Length * 0.95) - 1]);
+            Max = TimeSpan.FromTicks(sortedTicks[sortedTicks.Length - 1]);
+        }
+    }
+}
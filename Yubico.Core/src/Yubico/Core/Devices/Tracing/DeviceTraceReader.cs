@@ -0,0 +1,273 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using System.Buffers.Binary;
+using System.Collections;
+using System.Collections.Generic;
+using System.IO;
+using System.IO.MemoryMappedFiles;
+using System.Linq;
+
+namespace Yubico.Core.Devices.Tracing
+{
+    /// <summary>
+    /// Reads a trace file written by <see cref="DeviceTraceRecorder"/>.
+    /// </summary>
+    /// <remarks>
+    /// The file is memory-mapped, and records are decoded only when they are asked for. A trace whose recorder was
+    /// never disposed, for example because the process crashed, has no index; the reader then finds the records by
+    /// walking the data from the start.
+    /// </remarks>
+    public sealed class DeviceTraceReader : IEnumerable<DeviceTraceRecord>, IDisposable
+    {
+        private const int CtapHidReportSize = 64;
+        private const int CtapHidCommandOffset = 4;
+        private const byte CtapHidInitializationBit = 0x80;
+
+        private readonly MemoryMappedFile _file;
+        private readonly MemoryMappedViewAccessor _view;
+        private readonly long[] _index;
+
+        /// <summary>
+        /// When the recording started.
+        /// </summary>
+        public DateTime StartTimeUtc { get; }
+
+        /// <summary>
+        /// The number of records in the trace.
+        /// </summary>
+        public long RecordCount => _index.LongLength;
+
+        /// <summary>
+        /// The number of records the recorder had to drop.
+        /// </summary>
+        public long DroppedCount { get; }
+
+        private DeviceTraceReader(string filePath)
+        {
+            long fileLength = new FileInfo(filePath).Length;
+
+            if (fileLength < DeviceTraceFormat.FileHeaderSize)
+            {
+                throw new ArgumentException(ExceptionMessages.InvalidDeviceTraceFile, nameof(filePath));
+            }
+
+            _file = MemoryMappedFile.CreateFromFile(filePath, FileMode.Open, null, 0, MemoryMappedFileAccess.Read);
+            _view = _file.CreateViewAccessor(0, 0, MemoryMappedFileAccess.Read);
+
+            byte[] header = new byte[DeviceTraceFormat.FileHeaderSize];
+            _ = _view.ReadArray(0, header, 0, header.Length);
+
+            if (BinaryPrimitives.ReadUInt32LittleEndian(header) != DeviceTraceFormat.Magic
+                || BinaryPrimitives.ReadUInt16LittleEndian(header.AsSpan(4)) != DeviceTraceFormat.Version)
+            {
+                Dispose();
+
+                throw new ArgumentException(ExceptionMessages.InvalidDeviceTraceFile, nameof(filePath));
+            }
+
+            StartTimeUtc = new DateTime(BinaryPrimitives.ReadInt64LittleEndian(header.AsSpan(8)), DateTimeKind.Utc);
+            DroppedCount = BinaryPrimitives.ReadInt64LittleEndian(header.AsSpan(DeviceTraceFormat.DroppedCountOffset));
+
+            long dataEnd = BinaryPrimitives.ReadInt64LittleEndian(header.AsSpan(DeviceTraceFormat.DataEndOffset));
+            long recordCount = BinaryPrimitives.ReadInt64LittleEndian(header.AsSpan(DeviceTraceFormat.RecordCountOffset));
+            long indexOffset = BinaryPrimitives.ReadInt64LittleEndian(header.AsSpan(DeviceTraceFormat.IndexOffsetOffset));
+
+            _index = indexOffset != 0 && indexOffset + (recordCount * sizeof(long)) <= fileLength
+                ? ReadIndex(indexOffset, recordCount)
+                : ScanRecords(Math.Min(dataEnd, fileLength));
+        }
+
+        /// <summary>
+        /// Opens a trace file.
+        /// </summary>
+        /// <param name="filePath">The file written by a <see cref="DeviceTraceRecorder"/>.</param>
+        /// <returns>A reader over the records in the file.</returns>
+        /// <exception cref="ArgumentException">
+        /// The file is not a device trace, or was written by an incompatible version of the SDK.
+        /// </exception>
+        public static DeviceTraceReader Open(string filePath) => new DeviceTraceReader(filePath);
+
+        /// <summary>
+        /// Reads the record at the given position in the trace.
+        /// </summary>
+        /// <param name="recordNumber">The zero-based position of the record.</param>
+        public DeviceTraceRecord ReadRecord(long recordNumber)
+        {
+            if (recordNumber < 0 || recordNumber >= _index.LongLength)
+            {
+                throw new ArgumentOutOfRangeException(nameof(recordNumber));
+            }
+
+            long offset = _index[recordNumber];
+            byte[] header = new byte[DeviceTraceFormat.RecordHeaderSize];
+            _ = _view.ReadArray(offset, header, 0, header.Length);
+
+            int commandLength = BinaryPrimitives.ReadUInt16LittleEndian(header.AsSpan(16));
+            int responseLength = BinaryPrimitives.ReadUInt16LittleEndian(header.AsSpan(18));
+
+            byte[] command = new byte[commandLength];
+            byte[] response = new byte[responseLength];
+            _ = _view.ReadArray(offset + DeviceTraceFormat.RecordHeaderSize, command, 0, commandLength);
+            _ = _view.ReadArray(offset + DeviceTraceFormat.RecordHeaderSize + commandLength, response, 0, responseLength);
+
+            return new DeviceTraceRecord(
+                (DeviceTraceRecordKind)header[0],
+                header[1],
+                BinaryPrimitives.ReadUInt16LittleEndian(header.AsSpan(2)),
+                FromMicroseconds(BinaryPrimitives.ReadInt64LittleEndian(header.AsSpan(4))),
+                FromMicroseconds(BinaryPrimitives.ReadUInt32LittleEndian(header.AsSpan(12))),
+                command,
+                response);
+        }
+
+        /// <summary>
+        /// Computes latency statistics for each APDU instruction and CTAPHID command in the trace.
+        /// </summary>
+        /// <returns>
+        /// One summary per instruction, APDUs first, each group ordered by instruction.
+        /// </returns>
+        public IReadOnlyList<DeviceTraceInstructionSummary> SummarizeByInstruction()
+        {
+            var latencies = new Dictionary<(DeviceTraceRecordKind, byte), List<long>>();
+            var openRequests = new Dictionary<int, (byte Command, TimeSpan Start, TimeSpan End)>();
+
+            void Add(DeviceTraceRecordKind kind, byte instruction, TimeSpan latency)
+            {
+                if (!latencies.TryGetValue((kind, instruction), out List<long>? list))
+                {
+                    list = new List<long>();
+                    latencies.Add((kind, instruction), list);
+                }
+
+                list.Add(latency.Ticks);
+            }
+
+            void CloseRequest(int connectionId)
+            {
+                if (openRequests.TryGetValue(connectionId, out (byte Command, TimeSpan Start, TimeSpan End) request))
+                {
+                    Add(DeviceTraceRecordKind.HidOutputReport, request.Command, request.End - request.Start);
+                    _ = openRequests.Remove(connectionId);
+                }
+            }
+
+            foreach (DeviceTraceRecord record in this)
+            {
+                switch (record.Kind)
+                {
+                    case DeviceTraceRecordKind.Apdu when record.Command.Length > 1:
+                        Add(DeviceTraceRecordKind.Apdu, record.Command.Span[1], record.Elapsed);
+                        break;
+
+                    // A CTAPHID request starts with an initialization packet and is complete once the device has
+                    // answered, which is when the next request starts. Continuation packets and keepalives fall in
+                    // between.
+                    case DeviceTraceRecordKind.HidOutputReport
+                        when record.Command.Length == CtapHidReportSize
+                            && (record.Command.Span[CtapHidCommandOffset] & CtapHidInitializationBit) != 0:
+                        CloseRequest(record.ConnectionId);
+                        openRequests[record.ConnectionId] = (
+                            (byte)(record.Command.Span[CtapHidCommandOffset] & ~CtapHidInitializationBit),
+                            record.Timestamp,
+                            record.Timestamp + record.Elapsed);
+                        break;
+
+                    case DeviceTraceRecordKind.HidOutputReport:
+                    case DeviceTraceRecordKind.HidInputReport:
+                        if (openRequests.TryGetValue(record.ConnectionId, out (byte Command, TimeSpan Start, TimeSpan End) request))
+                        {
+                            openRequests[record.ConnectionId] = (request.Command, request.Start, record.Timestamp + record.Elapsed);
+                        }
+                        break;
+
+                    default:
+                        break;
+                }
+            }
+
+            foreach (int connectionId in openRequests.Keys.ToList())
+            {
+                CloseRequest(connectionId);
+            }
+
+            return latencies
+                .OrderBy(entry => entry.Key.Item1)
+                .ThenBy(entry => entry.Key.Item2)
+                .Select(entry =>
+                {
+                    long[] ticks = entry.Value.ToArray();
+                    Array.Sort(ticks);
+
+                    return new DeviceTraceInstructionSummary(entry.Key.Item1, entry.Key.Item2, ticks);
+                })
+                .ToList();
+        }
+
+        /// <inheritdoc/>
+        public IEnumerator<DeviceTraceRecord> GetEnumerator()
+        {
+            for (long i = 0; i < _index.LongLength; i++)
+            {
+                yield return ReadRecord(i);
+            }
+        }
+
+        IEnumerator IEnumerable.GetEnumerator() => GetEnumerator();
+
+        /// <summary>
+        /// Closes the trace file.
+        /// </summary>
+        public void Dispose()
+        {
+            _view.Dispose();
+            _file.Dispose();
+        }
+
+        private static TimeSpan FromMicroseconds(long microseconds) =>
+            TimeSpan.FromTicks(microseconds * (TimeSpan.TicksPerMillisecond / 1000));
+
+        private long[] ReadIndex(long indexOffset, long recordCount)
+        {
+            long[] index = new long[recordCount];
+            _ = _view.ReadArray(indexOffset, index, 0, index.Length);
+
+            return index;
+        }
+
+        private long[] ScanRecords(long dataEnd)
+        {
+            var index = new List<long>();
+            byte[] header = new byte[DeviceTraceFormat.RecordHeaderSize];
+            long offset = DeviceTraceFormat.FileHeaderSize;
+
+            while (offset + DeviceTraceFormat.RecordHeaderSize <= dataEnd)
+            {
+                _ = _view.ReadArray(offset, header, 0, header.Length);
+                int length = DeviceTraceFormat.GetRecordLength(header);
+
+                if (offset + length > dataEnd)
+                {
+                    break;
+                }
+
+                index.Add(offset);
+                offset += length;
+            }
+
+            return index.ToArray();
+        }
+    }
+}
@@ -0,0 +1,87 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+
+namespace Yubico.Core.Devices.Tracing
+{
+    /// <summary>
+    /// One exchange read back from a device trace.
+    /// </summary>
+    public sealed class DeviceTraceRecord
+    {
+        /// <summary>
+        /// What was exchanged.
+        /// </summary>
+        public DeviceTraceRecordKind Kind { get; }
+
+        /// <summary>
+        /// Identifies the connection the exchange took place on. Records with the same value came from the same
+        /// connection.
+        /// </summary>
+        public int ConnectionId { get; }
+
+        /// <summary>
+        /// When the exchange started, relative to <see cref="DeviceTraceReader.StartTimeUtc"/>.
+        /// </summary>
+        public TimeSpan Timestamp { get; }
+
+        /// <summary>
+        /// How long the exchange took.
+        /// </summary>
+        public TimeSpan Elapsed { get; }
+
+        /// <summary>
+        /// The command APDU, or the report sent for a <see cref="DeviceTraceRecordKind.HidOutputReport"/>. Empty for
+        /// a <see cref="DeviceTraceRecordKind.HidInputReport"/>.
+        /// </summary>
+        public ReadOnlyMemory<byte> Command { get; }
+
+        /// <summary>
+        /// The response APDU, including the status word, or the report received for a
+        /// <see cref="DeviceTraceRecordKind.HidInputReport"/>. Empty for a
+        /// <see cref="DeviceTraceRecordKind.HidOutputReport"/>.
+        /// </summary>
+        public ReadOnlyMemory<byte> Response { get; }
+
+        /// <summary>
+        /// True if the recorder kept only part of the exchange. See <see cref="DeviceTraceRedaction"/>.
+        /// </summary>
+        public bool IsRedacted { get; }
+
+        /// <summary>
+        /// True if the exchange was too long for the trace format and was cut short.
+        /// </summary>
+        public bool IsTruncated { get; }
+
+        internal DeviceTraceRecord(
+            DeviceTraceRecordKind kind,
+            byte flags,
+            int connectionId,
+            TimeSpan timestamp,
+            TimeSpan elapsed,
+            ReadOnlyMemory<byte> command,
+            ReadOnlyMemory<byte> response)
+        {
+            Kind = kind;
+            ConnectionId = connectionId;
+            Timestamp = timestamp;
+            Elapsed = elapsed;
+            Command = command;
+            Response = response;
+            IsRedacted = (flags & DeviceTraceFormat.FlagRedacted) != 0;
+            IsTruncated = (flags & DeviceTraceFormat.FlagTruncated) != 0;
+        }
+    }
+}
@@ -0,0 +1,37 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+namespace Yubico.Core.Devices.Tracing
+{
+    /// <summary>
+    /// The exchange a <see cref="DeviceTraceRecord"/> describes.
+    /// </summary>
+    public enum DeviceTraceRecordKind : byte
+    {
+        /// <summary>
+        /// A command APDU and the response APDU returned for it by a smart card connection.
+        /// </summary>
+        Apdu = 1,
+
+        /// <summary>
+        /// A report sent to a HID device.
+        /// </summary>
+        HidOutputReport = 2,
+
+        /// <summary>
+        /// A report received from a HID device.
+        /// </summary>
+        HidInputReport = 3,
+    }
+}
@@ -0,0 +1,532 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.IO.MemoryMappedFiles;
+using System.Threading;
+using Yubico.Core.Devices.Hid;
+using Yubico.Core.Devices.SmartCard;
+using Yubico.Core.Iso7816;
+
+namespace Yubico.Core.Devices.Tracing
+{
+    /// <summary>
+    /// Records every APDU and HID report exchanged with a device to a compact binary trace file.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Recording is opt-in. Call <see cref="Start"/> before connecting to a device, and every
+    /// <see cref="ISmartCardConnection"/> and <see cref="IHidConnection"/> opened while the recorder is active will
+    /// log its traffic, along with when it happened and how long the device took to answer. Use
+    /// <see cref="DeviceTraceReader"/> to examine the result.
+    /// </para>
+    /// <para>
+    /// A connection does no I/O of its own to record an exchange: the record is copied into a preallocated ring buffer,
+    /// and a background thread moves the contents of the ring into a memory-mapped file. If the application produces
+    /// records faster than they can be flushed, or the file reaches its capacity, further records are dropped and
+    /// counted rather than slowing the application down. When the recorder is disposed, it appends an index of record
+    /// offsets and trims the file to the length actually used.
+    /// </para>
+    /// <para>
+    /// Traces can contain secrets. Choose the <see cref="DeviceTraceRedaction"/> appropriate for where the file will
+    /// end up.
+    /// </para>
+    /// </remarks>
+    public sealed class DeviceTraceRecorder : IDisposable
+    {
+        /// <summary>
+        /// The maximum size of the trace file, unless another is given to <see cref="Start"/>.
+        /// </summary>
+        public const long DefaultCapacity = 64L * 1024 * 1024;
+
+        private const int RingSize = 1024 * 1024;
+        private const int FlushIntervalMilliseconds = 100;
+        private const int RedactedCommandLength = 4;
+
+        // A keyboard feature report is seven bytes of payload followed by the sequence and flag byte. A CTAPHID
+        // initialization packet starts with the channel ID, the command and the payload length; a continuation packet
+        // with the channel ID and the sequence number.
+        private const int FeatureReportFlagOffset = 7;
+        private const int CtapHidCommandOffset = 4;
+        private const int CtapHidInitHeaderLength = 7;
+        private const int CtapHidContinuationHeaderLength = 5;
+        private const int MaxStackReportLength = 128;
+
+        private static readonly object _startLock = new object();
+        private static DeviceTraceRecorder? _active;
+        private static int _nextConnectionId;
+
+        private readonly long _capacity;
+        private readonly DateTime _startTimeUtc;
+        private readonly long _startTimestamp;
+
+        // Everything the connections touch is guarded by _ringLock. The flush thread is the only reader of the ring,
+        // so it copies records out without holding the lock and only takes it to publish the new tail.
+        private readonly object _ringLock = new object();
+        private readonly byte[] _ring = new byte[RingSize];
+        private long _ringHead;
+        private long _ringTail;
+        private long _droppedCount;
+        private bool _disposed;
+
+        // Only used by the flush thread, or by Dispose once the flush thread has exited.
+        private readonly MemoryMappedFile _file;
+        private readonly MemoryMappedViewAccessor _view;
+        private readonly List<long> _index = new List<long>();
+        private readonly byte[] _flushRecordHeader = new byte[DeviceTraceFormat.RecordHeaderSize];
+        private readonly byte[] _fileHeader = new byte[DeviceTraceFormat.FileHeaderSize];
+        private long _fileOffset = DeviceTraceFormat.FileHeaderSize;
+
+        private readonly AutoResetEvent _flushSignal = new AutoResetEvent(false);
+        private readonly Thread _flushThread;
+        private volatile bool _stopping;
+
+        /// <summary>
+        /// The recorder that newly opened connections report to, if any.
+        /// </summary>
+        public static DeviceTraceRecorder? Active => Volatile.Read(ref _active);
+
+        /// <summary>
+        /// The path of the trace file.
+        /// </summary>
+        public string FilePath { get; }
+
+        /// <summary>
+        /// How much of each exchange is kept.
+        /// </summary>
+        public DeviceTraceRedaction Redaction { get; }
+
+        /// <summary>
+        /// The number of records that were not written because the ring buffer or the file was full.
+        /// </summary>
+        public long DroppedCount
+        {
+            get
+            {
+                lock (_ringLock)
+                {
+                    return _droppedCount;
+                }
+            }
+        }
+
+        private DeviceTraceRecorder(string filePath, DeviceTraceRedaction redaction, long capacity)
+        {
+            FilePath = filePath;
+            Redaction = redaction;
+            _capacity = capacity;
+            _startTimeUtc = DateTime.UtcNow;
+            _startTimestamp = Stopwatch.GetTimestamp();
+
+            _file = MemoryMappedFile.CreateFromFile(filePath, FileMode.Create, null, capacity, MemoryMappedFileAccess.ReadWrite);
+            _view = _file.CreateViewAccessor(0, capacity);
+            WriteFileHeader(0);
+
+            _flushThread = new Thread(FlushLoop)
+            {
+                IsBackground = true,
+                Name = nameof(DeviceTraceRecorder),
+            };
+            _flushThread.Start();
+        }
+
+        /// <summary>
+        /// Creates a trace file and starts recording every connection opened from now on.
+        /// </summary>
+        /// <param name="filePath">The file to record to. An existing file is overwritten.</param>
+        /// <param name="redaction">How much of each exchange to keep.</param>
+        /// <param name="capacity">The maximum size of the trace file, in bytes.</param>
+        /// <returns>The active recorder. Dispose it, or call <see cref="Stop"/>, to finish the trace.</returns>
+        /// <exception cref="ArgumentNullException">
+        /// <paramref name="filePath"/> is null.
+        /// </exception>
+        /// <exception cref="ArgumentOutOfRangeException">
+        /// <paramref name="capacity"/> is too small to hold the file header.
+        /// </exception>
+        /// <exception cref="InvalidOperationException">
+        /// Another recorder is already active.
+        /// </exception>
+        public static DeviceTraceRecorder Start(
+            string filePath,
+            DeviceTraceRedaction redaction = DeviceTraceRedaction.SensitiveInstructions,
+            long capacity = DefaultCapacity)
+        {
+            if (filePath is null)
+            {
+                throw new ArgumentNullException(nameof(filePath));
+            }
+
+            if (capacity <= DeviceTraceFormat.FileHeaderSize)
+            {
+                throw new ArgumentOutOfRangeException(nameof(capacity));
+            }
+
+            // Check before creating the recorder: the constructor truncates the file, which may well be the one the
+            // active recorder is writing to.
+            lock (_startLock)
+            {
+                if (!(Volatile.Read(ref _active) is null))
+                {
+                    throw new InvalidOperationException(ExceptionMessages.TraceRecorderAlreadyActive);
+                }
+
+                var recorder = new DeviceTraceRecorder(filePath, redaction, capacity);
+                Volatile.Write(ref _active, recorder);
+
+                return recorder;
+            }
+        }
+
+        /// <summary>
+        /// Finishes the active trace, if there is one.
+        /// </summary>
+        public static void Stop() => Volatile.Read(ref _active)?.Dispose();
+
+        /// <summary>
+        /// Stops recording, flushes every outstanding record and writes the index.
+        /// </summary>
+        public void Dispose()
+        {
+            lock (_ringLock)
+            {
+                if (_disposed)
+                {
+                    return;
+                }
+
+                _disposed = true;
+            }
+
+            _ = Interlocked.CompareExchange(ref _active, null, this);
+
+            _stopping = true;
+            _ = _flushSignal.Set();
+            _flushThread.Join();
+
+            Flush();
+
+            long indexOffset = 0;
+            long fileLength = _fileOffset;
+
+            if (_fileOffset + (_index.Count * (long)sizeof(long)) <= _capacity)
+            {
+                indexOffset = _fileOffset;
+
+                foreach (long recordOffset in _index)
+                {
+                    _view.Write(fileLength, recordOffset);
+                    fileLength += sizeof(long);
+                }
+            }
+
+            WriteFileHeader(indexOffset);
+
+            _view.Flush();
+            _view.Dispose();
+            _file.Dispose();
+            _flushSignal.Dispose();
+
+            using var stream = new FileStream(FilePath, FileMode.Open, FileAccess.Write, FileShare.None);
+            stream.SetLength(fileLength);
+        }
+
+        internal static ISmartCardConnection Attach(ISmartCardConnection connection)
+        {
+            DeviceTraceRecorder? recorder = Active;
+
+            return recorder is null ? connection : new RecordingSmartCardConnection(connection, recorder);
+        }
+
+        internal static IHidConnection AttachFeatureReports(IHidConnection connection)
+        {
+            DeviceTraceRecorder? recorder = Active;
+
+            return recorder is null ? connection : new RecordingHidConnection(connection, recorder, isFeatureReport: true);
+        }
+
+        internal static IHidConnection AttachIOReports(IHidConnection connection)
+        {
+            DeviceTraceRecorder? recorder = Active;
+
+            return recorder is null ? connection : new RecordingHidConnection(connection, recorder, isFeatureReport: false);
+        }
+
+        internal static ushort NextConnectionId() => (ushort)Interlocked.Increment(ref _nextConnectionId);
+
+        internal void RecordApdu(ushort connectionId, long startTimestamp, long endTimestamp, ReadOnlySpan<byte> command, ResponseApdu response)
+        {
+            byte flags = 0;
+            ReadOnlySpan<byte> responseData = response.Data.Span;
+            Span<byte> statusWord = stackalloc byte[] { response.SW1, response.SW2 };
+
+            if (Redaction == DeviceTraceRedaction.All
+                || (Redaction == DeviceTraceRedaction.SensitiveInstructions && command.Length > 1 && IsSensitiveInstruction(command[1])))
+            {
+                flags = DeviceTraceFormat.FlagRedacted;
+                command = command.Slice(0, Math.Min(RedactedCommandLength, command.Length));
+                responseData = ReadOnlySpan<byte>.Empty;
+            }
+
+            Append(DeviceTraceRecordKind.Apdu, flags, connectionId, startTimestamp, endTimestamp, command, responseData, statusWord);
+        }
+
+        internal void RecordHidReport(
+            DeviceTraceRecordKind kind,
+            bool isFeatureReport,
+            ushort connectionId,
+            long startTimestamp,
+            long endTimestamp,
+            ReadOnlySpan<byte> report)
+        {
+            // There is no instruction byte to go by: OTP slot configurations carry AES keys and CTAPHID messages carry
+            // PIN tokens, so every report is redacted unless the caller asked for everything.
+            if (Redaction == DeviceTraceRedaction.None)
+            {
+                AppendHidReport(kind, 0, connectionId, startTimestamp, endTimestamp, report);
+
+                return;
+            }
+
+            Span<byte> redacted = report.Length <= MaxStackReportLength
+                ? stackalloc byte[report.Length]
+                : new byte[report.Length];
+
+            RedactHidReport(report, redacted, isFeatureReport);
+            AppendHidReport(kind, DeviceTraceFormat.FlagRedacted, connectionId, startTimestamp, endTimestamp, redacted);
+        }
+
+        private void AppendHidReport(
+            DeviceTraceRecordKind kind,
+            byte flags,
+            ushort connectionId,
+            long startTimestamp,
+            long endTimestamp,
+            ReadOnlySpan<byte> report)
+        {
+            if (kind == DeviceTraceRecordKind.HidOutputReport)
+            {
+                Append(kind, flags, connectionId, startTimestamp, endTimestamp, report, ReadOnlySpan<byte>.Empty, ReadOnlySpan<byte>.Empty);
+            }
+            else
+            {
+                Append(kind, flags, connectionId, startTimestamp, endTimestamp, ReadOnlySpan<byte>.Empty, report, ReadOnlySpan<byte>.Empty);
+            }
+        }
+
+        // Copies only the framing of a report. The payload is zeroed rather than dropped so that the record keeps the
+        // report's length.
+        private static void RedactHidReport(ReadOnlySpan<byte> report, Span<byte> redacted, bool isFeatureReport)
+        {
+            redacted.Clear();
+
+            if (isFeatureReport)
+            {
+                if (report.Length > FeatureReportFlagOffset)
+                {
+                    redacted[FeatureReportFlagOffset] = report[FeatureReportFlagOffset];
+                }
+
+                return;
+            }
+
+            int headerLength = report.Length > CtapHidCommandOffset && (report[CtapHidCommandOffset] & 0x80) != 0
+                ? CtapHidInitHeaderLength
+                : CtapHidContinuationHeaderLength;
+
+            report.Slice(0, Math.Min(headerLength, report.Length)).CopyTo(redacted);
+        }
+
+        // VERIFY, CHANGE REFERENCE DATA and RESET RETRY COUNTER carry PINs and PUKs; 0xFE and 0xFF are PIV IMPORT KEY
+        // and SET MANAGEMENT KEY; 0x01, 0x03 and 0xA3 are OATH PUT, SET CODE and VALIDATE (and OTP slot configuration).
+        private static bool IsSensitiveInstruction(byte instruction) =>
+            instruction switch
+            {
+                0x20 => true,
+                0x24 => true,
+                0x2C => true,
+                0xFE => true,
+                0xFF => true,
+                0x01 => true,
+                0x03 => true,
+                0xA3 => true,
+                _ => false,
+            };
+
+        private void Append(
+            DeviceTraceRecordKind kind,
+            byte flags,
+            ushort connectionId,
+            long startTimestamp,
+            long endTimestamp,
+            ReadOnlySpan<byte> command,
+            ReadOnlySpan<byte> response,
+            ReadOnlySpan<byte> responseTrailer)
+        {
+            if (command.Length > ushort.MaxValue)
+            {
+                command = command.Slice(0, ushort.MaxValue);
+                flags |= DeviceTraceFormat.FlagTruncated;
+            }
+
+            if (response.Length + responseTrailer.Length > ushort.MaxValue)
+            {
+                response = response.Slice(0, ushort.MaxValue - responseTrailer.Length);
+                flags |= DeviceTraceFormat.FlagTruncated;
+            }
+
+            int responseLength = response.Length + responseTrailer.Length;
+            int length = DeviceTraceFormat.RecordHeaderSize + command.Length + responseLength;
+
+            Span<byte> header = stackalloc byte[DeviceTraceFormat.RecordHeaderSize];
+            DeviceTraceFormat.WriteRecordHeader(
+                header,
+                kind,
+                flags,
+                connectionId,
+                DeviceTraceFormat.ToMicroseconds(startTimestamp - _startTimestamp),
+                (uint)Math.Min(uint.MaxValue, DeviceTraceFormat.ToMicroseconds(endTimestamp - startTimestamp)),
+                command.Length,
+                responseLength);
+
+            bool flushSoon;
+
+            lock (_ringLock)
+            {
+                if (_disposed)
+                {
+                    return;
+                }
+
+                if (length > _ring.Length - (_ringHead - _ringTail))
+                {
+                    _droppedCount++;
+
+                    return;
+                }
+
+                long position = _ringHead;
+                WriteToRing(ref position, header);
+                WriteToRing(ref position, command);
+                WriteToRing(ref position, response);
+                WriteToRing(ref position, responseTrailer);
+                _ringHead = position;
+
+                flushSoon = _ringHead - _ringTail > _ring.Length / 2;
+            }
+
+            if (flushSoon)
+            {
+                _ = _flushSignal.Set();
+            }
+        }
+
+        private void WriteToRing(ref long position, ReadOnlySpan<byte> data)
+        {
+            int start = (int)(position % _ring.Length);
+            int first = Math.Min(data.Length, _ring.Length - start);
+
+            data.Slice(0, first).CopyTo(_ring.AsSpan(start));
+            data.Slice(first).CopyTo(_ring);
+
+            position += data.Length;
+        }
+
+        private void FlushLoop()
+        {
+            while (!_stopping)
+            {
+                _ = _flushSignal.WaitOne(FlushIntervalMilliseconds);
+                Flush();
+            }
+        }
+
+        private void Flush()
+        {
+            long head;
+            long tail;
+
+            lock (_ringLock)
+            {
+                head = _ringHead;
+                tail = _ringTail;
+            }
+
+            if (tail == head)
+            {
+                return;
+            }
+
+            long dropped = 0;
+
+            while (tail < head)
+            {
+                CopyFromRing(tail, _flushRecordHeader, _flushRecordHeader.Length);
+                int length = DeviceTraceFormat.GetRecordLength(_flushRecordHeader);
+
+                if (_fileOffset + length <= _capacity)
+                {
+                    WriteRingToFile(tail, length);
+                    _index.Add(_fileOffset);
+                    _fileOffset += length;
+                }
+                else
+                {
+                    dropped++;
+                }
+
+                tail += length;
+            }
+
+            lock (_ringLock)
+            {
+                _ringTail = tail;
+                _droppedCount += dropped;
+            }
+
+            // Keep the header current so that a trace from a process that never disposed its recorder can still be read.
+            WriteFileHeader(0);
+        }
+
+        private void CopyFromRing(long position, byte[] destination, int count)
+        {
+            int start = (int)(position % _ring.Length);
+            int first = Math.Min(count, _ring.Length - start);
+
+            Array.Copy(_ring, start, destination, 0, first);
+            Array.Copy(_ring, 0, destination, first, count - first);
+        }
+
+        private void WriteRingToFile(long position, int count)
+        {
+            int start = (int)(position % _ring.Length);
+            int first = Math.Min(count, _ring.Length - start);
+
+            _view.WriteArray(_fileOffset, _ring, start, first);
+
+            if (first < count)
+            {
+                _view.WriteArray(_fileOffset + first, _ring, 0, count - first);
+            }
+        }
+
+        private void WriteFileHeader(long indexOffset)
+        {
+            DeviceTraceFormat.WriteFileHeader(_fileHeader, _startTimeUtc, _fileOffset, _index.Count, indexOffset, DroppedCount);
+            _view.WriteArray(0, _fileHeader, 0, _fileHeader.Length);
+        }
+    }
+}
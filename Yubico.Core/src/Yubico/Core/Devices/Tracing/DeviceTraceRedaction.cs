@@ -0,0 +1,45 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+namespace Yubico.Core.Devices.Tracing
+{
+    /// <summary>
+    /// How much of each exchange a <see cref="DeviceTraceRecorder"/> keeps.
+    /// </summary>
+    /// <remarks>
+    /// A redacted APDU record keeps only the four byte command header (CLA, INS, P1, P2) and the two byte status word,
+    /// which is all that is needed to attribute latency. A redacted HID report keeps its length, but only the framing
+    /// bytes survive: the sequence and flag byte of a keyboard feature report, or the channel, command and length (or
+    /// channel and sequence number) of a CTAPHID report. Every other byte is recorded as zero.
+    /// </remarks>
+    public enum DeviceTraceRedaction
+    {
+        /// <summary>
+        /// Every byte is recorded, HID reports included. Traces recorded this way can contain PINs, keys and other
+        /// secrets.
+        /// </summary>
+        None = 0,
+
+        /// <summary>
+        /// APDUs whose instruction is known to carry PINs, PUKs, management keys, imported private keys or OATH
+        /// secrets are redacted, and so is every HID report. Other APDUs are recorded in full.
+        /// </summary>
+        SensitiveInstructions = 1,
+
+        /// <summary>
+        /// Every APDU and HID report is redacted.
+        /// </summary>
+        All = 2,
+    }
+}
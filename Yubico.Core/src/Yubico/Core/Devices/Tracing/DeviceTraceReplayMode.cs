@@ -0,0 +1,39 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+namespace Yubico.Core.Devices.Tracing
+{
+    /// <summary>
+    /// How a replay device decides which recorded exchange answers a command.
+    /// </summary>
+    public enum DeviceTraceReplayMode
+    {
+        /// <summary>
+        /// Every command must be the one recorded next in the trace, byte for byte. Use this to check that the SDK
+        /// still sends exactly what it sent when the trace was recorded.
+        /// </summary>
+        /// <remarks>
+        /// For a redacted record only the bytes that were kept are compared. CTAPHID channel IDs and INIT nonces are
+        /// never compared, as they are chosen at random.
+        /// </remarks>
+        Strict = 0,
+
+        /// <summary>
+        /// A command is answered by the next recorded exchange with the same APDU INS, P1 and P2 (or the same CTAPHID
+        /// command), skipping any in between. Use this to replay a real workload against an SDK that sends more,
+        /// fewer or different commands than the one that recorded it.
+        /// </summary>
+        Tolerant = 1,
+    }
+}
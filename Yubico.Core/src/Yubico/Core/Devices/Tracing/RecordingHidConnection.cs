@@ -0,0 +1,64 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System.Diagnostics;
+using Yubico.Core.Devices.Hid;
+
+namespace Yubico.Core.Devices.Tracing
+{
+    /// <summary>
+    /// Passes reports through to another HID connection and reports each one to a <see cref="DeviceTraceRecorder"/>.
+    /// </summary>
+    internal sealed class RecordingHidConnection : IHidConnection
+    {
+        private readonly IHidConnection _connection;
+        private readonly DeviceTraceRecorder _recorder;
+        private readonly ushort _connectionId;
+        private readonly bool _isFeatureReport;
+
+        public RecordingHidConnection(IHidConnection connection, DeviceTraceRecorder recorder, bool isFeatureReport)
+        {
+            _connection = connection;
+            _recorder = recorder;
+            _isFeatureReport = isFeatureReport;
+            _connectionId = DeviceTraceRecorder.NextConnectionId();
+        }
+
+        public int InputReportSize => _connection.InputReportSize;
+
+        public int OutputReportSize => _connection.OutputReportSize;
+
+        public void SetReport(byte[] report)
+        {
+            long startTimestamp = Stopwatch.GetTimestamp();
+            _connection.SetReport(report);
+            long endTimestamp = Stopwatch.GetTimestamp();
+
+            _recorder.RecordHidReport(DeviceTraceRecordKind.HidOutputReport, _isFeatureReport, _connectionId, startTimestamp, endTimestamp, report);
+        }
+
+        public byte[] GetReport()
+        {
+            long startTimestamp = Stopwatch.GetTimestamp();
+            byte[] report = _connection.GetReport();
+            long endTimestamp = Stopwatch.GetTimestamp();
+
+            _recorder.RecordHidReport(DeviceTraceRecordKind.HidInputReport, _isFeatureReport, _connectionId, startTimestamp, endTimestamp, report);
+
+            return report;
+        }
+
+        public void Dispose() => _connection.Dispose();
+    }
+}
@@ -0,0 +1,60 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using System.Diagnostics;
+using Yubico.Core.Devices.SmartCard;
+using Yubico.Core.Iso7816;
+
+namespace Yubico.Core.Devices.Tracing
+{
+    /// <summary>
+    /// Passes APDUs through to another smart card connection and reports each exchange to a
+    /// <see cref="DeviceTraceRecorder"/>.
+    /// </summary>
+    internal sealed class RecordingSmartCardConnection : ISmartCardConnection, ISmartCardConnectionStatus
+    {
+        private readonly ISmartCardConnection _connection;
+        private readonly DeviceTraceRecorder _recorder;
+        private readonly ushort _connectionId;
+
+        public RecordingSmartCardConnection(ISmartCardConnection connection, DeviceTraceRecorder recorder)
+        {
+            _connection = connection;
+            _recorder = recorder;
+            _connectionId = DeviceTraceRecorder.NextConnectionId();
+        }
+
+        public IDisposable BeginTransaction(out bool cardWasReset) => _connection.BeginTransaction(out cardWasReset);
+
+        public ResponseApdu Transmit(CommandApdu commandApdu)
+        {
+            long startTimestamp = Stopwatch.GetTimestamp();
+            ResponseApdu responseApdu = _connection.Transmit(commandApdu);
+            long endTimestamp = Stopwatch.GetTimestamp();
+
+            _recorder.RecordApdu(_connectionId, startTimestamp, endTimestamp, commandApdu.AsByteArray(), responseApdu);
+
+            return responseApdu;
+        }
+
+        // Recording must not change what the connection can do, so this is only as capable as the one it wraps.
+        public SmartCardConnectionStatus GetStatus() =>
+            _connection is ISmartCardConnectionStatus statusConnection
+                ? statusConnection.GetStatus()
+                : throw new NotSupportedException(ExceptionMessages.SmartCardStatusNotSupported);
+
+        public void Dispose() => _connection.Dispose();
+    }
+}
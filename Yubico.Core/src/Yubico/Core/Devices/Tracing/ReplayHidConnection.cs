@@ -0,0 +1,51 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using Yubico.Core.Devices.Hid;
+
+namespace Yubico.Core.Devices.Tracing
+{
+    internal sealed class ReplayHidConnection : IHidConnection
+    {
+        private readonly ReplayHidDevice _device;
+
+        public int InputReportSize { get; }
+
+        public int OutputReportSize { get; }
+
+        public ReplayHidConnection(ReplayHidDevice device, int reportSize)
+        {
+            _device = device;
+            InputReportSize = reportSize;
+            OutputReportSize = reportSize;
+        }
+
+        public void SetReport(byte[] report)
+        {
+            if (report is null)
+            {
+                throw new ArgumentNullException(nameof(report));
+            }
+
+            _device.SetReport(report);
+        }
+
+        public byte[] GetReport() => _device.GetReport();
+
+        public void Dispose()
+        {
+        }
+    }
+}
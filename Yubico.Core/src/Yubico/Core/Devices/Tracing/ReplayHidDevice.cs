@@ -0,0 +1,283 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.Linq;
+using Yubico.Core.Devices.Hid;
+
+namespace Yubico.Core.Devices.Tracing
+{
+    /// <summary>
+    /// A HID device that answers reports with the reports from a device trace.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// A <see cref="HidUsagePage.Fido"/> device replays the 64-byte CTAPHID reports of the trace, and a
+    /// <see cref="HidUsagePage.Keyboard"/> device replays the 8-byte OTP feature reports. All connections to the device
+    /// share one position in the trace, and replay wraps around to the first record after the last. Each report is
+    /// delayed by the time the real device took, multiplied by <see cref="TimeScale"/>.
+    /// </para>
+    /// <para>
+    /// CTAPHID channel IDs are chosen by the device, and INIT nonces by the SDK, so neither will be the same twice.
+    /// Every replayed response is sent on the channel of the most recent request, and the response to INIT echoes the
+    /// nonce the SDK sent. HID reports redacted with <see cref="DeviceTraceRedaction.All"/> cannot be replayed.
+    /// </para>
+    /// <para>
+    /// A trace records however many reports the SDK read while waiting for the device, such as CTAPHID keepalives or
+    /// OTP status polls, and a replay rarely needs exactly as many. Unread input reports are skipped; in
+    /// <see cref="DeviceTraceReplayMode.Tolerant"/> mode, reading past the recorded ones repeats the last.
+    /// </para>
+    /// </remarks>
+    public sealed class ReplayHidDevice : HidDevice
+    {
+        private const short YubicoVendorId = 0x1050;
+        private const short YubiKeyOtpFidoCcidProductId = 0x0407;
+        private const short UsageKeyboard = 6;
+        private const short UsageU2FDevice = 1;
+
+        private const int CtapHidReportSize = 64;
+        private const int KeyboardReportSize = 8;
+        private const int CtapHidChannelIdLength = 4;
+        private const int CtapHidCommandOffset = 4;
+        private const int CtapHidPayloadOffset = 7;
+        private const int CtapHidNonceLength = 8;
+        private const byte CtapHidInitializationBit = 0x80;
+        private const byte CtapHidInitCommand = 0x86;
+        private const int KeyboardSequenceOffset = 7;
+
+        private readonly object _lock = new object();
+        private readonly DeviceTraceRecord[] _records;
+        private readonly int _reportSize;
+        private readonly bool _isFido;
+        private readonly byte[] _channelId = new byte[CtapHidChannelIdLength];
+        private readonly byte[] _nonce = new byte[CtapHidNonceLength];
+        private byte[]? _lastInputReport;
+        private int _position;
+
+        /// <summary>
+        /// How reports are matched to recorded exchanges.
+        /// </summary>
+        public DeviceTraceReplayMode Mode { get; }
+
+        /// <summary>
+        /// The factor applied to recorded latencies. 1 replays at the original speed, 0 answers immediately.
+        /// </summary>
+        public double TimeScale { get; }
+
+        /// <summary>
+        /// Creates a HID device that replays the reports in <paramref name="records"/>.
+        /// </summary>
+        /// <param name="records">The trace to replay, usually a <see cref="DeviceTraceReader"/>. Only the reports of
+        /// the interface given by <paramref name="usagePage"/> are used.</param>
+        /// <param name="usagePage">Either <see cref="HidUsagePage.Fido"/> or <see cref="HidUsagePage.Keyboard"/>.</param>
+        /// <param name="mode">How reports are matched to recorded exchanges.</param>
+        /// <param name="timeScale">The factor applied to recorded latencies.</param>
+        /// <exception cref="ArgumentNullException">
+        /// <paramref name="records"/> is null.
+        /// </exception>
+        /// <exception cref="ArgumentOutOfRangeException">
+        /// <paramref name="usagePage"/> is not FIDO or keyboard, or <paramref name="timeScale"/> is negative.
+        /// </exception>
+        /// <exception cref="ArgumentException">
+        /// The trace has no reports for <paramref name="usagePage"/>.
+        /// </exception>
+        public ReplayHidDevice(
+            IEnumerable<DeviceTraceRecord> records,
+            HidUsagePage usagePage,
+            DeviceTraceReplayMode mode = DeviceTraceReplayMode.Strict,
+            double timeScale = 1.0)
+            : base("replay:hid:" + usagePage.ToString())
+        {
+            if (records is null)
+            {
+                throw new ArgumentNullException(nameof(records));
+            }
+
+            if (usagePage != HidUsagePage.Fido && usagePage != HidUsagePage.Keyboard)
+            {
+                throw new ArgumentOutOfRangeException(nameof(usagePage));
+            }
+
+            if (timeScale < 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(timeScale));
+            }
+
+            _isFido = usagePage == HidUsagePage.Fido;
+            _reportSize = _isFido ? CtapHidReportSize : KeyboardReportSize;
+            _records = records
+                .Where(r => (r.Kind == DeviceTraceRecordKind.HidOutputReport && r.Command.Length == _reportSize)
+                    || (r.Kind == DeviceTraceRecordKind.HidInputReport && r.Response.Length == _reportSize))
+                .ToArray();
+
+            if (_records.Length == 0)
+            {
+                throw new ArgumentException(ExceptionMessages.DeviceTraceReplayEmpty, nameof(records));
+            }
+
+            VendorId = YubicoVendorId;
+            ProductId = YubiKeyOtpFidoCcidProductId;
+            UsagePage = usagePage;
+            Usage = _isFido ? UsageU2FDevice : UsageKeyboard;
+            Mode = mode;
+            TimeScale = timeScale;
+        }
+
+        /// <inheritdoc/>
+        public override IHidConnection ConnectToFeatureReports() => new ReplayHidConnection(this, _reportSize);
+
+        /// <inheritdoc/>
+        public override IHidConnection ConnectToIOReports() => new ReplayHidConnection(this, _reportSize);
+
+        /// <summary>
+        /// Starts the replay over from the first record.
+        /// </summary>
+        public void Reset()
+        {
+            lock (_lock)
+            {
+                _position = 0;
+                _lastInputReport = null;
+            }
+        }
+
+        internal void SetReport(byte[] report)
+        {
+            DeviceTraceRecord record;
+
+            lock (_lock)
+            {
+                int index = FindOutputRecord(report);
+                record = _records[index];
+                _position = (index + 1) % _records.Length;
+
+                if (_isFido)
+                {
+                    report.AsSpan(0, CtapHidChannelIdLength).CopyTo(_channelId);
+
+                    if (report[CtapHidCommandOffset] == CtapHidInitCommand)
+                    {
+                        report.AsSpan(CtapHidPayloadOffset, CtapHidNonceLength).CopyTo(_nonce);
+                    }
+                }
+            }
+
+            ReplayTiming.Wait(record.Elapsed, TimeScale);
+        }
+
+        internal byte[] GetReport()
+        {
+            DeviceTraceRecord? record = null;
+            byte[] report;
+
+            lock (_lock)
+            {
+                if (_records[_position].Kind == DeviceTraceRecordKind.HidInputReport)
+                {
+                    record = _records[_position];
+                    _position = (_position + 1) % _records.Length;
+                    report = record.Response.ToArray();
+
+                    if (_isFido)
+                    {
+                        _channelId.CopyTo(report, 0);
+
+                        if (report[CtapHidCommandOffset] == CtapHidInitCommand)
+                        {
+                            _nonce.CopyTo(report, CtapHidPayloadOffset);
+                        }
+                    }
+
+                    _lastInputReport = report;
+                }
+                else if (Mode == DeviceTraceReplayMode.Tolerant && !(_lastInputReport is null))
+                {
+                    report = _lastInputReport;
+                }
+                else
+                {
+                    throw new InvalidOperationException(
+                        string.Format(CultureInfo.CurrentCulture, ExceptionMessages.DeviceTraceReplayNoInputReport, _position));
+                }
+            }
+
+            if (!(record is null))
+            {
+                ReplayTiming.Wait(record.Elapsed, TimeScale);
+            }
+
+            return (byte[])report.Clone();
+        }
+
+        private int FindOutputRecord(byte[] report)
+        {
+            for (int i = 0; i < _records.Length; i++)
+            {
+                int index = (_position + i) % _records.Length;
+                DeviceTraceRecord candidate = _records[index];
+
+                // Input reports the SDK did not read this time are skipped in either mode.
+                if (candidate.Kind != DeviceTraceRecordKind.HidOutputReport)
+                {
+                    continue;
+                }
+
+                bool matches = Mode == DeviceTraceReplayMode.Tolerant
+                    ? IsSameCommand(candidate.Command.Span, report)
+                    : IsSameReport(candidate.Command.Span, report);
+
+                if (matches)
+                {
+                    return index;
+                }
+
+                if (Mode == DeviceTraceReplayMode.Strict)
+                {
+                    throw new InvalidOperationException(
+                        string.Format(CultureInfo.CurrentCulture, ExceptionMessages.DeviceTraceReplayMismatch, index));
+                }
+            }
+
+            throw new InvalidOperationException(ExceptionMessages.DeviceTraceReplayNoMatch);
+        }
+
+        private bool IsSameReport(ReadOnlySpan<byte> recorded, ReadOnlySpan<byte> report)
+        {
+            if (!_isFido)
+            {
+                return recorded.SequenceEqual(report);
+            }
+
+            if (report.Length != CtapHidReportSize)
+            {
+                return false;
+            }
+
+            // Skip the channel ID, and for INIT the nonce.
+            int end = report[CtapHidCommandOffset] == CtapHidInitCommand ? CtapHidPayloadOffset : CtapHidReportSize;
+
+            return recorded.Slice(CtapHidCommandOffset, end - CtapHidCommandOffset)
+                .SequenceEqual(report.Slice(CtapHidCommandOffset, end - CtapHidCommandOffset));
+        }
+
+        // An initialization packet is identified by its CTAPHID command, a continuation packet by its sequence number
+        // and a keyboard report by its sequence byte.
+        private bool IsSameCommand(ReadOnlySpan<byte> recorded, ReadOnlySpan<byte> report) =>
+            _isFido
+                ? report.Length == CtapHidReportSize && recorded[CtapHidCommandOffset] == report[CtapHidCommandOffset]
+                : report.Length == KeyboardReportSize && recorded[KeyboardSequenceOffset] == report[KeyboardSequenceOffset];
+    }
+}
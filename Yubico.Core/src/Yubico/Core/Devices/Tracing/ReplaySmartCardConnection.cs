@@ -0,0 +1,63 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using Yubico.Core.Devices.SmartCard;
+using Yubico.Core.Iso7816;
+
+namespace Yubico.Core.Devices.Tracing
+{
+    internal sealed class ReplaySmartCardConnection : ISmartCardConnection, ISmartCardConnectionStatus
+    {
+        private readonly ReplaySmartCardDevice _device;
+
+        public ReplaySmartCardConnection(ReplaySmartCardDevice device)
+        {
+            _device = device;
+        }
+
+        // A replayed card is never reset by another application, so there is nothing for a transaction to protect.
+        public IDisposable BeginTransaction(out bool cardWasReset)
+        {
+            cardWasReset = false;
+
+            return new ReplayTransaction();
+        }
+
+        public ResponseApdu Transmit(CommandApdu commandApdu)
+        {
+            if (commandApdu is null)
+            {
+                throw new ArgumentNullException(nameof(commandApdu));
+            }
+
+            return _device.Transmit(commandApdu);
+        }
+
+        // A replayed card never leaves the reader, so its event count never changes.
+        public SmartCardConnectionStatus GetStatus() =>
+            new SmartCardConnectionStatus(SmartCardState.Specific, SmartCardProtocol.T1, _device.Atr, 0);
+
+        public void Dispose()
+        {
+        }
+
+        private sealed class ReplayTransaction : IDisposable
+        {
+            public void Dispose()
+            {
+            }
+        }
+    }
+}
@@ -0,0 +1,167 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.Linq;
+using Yubico.Core.Devices.SmartCard;
+using Yubico.Core.Iso7816;
+
+namespace Yubico.Core.Devices.Tracing
+{
+    /// <summary>
+    /// A smart card that answers commands with the responses from a device trace.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// This lets the whole SDK stack above <see cref="ISmartCardConnection"/> be exercised, and timed, without a
+    /// YubiKey. Each response is delayed by the time the real device took, multiplied by
+    /// <see cref="TimeScale"/>.
+    /// </para>
+    /// <para>
+    /// The APDU records of the trace are replayed in order, regardless of which connection recorded them, and all
+    /// connections to this device share one position in the trace. When the last record has been used, replay wraps
+    /// around to the first, so a trace of one iteration of a workload can drive any number of iterations.
+    /// </para>
+    /// </remarks>
+    public sealed class ReplaySmartCardDevice : SmartCardDevice
+    {
+        private const int ApduHeaderLength = 4;
+
+        private readonly object _lock = new object();
+        private readonly DeviceTraceRecord[] _records;
+        private int _position;
+
+        /// <summary>
+        /// How commands are matched to recorded exchanges.
+        /// </summary>
+        public DeviceTraceReplayMode Mode { get; }
+
+        /// <summary>
+        /// The factor applied to recorded latencies. 1 replays at the original speed, 0 answers immediately.
+        /// </summary>
+        public double TimeScale { get; }
+
+        /// <summary>
+        /// Creates a smart card that replays the APDUs in <paramref name="records"/>.
+        /// </summary>
+        /// <param name="records">The trace to replay, usually a <see cref="DeviceTraceReader"/>. Records other than
+        /// APDUs are ignored.</param>
+        /// <param name="mode">How commands are matched to recorded exchanges.</param>
+        /// <param name="timeScale">The factor applied to recorded latencies.</param>
+        /// <param name="atr">The answer to reset the device reports.</param>
+        /// <exception cref="ArgumentNullException">
+        /// <paramref name="records"/> is null.
+        /// </exception>
+        /// <exception cref="ArgumentOutOfRangeException">
+        /// <paramref name="timeScale"/> is negative.
+        /// </exception>
+        /// <exception cref="ArgumentException">
+        /// The trace has no APDUs.
+        /// </exception>
+        public ReplaySmartCardDevice(
+            IEnumerable<DeviceTraceRecord> records,
+            DeviceTraceReplayMode mode = DeviceTraceReplayMode.Strict,
+            double timeScale = 1.0,
+            AnswerToReset? atr = null)
+            : base("replay:smartcard", atr)
+        {
+            if (records is null)
+            {
+                throw new ArgumentNullException(nameof(records));
+            }
+
+            if (timeScale < 0)
+            {
+                throw new ArgumentOutOfRangeException(nameof(timeScale));
+            }
+
+            _records = records
+                .Where(r => r.Kind == DeviceTraceRecordKind.Apdu && r.Command.Length >= ApduHeaderLength)
+                .ToArray();
+
+            if (_records.Length == 0)
+            {
+                throw new ArgumentException(ExceptionMessages.DeviceTraceReplayEmpty, nameof(records));
+            }
+
+            Mode = mode;
+            TimeScale = timeScale;
+        }
+
+        /// <inheritdoc/>
+        public override ISmartCardConnection Connect() => new ReplaySmartCardConnection(this);
+
+        /// <summary>
+        /// Starts the replay over from the first record.
+        /// </summary>
+        public void Reset()
+        {
+            lock (_lock)
+            {
+                _position = 0;
+            }
+        }
+
+        internal ResponseApdu Transmit(CommandApdu commandApdu)
+        {
+            byte[] command = commandApdu.AsByteArray();
+            DeviceTraceRecord record;
+
+            lock (_lock)
+            {
+                int index = FindRecord(command);
+                record = _records[index];
+                _position = (index + 1) % _records.Length;
+            }
+
+            ReplayTiming.Wait(record.Elapsed, TimeScale);
+
+            return new ResponseApdu(record.Response.ToArray());
+        }
+
+        private int FindRecord(byte[] command)
+        {
+            if (Mode == DeviceTraceReplayMode.Strict)
+            {
+                DeviceTraceRecord expected = _records[_position];
+                bool matches = expected.IsRedacted || expected.IsTruncated
+                    ? command.AsSpan().StartsWith(expected.Command.Span)
+                    : command.AsSpan().SequenceEqual(expected.Command.Span);
+
+                if (!matches)
+                {
+                    throw new InvalidOperationException(
+                        string.Format(CultureInfo.CurrentCulture, ExceptionMessages.DeviceTraceReplayMismatch, _position));
+                }
+
+                return _position;
+            }
+
+            for (int i = 0; i < _records.Length; i++)
+            {
+                int index = (_position + i) % _records.Length;
+                ReadOnlySpan<byte> recorded = _records[index].Command.Span;
+
+                if (recorded[1] == command[1] && recorded[2] == command[2] && recorded[3] == command[3])
+                {
+                    return index;
+                }
+            }
+
+            throw new InvalidOperationException(ExceptionMessages.DeviceTraceReplayNoMatch);
+        }
+    }
+}
@@ -0,0 +1,48 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using System.Diagnostics;
+using System.Threading;
+
+namespace Yubico.Core.Devices.Tracing
+{
+    internal static class ReplayTiming
+    {
+        // Thread.Sleep is only good to a millisecond or so, which is the same order as many APDUs. Sleep for most of
+        // the delay and spin for the rest.
+        private static readonly long SpinThreshold = Stopwatch.Frequency / 500;
+
+        public static void Wait(TimeSpan recordedElapsed, double timeScale)
+        {
+            if (timeScale <= 0 || recordedElapsed <= TimeSpan.Zero)
+            {
+                return;
+            }
+
+            long delay = (long)(recordedElapsed.TotalSeconds * timeScale * Stopwatch.Frequency);
+            long deadline = Stopwatch.GetTimestamp() + delay;
+
+            if (delay > SpinThreshold)
+            {
+                Thread.Sleep(TimeSpan.FromSeconds((double)(delay - SpinThreshold) / Stopwatch.Frequency));
+            }
+
+            while (Stopwatch.GetTimestamp() < deadline)
+            {
+                Thread.SpinWait(20);
+            }
+        }
+    }
+}
@@ -26,6 +26,8 @@ namespace Yubico.Core.Iso7816
             _bytes = bytes.ToArray();
         }
 
+        internal ReadOnlySpan<byte> AsSpan() => _bytes;
+
         public override bool Equals(object? obj) => obj switch
         {
             AnswerToReset atr => this == atr,
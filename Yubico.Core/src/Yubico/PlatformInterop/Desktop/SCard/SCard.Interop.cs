@@ -13,6 +13,7 @@
 // limitations under the License.
 
 using System;
+using System.Collections.Generic;
 using System.Runtime.InteropServices;
 using Yubico.Core;
 using Yubico.Core.Buffers;
@@ -31,15 +32,32 @@ namespace Yubico.PlatformInterop
 
         [DllImport(Libraries.NativeShims, EntryPoint = "Native_SCardConnect", ExactSpelling = true, CharSet = CharSet.Ansi)]
         [DefaultDllImportSearchPaths(DllImportSearchPath.SafeDirectories)]
-        public static extern uint SCardConnect(
+        private static extern uint SCardConnect(
             SCardContext context,
-            string readerName,
+            IntPtr readerName,
             SCARD_SHARE shareMode,
             SCARD_PROTOCOL preferredProtocols,
             out SCardCardHandle cardHandle,
             out SCARD_PROTOCOL activeProtocol
             );
 
+        // The reader name is passed as the NUL-terminated copy kept by SCardReaderNames rather than marshaled anew.
+        public static uint SCardConnect(
+            SCardContext context,
+            string readerName,
+            SCARD_SHARE shareMode,
+            SCARD_PROTOCOL preferredProtocols,
+            out SCardCardHandle cardHandle,
+            out SCARD_PROTOCOL activeProtocol
+            ) =>
+            SCardConnect(
+                context,
+                SCardReaderNames.GetNativeName(SCardReaderNames.Intern(readerName)),
+                shareMode,
+                preferredProtocols,
+                out cardHandle,
+                out activeProtocol);
+
         [DllImport(Libraries.NativeShims, EntryPoint = "Native_SCardDisconnect", ExactSpelling = true, CharSet = CharSet.Ansi)]
         [DefaultDllImportSearchPaths(DllImportSearchPath.SafeDirectories)]
         public static extern uint SCardDisconnect(
@@ -63,13 +81,76 @@ namespace Yubico.PlatformInterop
 
         [DllImport(Libraries.NativeShims, EntryPoint = "Native_SCardGetStatusChange", ExactSpelling = true, CharSet = CharSet.Ansi)]
         [DefaultDllImportSearchPaths(DllImportSearchPath.SafeDirectories)]
-        public static extern uint SCardGetStatusChange(
+        private static extern unsafe uint SCardGetStatusChange(
             SCardContext context,
             int timeout,
-            [In, Out] SCARD_READER_STATE[] readerStates,
+            SCARD_READER_STATE* readerStates,
             int readerStatesCount
             );
 
+        // SCARD_READER_STATE is blittable, so the states are pinned and updated in place by the shim.
+        public static unsafe uint SCardGetStatusChange(
+            SCardContext context,
+            int timeout,
+            SCARD_READER_STATE[] readerStates,
+            int readerStatesCount
+            )
+        {
+            fixed (SCARD_READER_STATE* states = readerStates)
+            {
+                return SCardGetStatusChange(context, timeout, states, readerStatesCount);
+            }
+        }
+
+        // Like SCardGetStatusChange, but the shim only waits on the readers whose names match one of the patterns and
+        // reports readers holding a card that matches none of the ATR prefixes as empty. The patterns are an ANSI
+        // multi-string, and each ATR prefix is a length byte followed by that many bytes. Either may be null.
+        [DllImport(Libraries.NativeShims, EntryPoint = "Native_SCardGetStatusChangeFiltered", ExactSpelling = true, CharSet = CharSet.Ansi)]
+        [DefaultDllImportSearchPaths(DllImportSearchPath.SafeDirectories)]
+        private static extern unsafe uint SCardGetStatusChangeFiltered(
+            SCardContext context,
+            int timeout,
+            SCARD_READER_STATE* readerStates,
+            int readerStatesCount,
+            byte* readerNamePatterns,
+            byte* atrPrefixes,
+            int atrPrefixesLength
+            );
+
+        public static unsafe uint SCardGetStatusChangeFiltered(
+            SCardContext context,
+            int timeout,
+            SCARD_READER_STATE[] readerStates,
+            int readerStatesCount,
+            byte[]? readerNamePatterns,
+            byte[]? atrPrefixes,
+            int atrPrefixesLength
+            )
+        {
+            fixed (SCARD_READER_STATE* states = readerStates)
+            fixed (byte* patterns = readerNamePatterns)
+            fixed (byte* prefixes = atrPrefixes)
+            {
+                return SCardGetStatusChangeFiltered(
+                    context,
+                    timeout,
+                    states,
+                    readerStatesCount,
+                    patterns,
+                    prefixes,
+                    atrPrefixesLength);
+            }
+        }
+
+
+        // Switches the shim to the PC/SC library at libraryPath, or back to the default one if it is null. Only
+        // supported where the shim opens PC/SC at run time (Linux); elsewhere it returns SCARD_E_UNSUPPORTED_FEATURE.
+        [DllImport(Libraries.NativeShims, EntryPoint = "Native_SCardSelectBackend", ExactSpelling = true, CharSet = CharSet.Ansi)]
+        [DefaultDllImportSearchPaths(DllImportSearchPath.SafeDirectories)]
+        public static extern uint SCardSelectBackend(
+            string? libraryPath
+            );
+
 
         [DllImport(Libraries.NativeShims, EntryPoint = "Native_SCardListReaders", ExactSpelling = true, CharSet = CharSet.Ansi)]
         [DefaultDllImportSearchPaths(DllImportSearchPath.SafeDirectories)]
@@ -80,12 +161,26 @@ namespace Yubico.PlatformInterop
             ref int readerNamesLength
             );
 
+        // Each thread keeps the buffer from its last SCardListReaders call, so that listing the readers normally
+        // takes a single native call and no allocation. The buffer only grows when PC/SC reports that it is too small.
+        [ThreadStatic]
+        private static byte[]? _readerNamesBuffer;
+
+        private const int InitialReaderNamesLength = 1024;
+        private const int MaxListReadersAttempts = 4;
+
+        /// <summary>
+        /// Lists the readers as IDs from <see cref="SCardReaderNames"/>.
+        /// </summary>
+        /// <param name="context">The resource manager context.</param>
+        /// <param name="groups">The reader groups to list, or null for all readers.</param>
+        /// <param name="readerIds">Receives the reader IDs. It is cleared first.</param>
         public static uint SCardListReaders(
             SCardContext context,
             string[]? groups,
-            out string[] readerNames)
+            List<int> readerIds)
         {
-            readerNames = Array.Empty<string>();
+            readerIds.Clear();
 
             byte[]? rawGroups = null;
 
@@ -94,13 +189,22 @@ namespace Yubico.PlatformInterop
                 rawGroups = MultiString.GetBytes(groups, System.Text.Encoding.ASCII);
             }
 
-            int readerNamesLength = 0;
+            byte[] buffer = _readerNamesBuffer ??= new byte[InitialReaderNamesLength];
+            int readerNamesLength = buffer.Length;
 
-            uint result = SCardListReaders(
-                context,
-                rawGroups,
-                null,
-                ref readerNamesLength);
+            uint result = SCardListReaders(context, rawGroups, buffer, ref readerNamesLength);
+
+            // The reader list can grow between the calls, so allow a few attempts.
+            for (int attempt = 1;
+                result == ErrorCode.SCARD_E_INSUFFICIENT_BUFFER && attempt < MaxListReadersAttempts;
+                attempt++)
+            {
+                buffer = new byte[Math.Max(readerNamesLength, buffer.Length * 2)];
+                _readerNamesBuffer = buffer;
+                readerNamesLength = buffer.Length;
+
+                result = SCardListReaders(context, rawGroups, buffer, ref readerNamesLength);
+            }
 
             if (result == ErrorCode.SCARD_S_SUCCESS)
             {
@@ -109,15 +213,7 @@ namespace Yubico.PlatformInterop
                     throw new PlatformApiException(ExceptionMessages.SCardListReadersUnexpectedLength);
                 }
 
-                byte[] rawReaderNames = new byte[readerNamesLength];
-
-                result = SCardListReaders(
-                    context,
-                    rawGroups,
-                    rawReaderNames,
-                    ref readerNamesLength);
-
-                readerNames = MultiString.GetStrings(rawReaderNames, System.Text.Encoding.ASCII);
+                SCardReaderNames.ParseMultiString(buffer.AsSpan(0, Math.Min(readerNamesLength, buffer.Length)), readerIds);
             }
 
             return result;
@@ -176,5 +272,58 @@ namespace Yubico.PlatformInterop
                 return result;
             }
         }
+
+        // Reads the state of the card behind a handle without sending it anything. The shim reports the state as an
+        // SCARD_STATUS value on every platform, converting from pcsc-lite's bit mask where needed.
+        [DllImport(Libraries.NativeShims, EntryPoint = "Native_SCardStatus", ExactSpelling = true, CharSet = CharSet.Ansi)]
+        [DefaultDllImportSearchPaths(DllImportSearchPath.SafeDirectories)]
+        private static extern unsafe uint SCardStatus(
+            SCardCardHandle cardHandle,
+            out SCARD_STATUS state,
+            out SCARD_PROTOCOL protocol,
+            byte* atr,
+            ref int atrLength
+            );
+
+        public static unsafe uint SCardStatus(
+            SCardCardHandle cardHandle,
+            out SCARD_STATUS state,
+            out SCARD_PROTOCOL protocol,
+            Span<byte> atr,
+            out int atrLength
+            )
+        {
+            fixed (byte* atrPtr = atr)
+            {
+                atrLength = atr.Length;
+
+                return SCardStatus(cardHandle, out state, out protocol, atrPtr, ref atrLength);
+            }
+        }
+
+        [DllImport(Libraries.NativeShims, EntryPoint = "Native_SCardGetAttrib", ExactSpelling = true, CharSet = CharSet.Ansi)]
+        [DefaultDllImportSearchPaths(DllImportSearchPath.SafeDirectories)]
+        private static extern unsafe uint SCardGetAttrib(
+            SCardCardHandle cardHandle,
+            int attributeId,
+            byte* attribute,
+            ref int attributeLength
+            );
+
+        // Reads one of the reader driver's SCARD_ATTR_* attributes. Passing an empty buffer returns the length needed.
+        public static unsafe uint SCardGetAttrib(
+            SCardCardHandle cardHandle,
+            int attributeId,
+            Span<byte> attribute,
+            out int attributeLength
+            )
+        {
+            fixed (byte* attributePtr = attribute)
+            {
+                attributeLength = attribute.Length;
+
+                return SCardGetAttrib(cardHandle, attributeId, attributePtr, ref attributeLength);
+            }
+        }
     }
 }
@@ -23,6 +23,11 @@ namespace Yubico.PlatformInterop
     /// </summary>
     internal class SCardContext : SafeHandleZeroOrMinusOneIsInvalid
     {
+        /// <summary>
+        /// The <see cref="SCardContextPool"/> generation this context was established in.
+        /// </summary>
+        public int Generation { get; set; }
+
         public SCardContext() :
             base(true)
         {
@@ -0,0 +1,275 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using System.Collections.Generic;
+using System.Threading;
+
+using static Yubico.PlatformInterop.NativeMethods;
+
+namespace Yubico.PlatformInterop
+{
+    /// <summary>
+    /// A pool of established PC/SC contexts.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Establishing a context is a round trip to the smart card service, so instead of establishing one per connection
+    /// and releasing it when the connection closes, connections rent a context and return it when they are done. A
+    /// rented context belongs to one caller until it is returned, because PC/SC serializes the calls made on a single
+    /// context, and sharing one between connections would serialize unrelated readers.
+    /// </para>
+    /// <para>
+    /// Idle contexts are kept on a small stack, so the most recently returned one is handed out next. Contexts returned
+    /// while the stack is full are released.
+    /// </para>
+    /// <para>
+    /// <see cref="Clear"/> releases every idle context. Contexts that are rented out at the time are released when
+    /// they are returned, so nothing established before the last <see cref="Clear"/> is ever handed out again.
+    /// </para>
+    /// <para>
+    /// <see cref="SwitchProvider"/> does the same around a change of PC/SC provider. The idle contexts are released
+    /// while the old provider is still in place, and nothing can be rented or established until the switch is over.
+    /// Contexts that were rented out at the time belong to a provider that is gone, so they are abandoned when they
+    /// come back instead of being released through the new one.
+    /// </para>
+    /// </remarks>
+    internal sealed class SCardContextPool
+    {
+        /// <summary>
+        /// Establishes a new context.
+        /// </summary>
+        /// <returns>The result of <c>SCardEstablishContext</c>.</returns>
+        public delegate uint EstablishContextHandler(out SCardContext context);
+
+        private const int DefaultMaxIdleContexts = 16;
+
+        private readonly object _syncRoot = new object();
+        private readonly Stack<SCardContext> _idleContexts = new Stack<SCardContext>();
+        private readonly EstablishContextHandler _establishContext;
+        private readonly int _maxIdleContexts;
+        private int _generation;
+        private int _providerGeneration;
+        private int _establishing;
+        private bool _switching;
+
+        /// <summary>
+        /// The pool used by every smart card device and connection in the process.
+        /// </summary>
+        public static SCardContextPool Shared { get; } = new SCardContextPool(
+            (out SCardContext context) => SCardEstablishContext(SCARD_SCOPE.USER, out context),
+            DefaultMaxIdleContexts);
+
+        /// <summary>
+        /// Constructs a pool that establishes its contexts with <paramref name="establishContext"/> and keeps at most
+        /// <paramref name="maxIdleContexts"/> of them idle.
+        /// </summary>
+        public SCardContextPool(EstablishContextHandler establishContext, int maxIdleContexts)
+        {
+            _establishContext = establishContext;
+            _maxIdleContexts = maxIdleContexts;
+        }
+
+        /// <summary>
+        /// Rents an idle context, if there is one.
+        /// </summary>
+        /// <returns>
+        /// The rented context, or null if none is idle, in which case call <see cref="Establish"/>. Give the context
+        /// back with <see cref="Return"/>, or dispose it if it can no longer be used.
+        /// </returns>
+        public SCardContext? TryRent()
+        {
+            lock (_syncRoot)
+            {
+                WaitForSwitch();
+
+                while (_idleContexts.Count > 0)
+                {
+                    SCardContext candidate = _idleContexts.Pop();
+
+                    if (!candidate.IsClosed)
+                    {
+                        return candidate;
+                    }
+                }
+            }
+
+            return null;
+        }
+
+        /// <summary>
+        /// Establishes a new context that belongs to the pool.
+        /// </summary>
+        /// <param name="context">
+        /// The new context. Give it back with <see cref="Return"/>, or dispose it if it can no longer be used.
+        /// </param>
+        /// <returns>The result of <c>SCardEstablishContext</c>.</returns>
+        public uint Establish(out SCardContext context)
+        {
+            int generation;
+
+            lock (_syncRoot)
+            {
+                WaitForSwitch();
+                _establishing++;
+                generation = _generation;
+            }
+
+            try
+            {
+                uint result = _establishContext(out context);
+                context.Generation = generation;
+
+                return result;
+            }
+            finally
+            {
+                lock (_syncRoot)
+                {
+                    if (--_establishing == 0)
+                    {
+                        Monitor.PulseAll(_syncRoot);
+                    }
+                }
+            }
+        }
+
+        /// <summary>
+        /// Gives a rented context back to the pool. The caller must not use it afterwards.
+        /// </summary>
+        public void Return(SCardContext context)
+        {
+            bool abandon;
+
+            lock (_syncRoot)
+            {
+                WaitForSwitch();
+
+                abandon = context.Generation < _providerGeneration;
+
+                if (!abandon
+                    && !context.IsInvalid
+                    && !context.IsClosed
+                    && context.Generation == _generation
+                    && _idleContexts.Count < _maxIdleContexts)
+                {
+                    _idleContexts.Push(context);
+                    return;
+                }
+            }
+
+            if (abandon)
+            {
+                // Releasing it through the new provider would release whatever that provider has under the same value.
+                context.SetHandleAsInvalid();
+            }
+
+            context.Dispose();
+        }
+
+        /// <summary>
+        /// Releases every idle context, and keeps contexts that are currently rented out from being pooled again.
+        /// </summary>
+        /// <remarks>
+        /// Called when the contexts can no longer be trusted, such as after the smart card service has restarted or a
+        /// different PC/SC provider has been selected.
+        /// </remarks>
+        public void Clear()
+        {
+            SCardContext[] idleContexts;
+
+            lock (_syncRoot)
+            {
+                _generation++;
+                idleContexts = _idleContexts.ToArray();
+                _idleContexts.Clear();
+            }
+
+            foreach (SCardContext context in idleContexts)
+            {
+                context.Dispose();
+            }
+        }
+
+        /// <summary>
+        /// Releases every idle context, then runs <paramref name="selectProvider"/> while no context can be rented or
+        /// established.
+        /// </summary>
+        /// <param name="selectProvider">Switches the native shim to another PC/SC provider.</param>
+        /// <returns>The result of <paramref name="selectProvider"/>.</returns>
+        public uint SwitchProvider(Func<uint> selectProvider)
+        {
+            SCardContext[] idleContexts;
+            uint result = ErrorCode.SCARD_F_UNKNOWN_ERROR;
+
+            lock (_syncRoot)
+            {
+                WaitForSwitch();
+                _switching = true;
+
+                while (_establishing > 0)
+                {
+                    _ = Monitor.Wait(_syncRoot);
+                }
+
+                _generation++;
+                idleContexts = _idleContexts.ToArray();
+                _idleContexts.Clear();
+            }
+
+            try
+            {
+                foreach (SCardContext context in idleContexts)
+                {
+                    context.Dispose();
+                }
+
+                result = selectProvider();
+
+                return result;
+            }
+            finally
+            {
+                lock (_syncRoot)
+                {
+                    if (result == ErrorCode.SCARD_S_SUCCESS)
+                    {
+                        _providerGeneration = _generation;
+                    }
+
+                    _switching = false;
+                    Monitor.PulseAll(_syncRoot);
+                }
+            }
+        }
+
+        // Called with _syncRoot held.
+        private void WaitForSwitch()
+        {
+            while (_switching)
+            {
+                _ = Monitor.Wait(_syncRoot);
+            }
+        }
+
+        /// <summary>
+        /// Returns true if <paramref name="result"/> means the context a call was made on is no longer usable.
+        /// </summary>
+        public static bool IsContextLost(uint result) =>
+            result == ErrorCode.SCARD_E_INVALID_HANDLE
+            || result == ErrorCode.SCARD_E_NO_SERVICE
+            || result == ErrorCode.SCARD_E_SERVICE_STOPPED;
+    }
+}
@@ -0,0 +1,177 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using System.Collections.Generic;
+using System.Runtime.InteropServices;
+using System.Text;
+
+namespace Yubico.PlatformInterop
+{
+    /// <summary>
+    /// A process-wide table of interned smart card reader names.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Each distinct reader name is given a small integer ID the first time it is seen, and keeps it for the life of
+    /// the process. Reader lists are parsed straight from the PC/SC multi-string into IDs, so a reader that is already
+    /// known costs no string allocation, and reader states can be compared by ID instead of by name. ID zero is never
+    /// assigned, so it can stand for "no ID".
+    /// </para>
+    /// <para>
+    /// Each name also has a NUL-terminated copy in unmanaged memory, which reader states point at directly so that
+    /// they can be passed to PC/SC without marshaling. Like the IDs, these copies live as long as the process.
+    /// </para>
+    /// <para>
+    /// Nothing is ever evicted, because a reader state may still point at a name's unmanaged copy. The table holds
+    /// one entry per distinct reader name the process has seen. PC/SC builds those names from the reader model and a
+    /// slot index, and reuses them when a reader is unplugged and plugged back in, so on a typical machine the table
+    /// stays at a handful of entries of a few dozen bytes each, however long the process runs.
+    /// </para>
+    /// </remarks>
+    internal static class SCardReaderNames
+    {
+        private static readonly object _syncRoot = new object();
+        private static readonly List<byte[]> _encodedNames = new List<byte[]> { Array.Empty<byte>() };
+        private static readonly List<string> _names = new List<string> { string.Empty };
+        private static readonly List<IntPtr> _nativeNames = new List<IntPtr> { IntPtr.Zero };
+
+        // The newest ID for each hash, and for each ID the next older one with the same hash (or zero). A lookup only
+        // compares bytes against the names that share its hash, and never allocates for a name that is already known.
+        private static readonly Dictionary<int, int> _idsByHash = new Dictionary<int, int>();
+        private static readonly List<int> _nextWithSameHash = new List<int> { 0 };
+
+        /// <summary>
+        /// Returns the ID of a reader name given as the ASCII bytes used by PC/SC, adding it if it is new.
+        /// </summary>
+        public static int Intern(ReadOnlySpan<byte> encodedName)
+        {
+            int hash = GetHash(encodedName);
+
+            lock (_syncRoot)
+            {
+                _ = _idsByHash.TryGetValue(hash, out int newestId);
+
+                for (int id = newestId; id != 0; id = _nextWithSameHash[id])
+                {
+                    if (encodedName.SequenceEqual(_encodedNames[id]))
+                    {
+                        return id;
+                    }
+                }
+
+                byte[] encoded = encodedName.ToArray();
+                _encodedNames.Add(encoded);
+                _names.Add(Encoding.ASCII.GetString(encoded));
+                _nativeNames.Add(AllocateNativeName(encoded));
+                _nextWithSameHash.Add(newestId);
+
+                int newId = _encodedNames.Count - 1;
+                _idsByHash[hash] = newId;
+
+                return newId;
+            }
+        }
+
+        /// <summary>
+        /// Returns the ID of a reader name, adding it if it is new.
+        /// </summary>
+        public static int Intern(string name) => Intern(Encoding.ASCII.GetBytes(name));
+
+        /// <summary>
+        /// The number of names interned so far.
+        /// </summary>
+        public static int Count
+        {
+            get
+            {
+                lock (_syncRoot)
+                {
+                    return _encodedNames.Count - 1;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Returns the reader name with the given ID.
+        /// </summary>
+        public static string GetName(int id)
+        {
+            lock (_syncRoot)
+            {
+                return _names[id];
+            }
+        }
+
+        /// <summary>
+        /// Returns the NUL-terminated, unmanaged copy of the reader name with the given ID.
+        /// </summary>
+        public static IntPtr GetNativeName(int id)
+        {
+            lock (_syncRoot)
+            {
+                return _nativeNames[id];
+            }
+        }
+
+        /// <summary>
+        /// Splits a PC/SC reader multi-string into reader IDs.
+        /// </summary>
+        /// <param name="multiString">The reader names, each terminated by a NUL, followed by an empty name.</param>
+        /// <param name="readerIds">Receives the ID of each reader, in order. It is cleared first.</param>
+        public static void ParseMultiString(ReadOnlySpan<byte> multiString, List<int> readerIds)
+        {
+            readerIds.Clear();
+
+            while (!multiString.IsEmpty)
+            {
+                int end = multiString.IndexOf((byte)0);
+                if (end < 0)
+                {
+                    end = multiString.Length;
+                }
+
+                if (end == 0)
+                {
+                    break;
+                }
+
+                readerIds.Add(Intern(multiString.Slice(0, end)));
+                multiString = multiString.Slice(Math.Min(end + 1, multiString.Length));
+            }
+        }
+
+        private static IntPtr AllocateNativeName(byte[] encodedName)
+        {
+            IntPtr nativeName = Marshal.AllocHGlobal(encodedName.Length + 1);
+            Marshal.Copy(encodedName, 0, nativeName, encodedName.Length);
+            Marshal.WriteByte(nativeName, encodedName.Length, 0);
+
+            return nativeName;
+        }
+
+        // FNV-1a. Only used to find the candidates to compare byte by byte.
+        private static int GetHash(ReadOnlySpan<byte> encodedName)
+        {
+            uint hash = 2166136261;
+
+            foreach (byte value in encodedName)
+            {
+                hash = unchecked((hash ^ value) * 16777619);
+            }
+
+            return unchecked((int)hash);
+        }
+    }
+}
@@ -21,40 +21,74 @@ using Yubico.Core.Iso7816;
 
 namespace Yubico.PlatformInterop
 {
-    [StructLayout(LayoutKind.Sequential, CharSet = CharSet.Ansi, Pack = 1)]
+    // The struct is blittable, so arrays of it are pinned and handed to the shim as they are, with no marshaling
+    // copies. The reader name points at the unmanaged copy kept by SCardReaderNames.
+    [StructLayout(LayoutKind.Sequential, Pack = 1)]
     // Justification: Fields are read/write via interop. Readonly might not have any effect there, but it may give
     // maintainers a falls impression about the true nature of these fields.
     [SuppressMessage("ReSharper", "FieldCanBeMadeReadOnly.Local")]
     [SuppressMessage("Style", "IDE0044:Add readonly modifier")]
-    internal struct SCARD_READER_STATE
+    internal unsafe struct SCARD_READER_STATE
     {
-        [MarshalAs(UnmanagedType.LPStr)]
-        private string _readerName;
+        private IntPtr _readerName;
         private IntPtr _userData;
         private uint _currentState;
         private uint _eventState;
         private uint _atrLength;
-        [MarshalAs(UnmanagedType.ByValArray, SizeConst = 36)]
-        private byte[] _answerToReset;
+        private fixed byte _answerToReset[MaxAtrLength];
 
+        private const int MaxAtrLength = 36;
         private const uint SequenceMask = 0xFFFF_0000;
         private const uint StateMask = 0x0000_FFFF;
 
         public string ReaderName
         {
-            get => _readerName;
-            set => _readerName = value;
+            get => SCardReaderNames.GetName(ReaderId);
+            set => ReaderId = SCardReaderNames.Intern(value);
+        }
+
+        // The ID of the reader in SCardReaderNames, or zero. It travels in the otherwise unused user data field, which
+        // PC/SC hands back untouched. Setting it also points the reader name at that reader.
+        public int ReaderId
+        {
+            get => _userData.ToInt32();
+            set
+            {
+                _userData = new IntPtr(value);
+                _readerName = SCardReaderNames.GetNativeName(value);
+            }
         }
 
         public SCARD_STATE CurrentState => (SCARD_STATE)(_currentState & StateMask);
         public SCARD_STATE EventState => (SCARD_STATE)(_eventState & StateMask);
         public int CurrentSequence => (int)(_currentState & SequenceMask) >> 16;
         public int EventSequence => (int)(_eventState & SequenceMask) >> 16;
-        public AnswerToReset Atr => new AnswerToReset(_answerToReset.AsSpan(0, (int)_atrLength));
+        public AnswerToReset Atr
+        {
+            get
+            {
+                fixed (byte* answerToReset = _answerToReset)
+                {
+                    return new AnswerToReset(new ReadOnlySpan<byte>(answerToReset, (int)Math.Min(_atrLength, MaxAtrLength)));
+                }
+            }
+        }
 
         public static SCARD_READER_STATE[] CreateFromReaderNames(IEnumerable<string> readerNames) =>
             readerNames.Select(r => new SCARD_READER_STATE { ReaderName = r }).ToArray();
 
+        public static SCARD_READER_STATE[] CreateFromReaderIds(IReadOnlyList<int> readerIds)
+        {
+            var readerStates = new SCARD_READER_STATE[readerIds.Count];
+
+            for (int i = 0; i < readerStates.Length; i++)
+            {
+                readerStates[i].ReaderId = readerIds[i];
+            }
+
+            return readerStates;
+        }
+
         public void AcknowledgeChanges()
         {
             _currentState = _eventState & ~(uint)SCARD_STATE.CHANGED;
@@ -104,5 +104,18 @@ namespace Yubico.PlatformInterop
             int handle,
             [MarshalAs(UnmanagedType.LPArray)]byte[] inputBuffer,
             int count);
+
+        [DllImport(Libraries.LinuxKernelLib, CharSet = CharSet.Ansi, EntryPoint = "write", SetLastError = true)]
+        [DefaultDllImportSearchPaths(DllImportSearchPath.SafeDirectories)]
+        private static extern int write(int handle, IntPtr inputBuffer, int count);
+
+        // Write every byte in inputBuffer.
+        public static unsafe int write(int handle, ReadOnlySpan<byte> inputBuffer)
+        {
+            fixed (byte* inputBufferPtr = inputBuffer)
+            {
+                return write(handle, (IntPtr)inputBufferPtr, inputBuffer.Length);
+            }
+        }
     }
 }
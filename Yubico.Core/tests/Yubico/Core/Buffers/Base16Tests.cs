@@ -43,5 +43,48 @@ namespace Yubico.Core.Buffers
             byte[] expected = new byte[] { 0xba, 0xad, 0xde, 0xad, 0xf0, 0x0d };
             Assert.True(expected.SequenceEqual(bytes));
         }
+
+        [Fact]
+        public void TestEveryByteValueRoundTrips()
+        {
+            byte[] data = Enumerable.Range(0, 256).Select(b => (byte)b).ToArray();
+            string expected = string.Concat(data.Select(b => b.ToString("X2", System.Globalization.CultureInfo.InvariantCulture)));
+
+            string encoded = Base16.EncodeBytes(data);
+
+            Assert.Equal(expected, encoded);
+            Assert.Equal(data, Base16.DecodeText(encoded));
+            Assert.Equal(data, Base16.DecodeText(encoded.ToLowerInvariant()));
+        }
+
+        [Theory]
+        [InlineData("0G")]
+        [InlineData("g0")]
+        [InlineData("0\u00e9")]
+        public void TestDecodeInvalidCharacterThrows(string encoded)
+        {
+            _ = Assert.Throws<ArgumentException>(() => Base16.DecodeText(encoded));
+        }
+
+        [Fact]
+        public void TestDerivedNonAsciiCharacterSetRoundTrips()
+        {
+            var greek = new GreekBase16();
+            byte[] data = { 0x01, 0xfe };
+
+            string encoded = greek.Encode(data);
+
+            Assert.Equal("\u03b1\u03b2\u03c0\u03bf", encoded);
+            Assert.Equal(data, greek.Decode(encoded));
+            Assert.Equal(data, greek.Decode(encoded.ToUpperInvariant()));
+            _ = Assert.Throws<ArgumentException>(() => greek.Decode("0A"));
+        }
+
+        private sealed class GreekBase16 : Base16
+        {
+            private readonly char[] _characters = "\u03b1\u03b2\u03b3\u03b4\u03b5\u03b6\u03b7\u03b8\u03b9\u03ba\u03bb\u03bc\u03bd\u03be\u03bf\u03c0".ToCharArray();
+
+            protected override Span<char> CharacterSet => _characters;
+        }
     }
 }
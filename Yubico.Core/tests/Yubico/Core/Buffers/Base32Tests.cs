@@ -93,5 +93,31 @@ namespace Yubico.Core.Buffers
         {
             _ = Assert.Throws<ArgumentNullException>(() => Base32.DecodeText(null!));
         }
+
+        [Fact]
+        public void TestEveryLengthRoundTrips()
+        {
+            var random = new Random(32);
+
+            for (int length = 0; length <= 41; length++)
+            {
+                byte[] data = new byte[length];
+                random.NextBytes(data);
+
+                string encoded = Base32.EncodeBytes(data);
+
+                Assert.Equal(Base32.GetEncodedSize(length), encoded.Length);
+                Assert.Equal(data, Base32.DecodeText(encoded));
+                Assert.Equal(data, Base32.DecodeText(encoded.ToLowerInvariant()));
+            }
+        }
+
+        [Theory]
+        [InlineData("MZXW6YT!")]
+        [InlineData("MZXW6YTBOI!=====")]
+        public void TestInvalidCharacterInAnyPositionThrows(string encoded)
+        {
+            _ = Assert.Throws<ArgumentException>(() => Base32.DecodeText(encoded));
+        }
     }
 }
@@ -0,0 +1,108 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using System.Linq;
+using System.Text;
+using Xunit;
+
+namespace Yubico.Core.Buffers
+{
+    public class Crc13239Tests
+    {
+        [Fact]
+        public void Calculate_CheckString_ReturnsKnownValue()
+        {
+            short crc = Crc13239.Calculate(Encoding.ASCII.GetBytes("123456789"));
+
+            Assert.Equal(0x6F91, (ushort)crc);
+        }
+
+        [Fact]
+        public void Calculate_EmptyBuffer_ReturnsInitialValue()
+        {
+            Assert.Equal(unchecked((short)0xFFFF), Crc13239.Calculate(ReadOnlySpan<byte>.Empty));
+        }
+
+        [Fact]
+        public void Calculate_BufferFollowedByComplementedCrc_ReturnsResidue()
+        {
+            byte[] ticket = Enumerable.Range(1, 16).Select(b => (byte)b).ToArray();
+            ushort crc = (ushort)~Crc13239.Calculate(ticket.AsSpan(0, 14));
+            ticket[14] = (byte)crc;
+            ticket[15] = (byte)(crc >> 8);
+
+            Assert.Equal(0xF0B8, (ushort)Crc13239.Calculate(ticket));
+        }
+
+        [Fact]
+        public void Calculate_EveryLength_MatchesBitwiseDefinition()
+        {
+            var random = new Random(13239);
+
+            for (int length = 0; length <= 64; length++)
+            {
+                byte[] data = new byte[length];
+                random.NextBytes(data);
+
+                Assert.Equal(CalculateBitwise(data), Crc13239.Calculate(data));
+            }
+        }
+
+        [Fact]
+        public void CalculateRecords_MatchesPerRecordCalculate()
+        {
+            const int recordLength = 16;
+            byte[] records = new byte[recordLength * 10];
+            new Random(16).NextBytes(records);
+            short[] checksums = new short[12];
+
+            int count = Crc13239.Calculate(records, recordLength, checksums);
+
+            Assert.Equal(10, count);
+            for (int i = 0; i < count; i++)
+            {
+                Assert.Equal(Crc13239.Calculate(records.AsSpan(i * recordLength, recordLength)), checksums[i]);
+            }
+        }
+
+        [Theory]
+        [InlineData(32, 0, 4)]
+        [InlineData(33, 16, 4)]
+        [InlineData(32, 16, 1)]
+        public void CalculateRecords_InvalidSizes_ThrowsArgumentException(int bufferLength, int recordLength, int checksumCount)
+        {
+            byte[] records = new byte[bufferLength];
+            short[] checksums = new short[checksumCount];
+
+            _ = Assert.Throws<ArgumentException>(() => Crc13239.Calculate(records, recordLength, checksums));
+        }
+
+        private static short CalculateBitwise(byte[] buffer)
+        {
+            ushort crc = 0xFFFF;
+
+            foreach (byte value in buffer)
+            {
+                crc ^= value;
+                for (int bit = 0; bit < 8; bit++)
+                {
+                    crc = (crc & 1) != 0 ? (ushort)((crc >> 1) ^ 0x8408) : (ushort)(crc >> 1);
+                }
+            }
+
+            return unchecked((short)crc);
+        }
+    }
+}
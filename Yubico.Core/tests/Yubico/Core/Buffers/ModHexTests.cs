@@ -43,5 +43,25 @@ namespace Yubico.Core.Buffers
             byte[] expected = new byte[] { 0xba, 0xad, 0xde, 0xad, 0xf0, 0x0d };
             Assert.True(expected.SequenceEqual(bytes));
         }
+
+        [Fact]
+        public void TestEveryByteValueRoundTrips()
+        {
+            const string modHexDigits = "cbdefghijklnrtuv";
+            byte[] data = Enumerable.Range(0, 256).Select(b => (byte)b).ToArray();
+            string expected = string.Concat(data.Select(b => $"{modHexDigits[b >> 4]}{modHexDigits[b & 0x0f]}"));
+
+            string encoded = ModHex.EncodeBytes(data);
+
+            Assert.Equal(expected, encoded);
+            Assert.Equal(data, ModHex.DecodeText(encoded));
+            Assert.Equal(data, ModHex.DecodeText(encoded.ToUpperInvariant()));
+        }
+
+        [Fact]
+        public void TestDecodeHexDigitThrows()
+        {
+            _ = Assert.Throws<ArgumentException>(() => ModHex.DecodeText("cbd0"));
+        }
     }
 }
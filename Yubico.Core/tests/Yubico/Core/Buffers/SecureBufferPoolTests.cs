@@ -0,0 +1,167 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using System.Linq;
+using Xunit;
+
+namespace Yubico.Core.Buffers
+{
+    public class SecureBufferPoolTests
+    {
+        [Fact]
+        public void Rent_ReturnsZeroedBufferOfExactLength()
+        {
+            var pool = new SecureBufferPool(1024);
+
+            using SecureBuffer buffer = pool.Rent(24);
+
+            Assert.Equal(24, buffer.Length);
+            Assert.Equal(24, buffer.Segment.Count);
+            Assert.Equal(24, buffer.Span.Length);
+            Assert.True(buffer.IsPooled);
+            Assert.True(buffer.Span.ToArray().All(b => b == 0));
+        }
+
+        [Fact]
+        public void Dispose_ZeroesBufferAndReturnsSliceToPool()
+        {
+            var pool = new SecureBufferPool(1024);
+            SecureBuffer first = pool.Rent(16);
+            ArraySegment<byte> segment = first.Segment;
+            first.Span.Fill(0xA5);
+
+            first.Dispose();
+
+            Assert.True(segment.All(b => b == 0));
+            using SecureBuffer second = pool.Rent(16);
+            Assert.NotSame(first, second);
+            Assert.Equal(segment.Offset, second.Segment.Offset);
+        }
+
+        [Fact]
+        public void Dispose_CalledTwice_ReturnsBufferOnlyOnce()
+        {
+            var pool = new SecureBufferPool(1024);
+            SecureBuffer buffer = pool.Rent(16);
+
+            buffer.Dispose();
+            buffer.Dispose();
+
+            using SecureBuffer first = pool.Rent(16);
+            using SecureBuffer second = pool.Rent(16);
+            Assert.NotEqual(first.Segment.Offset, second.Segment.Offset);
+        }
+
+        [Fact]
+        public void Rent_DifferentLength_DoesNotReuseBuffer()
+        {
+            var pool = new SecureBufferPool(1024);
+            SecureBuffer buffer = pool.Rent(16);
+            buffer.Dispose();
+
+            using SecureBuffer other = pool.Rent(32);
+
+            Assert.Equal(32, other.Length);
+            Assert.Equal(16, other.Segment.Offset);
+        }
+
+        [Fact]
+        public void Rent_BeyondPinnedBudget_ReturnsUnpooledBuffer()
+        {
+            var pool = new SecureBufferPool(32);
+            using SecureBuffer pinned = pool.Rent(32);
+
+            SecureBuffer overflow = pool.Rent(8);
+            ArraySegment<byte> segment = overflow.Segment;
+            overflow.Span.Fill(0xFF);
+            overflow.Dispose();
+
+            Assert.True(pinned.IsPooled);
+            Assert.False(overflow.IsPooled);
+            Assert.False(overflow.IsLocked);
+            Assert.True(segment.All(b => b == 0));
+        }
+
+        [Fact]
+        public void Rent_PooledBuffers_AreDisjointSlicesOfOneSlab()
+        {
+            var pool = new SecureBufferPool(1024);
+
+            using SecureBuffer first = pool.Rent(16);
+            using SecureBuffer second = pool.Rent(32);
+            first.Span.Fill(0x11);
+            second.Span.Fill(0x22);
+
+            Assert.Same(first.Segment.Array, second.Segment.Array);
+            Assert.True(first.Segment.Array!.Length >= 85000);
+            Assert.Equal(16, second.Segment.Offset);
+            Assert.True(first.Span.ToArray().All(b => b == 0x11));
+            Assert.True(second.Span.ToArray().All(b => b == 0x22));
+            Assert.Equal(first.IsLocked, second.IsLocked);
+        }
+
+        [Fact]
+        public void Contents_AfterDispose_ThrowObjectDisposedException()
+        {
+            var pool = new SecureBufferPool(1024);
+            SecureBuffer buffer = pool.Rent(16);
+
+            buffer.Dispose();
+
+            Assert.Equal(16, buffer.Length);
+            _ = Assert.Throws<ObjectDisposedException>(() => buffer.Segment);
+            _ = Assert.Throws<ObjectDisposedException>(() => buffer.Span.Length);
+            _ = Assert.Throws<ObjectDisposedException>(() => buffer.Memory);
+        }
+
+        [Fact]
+        public void Rent_AfterReturn_StaleBufferKeepsThrowing()
+        {
+            var pool = new SecureBufferPool(1024);
+            SecureBuffer stale = pool.Rent(16);
+            stale.Dispose();
+
+            using SecureBuffer again = pool.Rent(16);
+            again.Span.Fill(0x5A);
+
+            Assert.NotSame(stale, again);
+            _ = Assert.Throws<ObjectDisposedException>(() => stale.Span.Length);
+            stale.Dispose();
+            Assert.True(again.Span.ToArray().All(b => b == 0x5A));
+        }
+
+        [Fact]
+        public void Dispose_StaleBuffer_DoesNotReturnSliceTwice()
+        {
+            var pool = new SecureBufferPool(1024);
+            SecureBuffer stale = pool.Rent(16);
+            stale.Dispose();
+            using SecureBuffer again = pool.Rent(16);
+
+            stale.Dispose();
+            using SecureBuffer other = pool.Rent(16);
+
+            Assert.NotEqual(again.Segment.Offset, other.Segment.Offset);
+        }
+
+        [Fact]
+        public void Rent_NegativeLength_ThrowsArgumentOutOfRangeException()
+        {
+            var pool = new SecureBufferPool(1024);
+
+            _ = Assert.Throws<ArgumentOutOfRangeException>(() => pool.Rent(-1));
+        }
+    }
+}
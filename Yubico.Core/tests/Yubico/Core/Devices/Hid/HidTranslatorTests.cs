@@ -143,6 +143,65 @@ namespace Yubico.Core.Devices.Hid.UnitTests
             Assert.Equal(hid.SupportedCharactersString, decoded);
         }
 
+        [Theory]
+        [InlineData(KeyboardLayout.ModHex)]
+        [InlineData(KeyboardLayout.en_US)]
+        [InlineData(KeyboardLayout.de_DE)]
+        [InlineData(KeyboardLayout.fr_FR)]
+        [InlineData(KeyboardLayout.it_IT)]
+        public void SpanOverloads_MatchArrayOverloads(KeyboardLayout layout)
+        {
+            HidCodeTranslator hid = HidCodeTranslator.GetInstance(layout);
+            string supported = hid.SupportedCharactersString;
+            byte[] hidCodes = new byte[supported.Length];
+            char[] characters = new char[supported.Length];
+
+            int codeCount = hid.GetHidCodes(supported.AsSpan(), hidCodes);
+            int charCount = hid.GetCharacters(hidCodes, characters);
+
+            Assert.Equal(supported.Length, codeCount);
+            Assert.Equal(hid.GetHidCodes(supported), hidCodes);
+            Assert.Equal(supported.Length, charCount);
+            Assert.Equal(hid.GetCharacters(hidCodes), characters);
+            Assert.Equal(hid.GetString(hidCodes), hid.GetString(new ReadOnlySpan<byte>(hidCodes)));
+        }
+
+        [Fact]
+        public void GetHidCodes_DestinationTooSmall_ThrowsArgumentException()
+        {
+            HidCodeTranslator hid = HidCodeTranslator.GetInstance(KeyboardLayout.en_US);
+            byte[] hidCodes = new byte[2];
+
+            _ = Assert.Throws<ArgumentException>(() => hid.GetHidCodes("abc".AsSpan(), hidCodes));
+        }
+
+        [Fact]
+        public void GetHidCodes_UnmappedCharacter_ThrowsArgumentOutOfRangeException()
+        {
+            HidCodeTranslator hid = HidCodeTranslator.GetInstance(KeyboardLayout.ModHex);
+            byte[] hidCodes = new byte[2];
+
+            _ = Assert.Throws<ArgumentOutOfRangeException>(() => hid.GetHidCodes("c\u20ac".AsSpan(), hidCodes));
+        }
+
+        [Fact]
+        public void GetString_UnmappedHidCode_ThrowsArgumentOutOfRangeException()
+        {
+            HidCodeTranslator hid = HidCodeTranslator.GetInstance(KeyboardLayout.ModHex);
+
+            _ = Assert.Throws<ArgumentOutOfRangeException>(() => hid.GetString(new byte[] { 0x06, 0x00 }));
+        }
+
+        [Fact]
+        public void SupportedHidCodes_ReturnsIndependentCopies()
+        {
+            HidCodeTranslator hid = HidCodeTranslator.GetInstance(KeyboardLayout.en_US);
+            byte[] first = hid.SupportedHidCodes;
+            first[0] ^= 0xff;
+
+            Assert.NotEqual(first[0], hid.SupportedHidCodes[0]);
+        }
+
 #if Windows
         [Theory]
         [MemberData(nameof(GetTestData))]
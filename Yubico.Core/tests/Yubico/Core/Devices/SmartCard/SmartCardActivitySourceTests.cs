@@ -0,0 +1,57 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System.Diagnostics;
+using Xunit;
+
+namespace Yubico.Core.Devices.SmartCard.UnitTests
+{
+    public class SmartCardActivitySourceTests
+    {
+        [Fact]
+        public void SetSCardError_Listening_TagsResultAndFailsSpan()
+        {
+            using var listener = new ActivityListener
+            {
+                ShouldListenTo = source => source.Name == SmartCardActivitySource.Name,
+                Sample = (ref ActivityCreationOptions<ActivityContext> _) => ActivitySamplingResult.AllDataAndRecorded
+            };
+            ActivitySource.AddActivityListener(listener);
+
+            using Activity? activity = SmartCardActivitySource.Source.StartActivity("SCardTransmit");
+            Assert.NotNull(activity);
+
+            SmartCardActivitySource.SetSCardError(activity, 0x80100069);
+
+            Assert.Equal("80100069", activity!.GetTagItem(SmartCardActivitySource.ResultTag));
+            Assert.Equal(ActivityStatusCode.Error, activity.Status);
+        }
+
+        [Fact]
+        public void SetSCardError_NullActivity_DoesNothing()
+        {
+            SmartCardActivitySource.SetSCardError(null, 0x80100069);
+        }
+
+        [Fact]
+        public void LengthTags_DoNotReuseTheApduLengthTagNames()
+        {
+            // The "Yubico.YubiKey" spans count only the APDU data field under the yubikey.apdu.* names. The transmit
+            // spans count whole buffers, so they must not share those names.
+            Assert.DoesNotContain("yubikey.apdu", SmartCardActivitySource.SendLengthTag, System.StringComparison.Ordinal);
+            Assert.DoesNotContain("yubikey.apdu", SmartCardActivitySource.ReceiveLengthTag, System.StringComparison.Ordinal);
+        }
+    }
+}
@@ -0,0 +1,69 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using Xunit;
+using Yubico.Core.Iso7816;
+
+namespace Yubico.Core.Devices.SmartCard.UnitTests
+{
+    public class SmartCardReaderFilterTests
+    {
+        [Fact]
+        public void Constructor_NullLists_MatchesEverything()
+        {
+            var filter = new SmartCardReaderFilter(null, null);
+
+            Assert.Empty(filter.ReaderNamePatterns);
+            Assert.Empty(filter.AtrPrefixes);
+            Assert.Null(filter.EncodedReaderNamePatterns);
+            Assert.Null(filter.EncodedAtrPrefixes);
+        }
+
+        [Fact]
+        public void Constructor_Patterns_EncodesMultiString()
+        {
+            var filter = new SmartCardReaderFilter(new[] { "Yubico*", "ACS ?" }, null);
+
+            byte[] expected = { (byte)'Y', (byte)'u', (byte)'b', (byte)'i', (byte)'c', (byte)'o', (byte)'*', 0,
+                (byte)'A', (byte)'C', (byte)'S', (byte)' ', (byte)'?', 0, 0 };
+
+            Assert.Equal(expected, filter.EncodedReaderNamePatterns);
+        }
+
+        [Fact]
+        public void Constructor_AtrPrefixes_EncodesLengthPrefixedBytes()
+        {
+            var filter = new SmartCardReaderFilter(
+                null,
+                new[] { new AnswerToReset(new byte[] { 0x3B, 0xFD }), new AnswerToReset(new byte[] { 0x3B, 0x8C, 0x80 }) });
+
+            Assert.Equal(new byte[] { 2, 0x3B, 0xFD, 3, 0x3B, 0x8C, 0x80 }, filter.EncodedAtrPrefixes);
+        }
+
+        [Theory]
+        [InlineData("")]
+        [InlineData("Yubico\0")]
+        [InlineData("Yubico\u00E9*")]
+        public void Constructor_InvalidPattern_ThrowsArgumentException(string pattern) =>
+            _ = Assert.Throws<ArgumentException>(() => new SmartCardReaderFilter(new[] { pattern }, null));
+
+        [Theory]
+        [InlineData(0)]
+        [InlineData(37)]
+        public void Constructor_InvalidPrefixLength_ThrowsArgumentException(int length) =>
+            _ = Assert.Throws<ArgumentException>(
+                () => new SmartCardReaderFilter(null, new[] { new AnswerToReset(new byte[length]) }));
+    }
+}
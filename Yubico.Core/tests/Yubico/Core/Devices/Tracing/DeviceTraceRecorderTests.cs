@@ -0,0 +1,227 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using System.IO;
+using System.Linq;
+using Xunit;
+using Yubico.Core.Devices.Hid;
+using Yubico.Core.Devices.SmartCard;
+using Yubico.Core.Iso7816;
+
+namespace Yubico.Core.Devices.Tracing.UnitTests
+{
+    class FakeSmartCardConnection : ISmartCardConnection
+    {
+        public IDisposable BeginTransaction(out bool cardWasReset) => throw new NotImplementedException();
+
+        public ResponseApdu Transmit(CommandApdu commandApdu) =>
+            new ResponseApdu(new byte[] { 0x01, 0x02, 0x03, 0x90, 0x00 });
+
+        public void Dispose()
+        {
+        }
+    }
+
+    class FakeHidConnection : IHidConnection
+    {
+        private readonly byte[] _inputReport;
+
+        public FakeHidConnection(byte[] inputReport)
+        {
+            _inputReport = inputReport;
+        }
+
+        public int InputReportSize => _inputReport.Length;
+
+        public int OutputReportSize => _inputReport.Length;
+
+        public byte[] GetReport() => _inputReport;
+
+        public void SetReport(byte[] report)
+        {
+        }
+
+        public void Dispose()
+        {
+        }
+    }
+
+    public class DeviceTraceRecorderTests : IDisposable
+    {
+        private readonly string _filePath = Path.GetTempFileName();
+
+        public void Dispose() => File.Delete(_filePath);
+
+        [Fact]
+        public void Attach_NoActiveRecorder_ReturnsSameConnection()
+        {
+            var connection = new FakeSmartCardConnection();
+
+            Assert.Same(connection, DeviceTraceRecorder.Attach(connection));
+        }
+
+        [Fact]
+        public void Transmit_WhileRecording_RecordsReadableApdus()
+        {
+            using (DeviceTraceRecorder.Start(_filePath, DeviceTraceRedaction.None))
+            {
+                using ISmartCardConnection connection = DeviceTraceRecorder.Attach(new FakeSmartCardConnection());
+
+                _ = connection.Transmit(new CommandApdu { Ins = 0xCB, Data = new byte[] { 0x5C, 0x01, 0x7E } });
+                _ = connection.Transmit(new CommandApdu { Ins = 0xCB });
+                _ = connection.Transmit(new CommandApdu { Ins = 0xFD });
+            }
+
+            Assert.Null(DeviceTraceRecorder.Active);
+
+            using DeviceTraceReader reader = DeviceTraceReader.Open(_filePath);
+            DeviceTraceRecord[] records = reader.ToArray();
+
+            Assert.Equal(3, records.Length);
+            Assert.All(records, r => Assert.Equal(DeviceTraceRecordKind.Apdu, r.Kind));
+            Assert.Equal(new byte[] { 0x00, 0xCB, 0x00, 0x00, 0x03, 0x5C, 0x01, 0x7E }, records[0].Command.ToArray());
+            Assert.Equal(new byte[] { 0x01, 0x02, 0x03, 0x90, 0x00 }, records[0].Response.ToArray());
+            Assert.False(records[0].IsRedacted);
+
+            var summary = reader.SummarizeByInstruction();
+
+            Assert.Equal(2, summary.Count);
+            Assert.Equal(0xCB, summary[0].Instruction);
+            Assert.Equal(2, summary[0].Count);
+            Assert.Equal(0xFD, summary[1].Instruction);
+            Assert.Equal(1, summary[1].Count);
+        }
+
+        [Fact]
+        public void Transmit_SensitiveInstruction_KeepsOnlyHeaderAndStatusWord()
+        {
+            using (DeviceTraceRecorder.Start(_filePath))
+            {
+                using ISmartCardConnection connection = DeviceTraceRecorder.Attach(new FakeSmartCardConnection());
+
+                _ = connection.Transmit(new CommandApdu { Ins = 0x20, P2 = 0x80, Data = new byte[] { 0x31, 0x32, 0x33, 0x34 } });
+            }
+
+            using DeviceTraceReader reader = DeviceTraceReader.Open(_filePath);
+            DeviceTraceRecord record = reader.ReadRecord(0);
+
+            Assert.True(record.IsRedacted);
+            Assert.Equal(new byte[] { 0x00, 0x20, 0x00, 0x80 }, record.Command.ToArray());
+            Assert.Equal(new byte[] { 0x90, 0x00 }, record.Response.ToArray());
+        }
+
+        [Fact]
+        public void SetReport_FeatureReportDefaultRedaction_KeepsOnlySequenceByte()
+        {
+            // Seven bytes of what could be an AES key, then the sequence and flag byte.
+            byte[] secret = { 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7 };
+            byte[] report = secret.Concat(new byte[] { 0x83 }).ToArray();
+
+            using (DeviceTraceRecorder.Start(_filePath))
+            {
+                using IHidConnection connection = DeviceTraceRecorder.AttachFeatureReports(new FakeHidConnection(report));
+
+                connection.SetReport(report);
+                _ = connection.GetReport();
+            }
+
+            Assert.False(ContainsSequence(File.ReadAllBytes(_filePath), secret.AsSpan(0, 3)));
+
+            using DeviceTraceReader reader = DeviceTraceReader.Open(_filePath);
+            DeviceTraceRecord[] records = reader.ToArray();
+
+            byte[] expected = { 0, 0, 0, 0, 0, 0, 0, 0x83 };
+            Assert.Equal(2, records.Length);
+            Assert.All(records, r => Assert.True(r.IsRedacted));
+            Assert.Equal(expected, records[0].Command.ToArray());
+            Assert.Equal(expected, records[1].Response.ToArray());
+        }
+
+        [Fact]
+        public void SetReport_CtapHidReportsDefaultRedaction_KeepOnlyHeaders()
+        {
+            byte[] secret = { 0xB1, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8 };
+            byte[] initPacket = new byte[64];
+            new byte[] { 0x01, 0x02, 0x03, 0x04, 0x90, 0x00, 0x48 }.CopyTo(initPacket, 0);
+            secret.CopyTo(initPacket, 7);
+            byte[] continuationPacket = new byte[64];
+            new byte[] { 0x01, 0x02, 0x03, 0x04, 0x00 }.CopyTo(continuationPacket, 0);
+            secret.CopyTo(continuationPacket, 5);
+
+            using (DeviceTraceRecorder.Start(_filePath))
+            {
+                using IHidConnection connection = DeviceTraceRecorder.AttachIOReports(new FakeHidConnection(initPacket));
+
+                connection.SetReport(initPacket);
+                connection.SetReport(continuationPacket);
+            }
+
+            Assert.False(ContainsSequence(File.ReadAllBytes(_filePath), secret.AsSpan(0, 3)));
+
+            using DeviceTraceReader reader = DeviceTraceReader.Open(_filePath);
+            DeviceTraceRecord[] records = reader.ToArray();
+
+            Assert.Equal(2, records.Length);
+            Assert.Equal(64, records[0].Command.Length);
+            Assert.Equal(initPacket.Take(7), records[0].Command.ToArray().Take(7));
+            Assert.All(records[0].Command.ToArray().Skip(7), b => Assert.Equal((byte)0, b));
+            Assert.Equal(continuationPacket.Take(5), records[1].Command.ToArray().Take(5));
+            Assert.All(records[1].Command.ToArray().Skip(5), b => Assert.Equal((byte)0, b));
+        }
+
+        [Fact]
+        public void SetReport_NoRedaction_RecordsWholeReport()
+        {
+            byte[] report = { 0xA1, 0xA2, 0xA3, 0xA4, 0xA5, 0xA6, 0xA7, 0x83 };
+
+            using (DeviceTraceRecorder.Start(_filePath, DeviceTraceRedaction.None))
+            {
+                using IHidConnection connection = DeviceTraceRecorder.AttachFeatureReports(new FakeHidConnection(report));
+
+                connection.SetReport(report);
+            }
+
+            using DeviceTraceReader reader = DeviceTraceReader.Open(_filePath);
+            DeviceTraceRecord record = reader.ReadRecord(0);
+
+            Assert.False(record.IsRedacted);
+            Assert.Equal(report, record.Command.ToArray());
+        }
+
+        [Fact]
+        public void Start_RecorderAlreadyActive_ThrowsWithoutCreatingFile()
+        {
+            string otherPath = Path.Combine(Path.GetTempPath(), Guid.NewGuid().ToString("N"));
+
+            using (DeviceTraceRecorder.Start(_filePath))
+            {
+                _ = Assert.Throws<InvalidOperationException>(() => DeviceTraceRecorder.Start(otherPath));
+            }
+
+            Assert.False(File.Exists(otherPath));
+        }
+
+        [Fact]
+        public void Open_NotATrace_ThrowsArgumentException()
+        {
+            File.WriteAllBytes(_filePath, new byte[128]);
+
+            _ = Assert.Throws<ArgumentException>(() => DeviceTraceReader.Open(_filePath));
+        }
+
+        private static bool ContainsSequence(byte[] buffer, ReadOnlySpan<byte> sequence) =>
+            buffer.AsSpan().IndexOf(sequence) >= 0;
+    }
+}
@@ -0,0 +1,121 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using System.Linq;
+using Xunit;
+using Yubico.Core.Devices.Hid;
+using Yubico.Core.Devices.SmartCard;
+using Yubico.Core.Iso7816;
+
+namespace Yubico.Core.Devices.Tracing.UnitTests
+{
+    public class ReplayDeviceTests
+    {
+        private static DeviceTraceRecord Apdu(byte[] command, byte[] response) =>
+            new DeviceTraceRecord(DeviceTraceRecordKind.Apdu, 0, 1, TimeSpan.Zero, TimeSpan.FromMilliseconds(5), command, response);
+
+        private static DeviceTraceRecord Report(DeviceTraceRecordKind kind, byte[] report) =>
+            kind == DeviceTraceRecordKind.HidOutputReport
+                ? new DeviceTraceRecord(kind, 0, 1, TimeSpan.Zero, TimeSpan.Zero, report, ReadOnlyMemory<byte>.Empty)
+                : new DeviceTraceRecord(kind, 0, 1, TimeSpan.Zero, TimeSpan.Zero, ReadOnlyMemory<byte>.Empty, report);
+
+        private static readonly DeviceTraceRecord[] _apdus =
+        {
+            Apdu(new byte[] { 0x00, 0xA4, 0x04, 0x00, 0x02, 0xA0, 0x00 }, new byte[] { 0x90, 0x00 }),
+            Apdu(new byte[] { 0x00, 0xCB, 0x3F, 0xFF, 0x02, 0x5C, 0x00 }, new byte[] { 0x53, 0x00, 0x90, 0x00 }),
+            Apdu(new byte[] { 0x00, 0xFD, 0x00, 0x00 }, new byte[] { 0x05, 0x04, 0x03, 0x90, 0x00 }),
+        };
+
+        [Fact]
+        public void Transmit_Strict_ReplaysResponsesInOrder()
+        {
+            var device = new ReplaySmartCardDevice(_apdus, DeviceTraceReplayMode.Strict, 0);
+            using ISmartCardConnection connection = device.Connect();
+
+            ResponseApdu select = connection.Transmit(new CommandApdu { Ins = 0xA4, P1 = 0x04, Data = new byte[] { 0xA0, 0x00 } });
+            ResponseApdu getData = connection.Transmit(new CommandApdu { Ins = 0xCB, P1 = 0x3F, P2 = 0xFF, Data = new byte[] { 0x5C, 0x00 } });
+
+            Assert.Equal(SWConstants.Success, select.SW);
+            Assert.Equal(new byte[] { 0x53, 0x00 }, getData.Data.ToArray());
+        }
+
+        [Fact]
+        public void Transmit_StrictAndDifferentCommand_Throws()
+        {
+            var device = new ReplaySmartCardDevice(_apdus, DeviceTraceReplayMode.Strict, 0);
+            using ISmartCardConnection connection = device.Connect();
+
+            _ = Assert.Throws<InvalidOperationException>(() => connection.Transmit(new CommandApdu { Ins = 0xFD }));
+        }
+
+        [Fact]
+        public void Transmit_Tolerant_MatchesByInsP1P2()
+        {
+            var device = new ReplaySmartCardDevice(_apdus, DeviceTraceReplayMode.Tolerant, 0);
+            using ISmartCardConnection connection = device.Connect();
+
+            ResponseApdu version = connection.Transmit(new CommandApdu { Ins = 0xFD, Data = new byte[] { 0x01 } });
+            ResponseApdu select = connection.Transmit(new CommandApdu { Ins = 0xA4, P1 = 0x04, Data = new byte[] { 0xA0, 0x01 } });
+
+            Assert.Equal(new byte[] { 0x05, 0x04, 0x03 }, version.Data.ToArray());
+            Assert.Equal(SWConstants.Success, select.SW);
+        }
+
+        [Fact]
+        public void GetStatus_ReportsDeviceAtrWithoutConsumingTrace()
+        {
+            var atr = new AnswerToReset(new byte[] { 0x3B, 0xFD, 0x13, 0x00 });
+            var device = new ReplaySmartCardDevice(_apdus, DeviceTraceReplayMode.Strict, 0, atr);
+            using ISmartCardConnection connection = device.Connect();
+
+            SmartCardConnectionStatus status = Assert.IsAssignableFrom<ISmartCardConnectionStatus>(connection).GetStatus();
+            ResponseApdu select = connection.Transmit(new CommandApdu { Ins = 0xA4, P1 = 0x04, Data = new byte[] { 0xA0, 0x00 } });
+
+            Assert.Equal(SmartCardState.Specific, status.State);
+            Assert.Equal(atr, status.Atr);
+            Assert.Equal(SWConstants.Success, select.SW);
+        }
+
+        [Fact]
+        public void GetReport_CtapHidInit_EchoesChannelAndNonce()
+        {
+            byte[] recordedRequest = new byte[64];
+            new byte[] { 0xFF, 0xFF, 0xFF, 0xFF, 0x86, 0x00, 0x08, 1, 2, 3, 4, 5, 6, 7, 8 }.CopyTo(recordedRequest, 0);
+            byte[] recordedResponse = new byte[64];
+            new byte[] { 0xFF, 0xFF, 0xFF, 0xFF, 0x86, 0x00, 0x11, 1, 2, 3, 4, 5, 6, 7, 8, 0x12, 0x34, 0x56, 0x78 }.CopyTo(recordedResponse, 0);
+
+            var device = new ReplayHidDevice(
+                new[]
+                {
+                    Report(DeviceTraceRecordKind.HidOutputReport, recordedRequest),
+                    Report(DeviceTraceRecordKind.HidInputReport, recordedResponse),
+                },
+                HidUsagePage.Fido,
+                DeviceTraceReplayMode.Strict,
+                0);
+
+            byte[] request = (byte[])recordedRequest.Clone();
+            new byte[] { 9, 9, 9, 9, 9, 9, 9, 9 }.CopyTo(request, 7);
+
+            using IHidConnection connection = device.ConnectToIOReports();
+            connection.SetReport(request);
+            byte[] response = connection.GetReport();
+
+            Assert.Equal(request.Take(4), response.Take(4));
+            Assert.Equal(request.Skip(7).Take(8), response.Skip(7).Take(8));
+            Assert.Equal(new byte[] { 0x12, 0x34, 0x56, 0x78 }, response.Skip(15).Take(4));
+        }
+    }
+}
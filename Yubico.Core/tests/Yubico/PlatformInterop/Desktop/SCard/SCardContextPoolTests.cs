@@ -0,0 +1,232 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using System.Threading;
+using Xunit;
+
+namespace Yubico.PlatformInterop
+{
+    public class SCardContextPoolTests
+    {
+        [Fact]
+        public void TryRent_EmptyPool_ReturnsNull()
+        {
+            var pool = new SCardContextPool(EstablishFake, 4);
+
+            Assert.Null(pool.TryRent());
+        }
+
+        [Fact]
+        public void Return_ThenTryRent_ReturnsSameContext()
+        {
+            var pool = new SCardContextPool(EstablishFake, 4);
+            _ = pool.Establish(out SCardContext context);
+
+            pool.Return(context);
+
+            Assert.Same(context, pool.TryRent());
+            Assert.Null(pool.TryRent());
+        }
+
+        [Fact]
+        public void Return_PoolFull_ReleasesContext()
+        {
+            var pool = new SCardContextPool(EstablishFake, 1);
+            _ = pool.Establish(out SCardContext first);
+            _ = pool.Establish(out SCardContext second);
+
+            pool.Return(first);
+            pool.Return(second);
+
+            Assert.False(first.IsClosed);
+            Assert.True(second.IsClosed);
+        }
+
+        [Fact]
+        public void Return_InvalidContext_DisposesIt()
+        {
+            var pool = new SCardContextPool(EstablishFake, 4);
+            var context = new SCardContext();
+
+            pool.Return(context);
+
+            Assert.True(context.IsClosed);
+            Assert.Null(pool.TryRent());
+        }
+
+        [Fact]
+        public void Clear_ReleasesIdleContexts()
+        {
+            var pool = new SCardContextPool(EstablishFake, 4);
+            _ = pool.Establish(out SCardContext context);
+            pool.Return(context);
+
+            pool.Clear();
+
+            Assert.True(context.IsClosed);
+            Assert.Null(pool.TryRent());
+        }
+
+        [Fact]
+        public void Return_AfterClear_ReleasesContextInsteadOfPooling()
+        {
+            var pool = new SCardContextPool(EstablishFake, 4);
+            _ = pool.Establish(out SCardContext rented);
+
+            pool.Clear();
+            pool.Return(rented);
+
+            Assert.True(rented.IsClosed);
+            Assert.Null(pool.TryRent());
+        }
+
+        [Fact]
+        public void Establish_AfterClear_ContextIsPooled()
+        {
+            var pool = new SCardContextPool(EstablishFake, 4);
+            pool.Clear();
+            _ = pool.Establish(out SCardContext context);
+
+            pool.Return(context);
+
+            Assert.Same(context, pool.TryRent());
+        }
+
+        [Fact]
+        public void TryRent_SkipsContextsClosedWhileIdle()
+        {
+            var pool = new SCardContextPool(EstablishFake, 4);
+            _ = pool.Establish(out SCardContext first);
+            _ = pool.Establish(out SCardContext second);
+            pool.Return(first);
+            pool.Return(second);
+
+            second.Dispose();
+
+            Assert.Same(first, pool.TryRent());
+        }
+
+        [Fact]
+        public void SwitchProvider_ReleasesIdleContextsBeforeSwitching()
+        {
+            var pool = new SCardContextPool(EstablishFake, 4);
+            _ = pool.Establish(out SCardContext context);
+            pool.Return(context);
+            bool releasedFirst = false;
+
+            uint result = pool.SwitchProvider(() =>
+            {
+                releasedFirst = ((FakeSCardContext)context).Released;
+                return ErrorCode.SCARD_S_SUCCESS;
+            });
+
+            Assert.Equal(ErrorCode.SCARD_S_SUCCESS, result);
+            Assert.True(releasedFirst);
+            Assert.Null(pool.TryRent());
+        }
+
+        [Fact]
+        public void Return_AfterSwitchProvider_AbandonsContextWithoutReleasingIt()
+        {
+            var pool = new SCardContextPool(EstablishFake, 4);
+            _ = pool.Establish(out SCardContext rented);
+
+            _ = pool.SwitchProvider(() => ErrorCode.SCARD_S_SUCCESS);
+            pool.Return(rented);
+
+            Assert.True(rented.IsClosed);
+            Assert.False(((FakeSCardContext)rented).Released);
+            Assert.Null(pool.TryRent());
+        }
+
+        [Fact]
+        public void Return_AfterFailedSwitchProvider_ReleasesContext()
+        {
+            var pool = new SCardContextPool(EstablishFake, 4);
+            _ = pool.Establish(out SCardContext rented);
+
+            _ = pool.SwitchProvider(() => ErrorCode.SCARD_E_NO_SERVICE);
+            pool.Return(rented);
+
+            Assert.True(((FakeSCardContext)rented).Released);
+        }
+
+        [Fact]
+        public void Establish_DuringSwitchProvider_WaitsForSwitch()
+        {
+            var pool = new SCardContextPool(EstablishFake, 4);
+            using var switching = new ManualResetEventSlim();
+            using var finishSwitch = new ManualResetEventSlim();
+            bool established = false;
+
+            var switchThread = new Thread(() => pool.SwitchProvider(() =>
+            {
+                switching.Set();
+                finishSwitch.Wait();
+                return ErrorCode.SCARD_S_SUCCESS;
+            }));
+            switchThread.Start();
+            switching.Wait();
+
+            var establishThread = new Thread(() =>
+            {
+                _ = pool.Establish(out SCardContext _);
+                Volatile.Write(ref established, true);
+            });
+            establishThread.Start();
+
+            Assert.False(establishThread.Join(100));
+            Assert.False(Volatile.Read(ref established));
+
+            finishSwitch.Set();
+            switchThread.Join();
+            establishThread.Join();
+            Assert.True(established);
+        }
+
+        [Theory]
+        [InlineData(ErrorCode.SCARD_E_INVALID_HANDLE, true)]
+        [InlineData(ErrorCode.SCARD_E_NO_SERVICE, true)]
+        [InlineData(ErrorCode.SCARD_E_SERVICE_STOPPED, true)]
+        [InlineData(ErrorCode.SCARD_E_TIMEOUT, false)]
+        [InlineData(ErrorCode.SCARD_S_SUCCESS, false)]
+        public void IsContextLost_ReturnsExpected(uint result, bool expected) =>
+            Assert.Equal(expected, SCardContextPool.IsContextLost(result));
+
+        private static uint EstablishFake(out SCardContext context)
+        {
+            context = new FakeSCardContext();
+            return ErrorCode.SCARD_S_SUCCESS;
+        }
+
+        // Looks like an established context, but only records that it was released.
+        private sealed class FakeSCardContext : SCardContext
+        {
+            public bool Released { get; private set; }
+
+            public FakeSCardContext() :
+                base(new IntPtr(1))
+            {
+            }
+
+            protected override bool ReleaseHandle()
+            {
+                Released = true;
+                return true;
+            }
+        }
+    }
+}
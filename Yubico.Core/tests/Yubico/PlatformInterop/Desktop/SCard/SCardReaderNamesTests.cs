@@ -0,0 +1,86 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System.Collections.Generic;
+using System.Text;
+using Xunit;
+
+namespace Yubico.PlatformInterop
+{
+    public class SCardReaderNamesTests
+    {
+        [Fact]
+        public void Intern_SameName_ReturnsSameId()
+        {
+            int first = SCardReaderNames.Intern("Yubico YubiKey OTP+FIDO+CCID 00 00");
+            int second = SCardReaderNames.Intern(Encoding.ASCII.GetBytes("Yubico YubiKey OTP+FIDO+CCID 00 00"));
+
+            Assert.NotEqual(0, first);
+            Assert.Equal(first, second);
+            Assert.Equal("Yubico YubiKey OTP+FIDO+CCID 00 00", SCardReaderNames.GetName(first));
+        }
+
+        [Fact]
+        public void Intern_DifferentNames_ReturnsDifferentIds()
+        {
+            int first = SCardReaderNames.Intern("Reader A");
+            int second = SCardReaderNames.Intern("Reader B");
+
+            Assert.NotEqual(first, second);
+        }
+
+        [Fact]
+        public void Intern_KnownNames_DoesNotGrowTable()
+        {
+            var ids = new List<int>();
+            for (int i = 0; i < 64; i++)
+            {
+                ids.Add(SCardReaderNames.Intern($"Lookup Reader {i:D2}"));
+            }
+
+            int count = SCardReaderNames.Count;
+
+            for (int i = 0; i < 64; i++)
+            {
+                Assert.Equal(ids[i], SCardReaderNames.Intern(Encoding.ASCII.GetBytes($"Lookup Reader {i:D2}")));
+            }
+
+            Assert.Equal(count, SCardReaderNames.Count);
+            Assert.Equal(64, new HashSet<int>(ids).Count);
+        }
+
+        [Fact]
+        public void ParseMultiString_ReturnsIdsInOrder()
+        {
+            byte[] multiString = Encoding.ASCII.GetBytes("Reader One\0Reader Two\0\0");
+            var readerIds = new List<int> { 42 };
+
+            SCardReaderNames.ParseMultiString(multiString, readerIds);
+
+            Assert.Equal(2, readerIds.Count);
+            Assert.Equal("Reader One", SCardReaderNames.GetName(readerIds[0]));
+            Assert.Equal("Reader Two", SCardReaderNames.GetName(readerIds[1]));
+        }
+
+        [Fact]
+        public void ParseMultiString_EmptyList_ReturnsNoIds()
+        {
+            var readerIds = new List<int> { 42 };
+
+            SCardReaderNames.ParseMultiString(new byte[] { 0 }, readerIds);
+
+            Assert.Empty(readerIds);
+        }
+    }
+}
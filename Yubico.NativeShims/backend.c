@@ -0,0 +1,181 @@
+#include "backend.h"
+
+#ifdef PCSC_DYNAMIC_LOAD
+
+#include <dlfcn.h>
+#include <pthread.h>
+
+/*
+ * pcsc-lite is not linked. It, or any other library that exports the same
+ * PC/SC entry points (an emulator, or a provider that replays a recorded
+ * trace), is opened with dlopen the first time a Native_SCard* export is
+ * called. The library named by YUBICO_PCSC_LIBRARY is used if that variable
+ * is set, and Native_SCardSelectBackend can switch to another library at any
+ * time. Libraries are never closed, because a call may still be running on a
+ * table that has just been replaced.
+ */
+
+#ifdef PCSC_DEFAULT_LIBRARY
+#define DEFAULT_PCSC_LIBRARY PCSC_DEFAULT_LIBRARY
+#else
+#define DEFAULT_PCSC_LIBRARY "libpcsclite.so.1"
+#endif
+#define PCSC_LIBRARY_ENV "YUBICO_PCSC_LIBRARY"
+
+static pthread_once_t g_defaultOnce = PTHREAD_ONCE_INIT;
+static pthread_mutex_t g_selectLock = PTHREAD_MUTEX_INITIALIZER;
+static const scard_backend_t* g_backend = NULL;
+
+static int
+resolve(
+    void* library,
+    const char* szSymbol,
+    void** ppfn
+)
+{
+    *ppfn = dlsym(library, szSymbol);
+    return *ppfn != NULL;
+}
+
+static const scard_backend_t*
+load_backend(
+    const char* szLibrary
+)
+{
+    void* library = dlopen(szLibrary, RTLD_NOW | RTLD_LOCAL);
+
+    if (library == NULL)
+    {
+        return NULL;
+    }
+
+    scard_backend_t* backend = (scard_backend_t*)calloc(1, sizeof(scard_backend_t));
+
+    if (backend == NULL
+        || !resolve(library, "SCardEstablishContext", (void**)&backend->EstablishContext)
+        || !resolve(library, "SCardReleaseContext", (void**)&backend->ReleaseContext)
+        || !resolve(library, "SCardConnect", (void**)&backend->Connect)
+        || !resolve(library, "SCardReconnect", (void**)&backend->Reconnect)
+        || !resolve(library, "SCardDisconnect", (void**)&backend->Disconnect)
+        || !resolve(library, "SCardBeginTransaction", (void**)&backend->BeginTransaction)
+        || !resolve(library, "SCardEndTransaction", (void**)&backend->EndTransaction)
+        || !resolve(library, "SCardGetStatusChange", (void**)&backend->GetStatusChange)
+        || !resolve(library, "SCardTransmit", (void**)&backend->Transmit)
+        || !resolve(library, "SCardListReaders", (void**)&backend->ListReaders)
+        || !resolve(library, "SCardCancel", (void**)&backend->Cancel)
+        || !resolve(library, "SCardStatus", (void**)&backend->Status)
+        || !resolve(library, "SCardGetAttrib", (void**)&backend->GetAttrib))
+    {
+        free(backend);
+        dlclose(library);
+        return NULL;
+    }
+
+    return backend;
+}
+
+static void
+load_default_backend(void)
+{
+    const char* szLibrary = getenv(PCSC_LIBRARY_ENV);
+
+    if (szLibrary == NULL || *szLibrary == '\0')
+    {
+        szLibrary = DEFAULT_PCSC_LIBRARY;
+    }
+
+    const scard_backend_t* backend = load_backend(szLibrary);
+
+    pthread_mutex_lock(&g_selectLock);
+
+    // A provider selected explicitly while this was loading wins.
+    if (backend != NULL && __atomic_load_n(&g_backend, __ATOMIC_ACQUIRE) == NULL)
+    {
+        __atomic_store_n(&g_backend, backend, __ATOMIC_RELEASE);
+    }
+
+    pthread_mutex_unlock(&g_selectLock);
+}
+
+const scard_backend_t*
+scard_backend(void)
+{
+    const scard_backend_t* backend = __atomic_load_n(&g_backend, __ATOMIC_ACQUIRE);
+
+    if (backend == NULL)
+    {
+        pthread_once(&g_defaultOnce, load_default_backend);
+        backend = __atomic_load_n(&g_backend, __ATOMIC_ACQUIRE);
+    }
+
+    return backend;
+}
+
+/*
+ * Switches every later Native_SCard* call to the PC/SC provider in
+ * szLibrary, or to the default provider if szLibrary is NULL or empty.
+ * Contexts and card handles from the previous provider must not be used
+ * afterwards. Returns SCARD_E_NO_SERVICE if the library cannot be opened or
+ * lacks one of the entry points.
+ */
+int32_t
+NATIVEAPI
+Native_SCardSelectBackend(
+    const u8str_t szLibrary
+)
+{
+    const scard_backend_t* backend = load_backend(
+        szLibrary == NULL || *szLibrary == '\0' ? DEFAULT_PCSC_LIBRARY : szLibrary);
+
+    if (backend == NULL)
+    {
+        return SCARD_E_NO_SERVICE;
+    }
+
+    pthread_mutex_lock(&g_selectLock);
+    __atomic_store_n(&g_backend, backend, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&g_selectLock);
+
+    return SCARD_S_SUCCESS;
+}
+
+#else
+
+/*
+ * On Windows and macOS the platform's PC/SC library is always present, so
+ * it is linked and the table points straight at it.
+ */
+static const scard_backend_t g_linkedBackend =
+{
+    SCardEstablishContext,
+    SCardReleaseContext,
+    SCardConnect,
+    SCardReconnect,
+    SCardDisconnect,
+    SCardBeginTransaction,
+    SCardEndTransaction,
+    SCardGetStatusChange,
+    SCardTransmit,
+    SCardListReaders,
+    SCardCancel,
+    SCardStatus,
+    SCardGetAttrib
+};
+
+const scard_backend_t*
+scard_backend(void)
+{
+    return &g_linkedBackend;
+}
+
+int32_t
+NATIVEAPI
+Native_SCardSelectBackend(
+    const u8str_t szLibrary
+)
+{
+    (void)szLibrary;
+    return SCARD_E_UNSUPPORTED_FEATURE;
+}
+
+#endif
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "native_abi.h"
+
+#ifdef BACKEND_PCSC
+#ifdef HAVE_PCSC_WINSCARD_H
+# include <PCSC/wintypes.h>
+# include <PCSC/winscard.h>
+#else
+# include <winscard.h>
+#endif
+#endif
+
+#ifdef PLATFORM_WINDOWS
+# define PCSC_CALL WINAPI
+#else
+# define PCSC_CALL
+#endif
+
+/*
+ * The PC/SC entry points used by the shim. Every Native_SCard* export calls
+ * through this table rather than through the linked symbols, so that the
+ * provider can be chosen at run time.
+ */
+typedef struct
+{
+    LONG (PCSC_CALL* EstablishContext)(DWORD, LPCVOID, LPCVOID, LPSCARDCONTEXT);
+    LONG (PCSC_CALL* ReleaseContext)(SCARDCONTEXT);
+    LONG (PCSC_CALL* Connect)(SCARDCONTEXT, LPCSTR, DWORD, DWORD, LPSCARDHANDLE, LPDWORD);
+    LONG (PCSC_CALL* Reconnect)(SCARDHANDLE, DWORD, DWORD, DWORD, LPDWORD);
+    LONG (PCSC_CALL* Disconnect)(SCARDHANDLE, DWORD);
+    LONG (PCSC_CALL* BeginTransaction)(SCARDHANDLE);
+    LONG (PCSC_CALL* EndTransaction)(SCARDHANDLE, DWORD);
+    LONG (PCSC_CALL* GetStatusChange)(SCARDCONTEXT, DWORD, SCARD_READERSTATE*, DWORD);
+    LONG (PCSC_CALL* Transmit)(SCARDHANDLE, const SCARD_IO_REQUEST*, LPCBYTE, DWORD, SCARD_IO_REQUEST*, LPBYTE, LPDWORD);
+    LONG (PCSC_CALL* ListReaders)(SCARDCONTEXT, LPCSTR, LPSTR, LPDWORD);
+    LONG (PCSC_CALL* Cancel)(SCARDCONTEXT);
+    LONG (PCSC_CALL* Status)(SCARDHANDLE, LPSTR, LPDWORD, LPDWORD, LPDWORD, LPBYTE, LPDWORD);
+    LONG (PCSC_CALL* GetAttrib)(SCARDHANDLE, DWORD, LPBYTE, LPDWORD);
+} scard_backend_t;
+
+/*
+ * Returns the active PC/SC provider, loading the default one on first use.
+ * Returns NULL if no provider could be loaded, in which case callers report
+ * SCARD_E_NO_SERVICE.
+ */
+const scard_backend_t*
+scard_backend(void);
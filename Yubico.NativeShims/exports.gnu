@@ -8,9 +8,14 @@
         Native_SCardBeginTransaction;
         Native_SCardEndTransaction;
         Native_SCardGetStatusChange;
+        Native_SCardGetStatusChangeFiltered;
         Native_SCardTransmit;
         Native_SCardListReaders;
         Native_SCardCancel;
+        Native_SCardStatus;
+        Native_SCardGetAttrib;
+        Native_SCardSelectBackend;
+        Native_LockMemory;
     local:
         *;
 };
\ No newline at end of file
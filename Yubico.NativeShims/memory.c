@@ -0,0 +1,36 @@
+#include "native_abi.h"
+#include "Yubico.NativeShims.h"
+
+#ifdef PLATFORM_WINDOWS
+# include <windows.h>
+#else
+# include <errno.h>
+# include <sys/mman.h>
+#endif
+
+/*
+ * Locks the pages spanning [pvAddress, pvAddress + cbLength) into physical
+ * memory so that they are never written to swap. Returns 0 on success, or
+ * the platform error code (errno or GetLastError) on failure.
+ */
+int32_t
+NATIVEAPI
+Native_LockMemory(
+    void* pvAddress,
+    size_t cbLength
+)
+{
+#ifdef PLATFORM_WINDOWS
+    if (!VirtualLock(pvAddress, cbLength))
+    {
+        return (int32_t)GetLastError();
+    }
+#else
+    if (mlock(pvAddress, cbLength) != 0)
+    {
+        return errno;
+    }
+#endif
+
+    return 0;
+}
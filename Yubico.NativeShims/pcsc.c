@@ -1,17 +1,16 @@
 #include "native_abi.h"
 #include "Yubico.NativeShims.h"
+#include "backend.h"
 
-#ifdef BACKEND_PCSC
-#ifdef HAVE_PCSC_WINSCARD_H
-# include <PCSC/wintypes.h>
-# include <PCSC/winscard.h>
+#include <stdio.h>
+#include <ctype.h>
+
+#ifdef PLATFORM_WINDOWS
+# include <windows.h>
 #else
-# include <winscard.h>
-#endif
+# include <time.h>
 #endif
 
-#include <stdio.h>
-
 #pragma pack(1)
 
 typedef struct
@@ -33,7 +32,14 @@ Native_SCardEstablishContext(
     LPSCARDCONTEXT phContext
 )
 {
-    return SCardEstablishContext(
+    const scard_backend_t* backend = scard_backend();
+
+    if (backend == NULL)
+    {
+        return SCARD_E_NO_SERVICE;
+    }
+
+    return backend->EstablishContext(
         dwScope,
         NULL,
         NULL,
@@ -47,7 +53,14 @@ Native_SCardReleaseContext(
     SCARDCONTEXT hContext
 )
 {
-    return SCardReleaseContext(hContext);
+    const scard_backend_t* backend = scard_backend();
+
+    if (backend == NULL)
+    {
+        return SCARD_E_NO_SERVICE;
+    }
+
+    return backend->ReleaseContext(hContext);
 }
 
 int32_t
@@ -61,7 +74,14 @@ Native_SCardConnect(
     uint32_t* pdwActiveProtocol
 )
 {
-    return SCardConnect(
+    const scard_backend_t* backend = scard_backend();
+
+    if (backend == NULL)
+    {
+        return SCARD_E_NO_SERVICE;
+    }
+
+    return backend->Connect(
         hContext,
         szReader,
         dwShareMode,
@@ -81,7 +101,14 @@ Native_SCardReconnect(
     uint32_t* pdwActiveProtocol
 )
 {
-    return SCardReconnect(
+    const scard_backend_t* backend = scard_backend();
+
+    if (backend == NULL)
+    {
+        return SCARD_E_NO_SERVICE;
+    }
+
+    return backend->Reconnect(
         hCard,
         dwShareMode,
         dwPreferredProtocols,
@@ -97,7 +124,14 @@ Native_SCardDisconnect(
     uint32_t dwDisposition
 )
 {
-    return SCardDisconnect(
+    const scard_backend_t* backend = scard_backend();
+
+    if (backend == NULL)
+    {
+        return SCARD_E_NO_SERVICE;
+    }
+
+    return backend->Disconnect(
         hCard,
         dwDisposition
     );
@@ -109,7 +143,14 @@ Native_SCardBeginTransaction(
     SCARDHANDLE hCard
 )
 {
-    return SCardBeginTransaction(hCard);
+    const scard_backend_t* backend = scard_backend();
+
+    if (backend == NULL)
+    {
+        return SCARD_E_NO_SERVICE;
+    }
+
+    return backend->BeginTransaction(hCard);
 }
 
 int32_t
@@ -119,7 +160,14 @@ Native_SCardEndTransaction(
     uint32_t dwDisposition
 )
 {
-    return SCardEndTransaction(
+    const scard_backend_t* backend = scard_backend();
+
+    if (backend == NULL)
+    {
+        return SCARD_E_NO_SERVICE;
+    }
+
+    return backend->EndTransaction(
         hCard,
         dwDisposition
         );
@@ -134,6 +182,13 @@ Native_SCardGetStatusChange(
     uint32_t cReaders
 )
 {
+    const scard_backend_t* backend = scard_backend();
+
+    if (backend == NULL)
+    {
+        return SCARD_E_NO_SERVICE;
+    }
+
     SCARD_READERSTATE* readerStates = (SCARD_READERSTATE*)malloc(cReaders * sizeof(SCARD_READERSTATE));
 
     if (readerStates == NULL)
@@ -152,7 +207,7 @@ Native_SCardGetStatusChange(
         memcpy(readerStates[i].rgbAtr, rgReaderStates[i].rgbAtr, sizeof(readerStates[i].rgbAtr));
     }
 
-    int32_t result = SCardGetStatusChange(
+    int32_t result = backend->GetStatusChange(
         hContext,
         dwTimeout,
         readerStates,
@@ -172,6 +227,331 @@ Native_SCardGetStatusChange(
     return result;
 }
 
+#define NATIVE_INFINITE 0xFFFFFFFF
+#define NATIVE_STATE_MASK 0x0000FFFF
+
+/*
+ * The state bits that decide whether the filtered status change has anything
+ * to report: a card arrived or left, or the reader itself came or went.
+ */
+#define NATIVE_RELEVANT_STATES \
+    (SCARD_STATE_PRESENT | SCARD_STATE_EMPTY | SCARD_STATE_UNAVAILABLE | SCARD_STATE_UNKNOWN)
+
+static uint64_t
+monotonic_ms(void)
+{
+#ifdef PLATFORM_WINDOWS
+    return GetTickCount64();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+#endif
+}
+
+static int
+is_pnp_notification_reader(
+    const char* szReader
+)
+{
+    return strncmp(szReader, "\\\\?PnP?\\", 8) == 0;
+}
+
+/*
+ * Case-insensitive match of text against a pattern in which '*' matches any
+ * run of characters and '?' matches any single character.
+ */
+static int
+glob_match(
+    const char* pattern,
+    const char* text
+)
+{
+    const char* star = NULL;
+    const char* resume = NULL;
+
+    while (*text != '\0')
+    {
+        if (*pattern == '*')
+        {
+            star = pattern++;
+            resume = text;
+        }
+        else if (*pattern == '?' || tolower((unsigned char)*pattern) == tolower((unsigned char)*text))
+        {
+            pattern++;
+            text++;
+        }
+        else if (star != NULL)
+        {
+            pattern = star + 1;
+            text = ++resume;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
+    while (*pattern == '*')
+    {
+        pattern++;
+    }
+
+    return *pattern == '\0';
+}
+
+/*
+ * A NULL or empty multi-string of patterns matches every reader.
+ */
+static int
+reader_matches(
+    const char* mszReaderPatterns,
+    const char* szReader
+)
+{
+    if (mszReaderPatterns == NULL || *mszReaderPatterns == '\0')
+    {
+        return 1;
+    }
+
+    for (const char* pattern = mszReaderPatterns; *pattern != '\0'; pattern += strlen(pattern) + 1)
+    {
+        if (glob_match(pattern, szReader))
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * The prefixes are packed as a length byte followed by that many ATR bytes.
+ * An empty list matches every card.
+ */
+static int
+atr_matches(
+    const uint8_t* pbAtrPrefixes,
+    uint32_t cbAtrPrefixes,
+    const uint8_t* pbAtr,
+    uint32_t cbAtr
+)
+{
+    if (pbAtrPrefixes == NULL || cbAtrPrefixes == 0)
+    {
+        return 1;
+    }
+
+    uint32_t offset = 0;
+
+    while (offset < cbAtrPrefixes)
+    {
+        uint32_t cbPrefix = pbAtrPrefixes[offset++];
+
+        if (cbPrefix > cbAtrPrefixes - offset)
+        {
+            break;
+        }
+
+        if (cbPrefix <= cbAtr && memcmp(pbAtrPrefixes + offset, pbAtr, cbPrefix) == 0)
+        {
+            return 1;
+        }
+
+        offset += cbPrefix;
+    }
+
+    return 0;
+}
+
+/*
+ * A reader holding a card whose ATR does not match is reported as empty, so
+ * that cards the caller is not interested in are never seen.
+ */
+static uint32_t
+filtered_event_state(
+    const SCARD_READERSTATE* readerState,
+    const uint8_t* pbAtrPrefixes,
+    uint32_t cbAtrPrefixes
+)
+{
+    uint32_t eventState = readerState->dwEventState;
+
+    if ((eventState & SCARD_STATE_PRESENT) != 0
+        && !atr_matches(pbAtrPrefixes, cbAtrPrefixes, readerState->rgbAtr, readerState->cbAtr))
+    {
+        eventState = (eventState & (~NATIVE_STATE_MASK | SCARD_STATE_CHANGED)) | SCARD_STATE_EMPTY;
+    }
+
+    return eventState;
+}
+
+/*
+ * Behaves like Native_SCardGetStatusChange, except that only the readers whose
+ * names match one of mszReaderPatterns are handed to PC/SC, and that cards
+ * whose ATR matches none of pbAtrPrefixes are reported as absent. Changes that
+ * the filter hides are acknowledged here and the wait resumes, so that the
+ * caller only returns from a wait when there is something it would act on.
+ * A wake-up that no watched reader flags as CHANGED is always returned: some
+ * platforms announce a new reader that way, without flagging the PnP entry,
+ * and the caller has its own workaround for them.
+ * Readers left out by the filter are returned with their event state equal to
+ * their current state. The PnP notification reader always takes part.
+ */
+int32_t
+NATIVEAPI
+Native_SCardGetStatusChangeFiltered(
+    SCARDCONTEXT hContext,
+    uint32_t dwTimeout,
+    NATIVE_SCARD_READERSTATE* rgReaderStates,
+    uint32_t cReaders,
+    const u8str_t mszReaderPatterns,
+    const uint8_t* pbAtrPrefixes,
+    uint32_t cbAtrPrefixes
+)
+{
+    const scard_backend_t* backend = scard_backend();
+
+    if (backend == NULL)
+    {
+        return SCARD_E_NO_SERVICE;
+    }
+
+    SCARD_READERSTATE* readerStates = (SCARD_READERSTATE*)malloc(cReaders * sizeof(SCARD_READERSTATE));
+    uint32_t* readerIndices = (uint32_t*)malloc(cReaders * sizeof(uint32_t));
+
+    if (readerStates == NULL || readerIndices == NULL)
+    {
+        free(readerStates);
+        free(readerIndices);
+        return SCARD_E_NO_MEMORY;
+    }
+
+    memset(readerStates, 0, cReaders * sizeof(SCARD_READERSTATE));
+
+    uint32_t cActive = 0;
+
+    for (uint32_t i = 0; i < cReaders; i++)
+    {
+        if (!is_pnp_notification_reader(rgReaderStates[i].szReader)
+            && !reader_matches(mszReaderPatterns, rgReaderStates[i].szReader))
+        {
+            rgReaderStates[i].dwEventState = rgReaderStates[i].dwCurrentState;
+            continue;
+        }
+
+        readerIndices[cActive] = i;
+        readerStates[cActive].szReader = rgReaderStates[i].szReader;
+        readerStates[cActive].dwCurrentState = rgReaderStates[i].dwCurrentState;
+        readerStates[cActive].dwEventState = rgReaderStates[i].dwEventState;
+        readerStates[cActive].cbAtr = rgReaderStates[i].cbAtr;
+        memcpy(readerStates[cActive].rgbAtr, rgReaderStates[i].rgbAtr, sizeof(readerStates[cActive].rgbAtr));
+        cActive++;
+    }
+
+    uint64_t deadline = monotonic_ms() + dwTimeout;
+    uint32_t timeout = dwTimeout;
+    int32_t result;
+
+    for (;;)
+    {
+        result = backend->GetStatusChange(
+            hContext,
+            timeout,
+            readerStates,
+            cActive
+        );
+
+        if (result != SCARD_S_SUCCESS)
+        {
+            break;
+        }
+
+        int relevant = 0;
+        int explained = 0;
+
+        for (uint32_t j = 0; j < cActive && !relevant; j++)
+        {
+            if (is_pnp_notification_reader(readerStates[j].szReader))
+            {
+                relevant = (readerStates[j].dwEventState & SCARD_STATE_CHANGED) != 0;
+                continue;
+            }
+
+            if ((readerStates[j].dwEventState & SCARD_STATE_CHANGED) != 0)
+            {
+                explained = 1;
+            }
+
+            uint32_t eventState = filtered_event_state(&readerStates[j], pbAtrPrefixes, cbAtrPrefixes);
+            uint32_t callerState = rgReaderStates[readerIndices[j]].dwCurrentState;
+
+            /*
+             * The upper half counts insertions and removals. A matching card
+             * pulled and pushed back between two waits leaves the state bits
+             * alone and only bumps the count.
+             */
+            relevant = ((eventState ^ callerState) & NATIVE_RELEVANT_STATES) != 0
+                || (((eventState | callerState) & SCARD_STATE_PRESENT) != 0
+                    && ((eventState ^ callerState) & ~NATIVE_STATE_MASK) != 0);
+        }
+
+        /*
+         * An unexplained wake-up goes back to the caller rather than round this
+         * loop, which also keeps a backend that returns at once from spinning.
+         */
+        if (relevant || !explained)
+        {
+            break;
+        }
+
+        for (uint32_t j = 0; j < cActive; j++)
+        {
+            readerStates[j].dwCurrentState = readerStates[j].dwEventState & ~SCARD_STATE_CHANGED;
+        }
+
+        if (dwTimeout != NATIVE_INFINITE)
+        {
+            uint64_t now = monotonic_ms();
+
+            if (now >= deadline)
+            {
+                result = SCARD_E_TIMEOUT;
+                break;
+            }
+
+            timeout = (uint32_t)(deadline - now);
+        }
+    }
+
+    for (uint32_t j = 0; j < cActive; j++)
+    {
+        NATIVE_SCARD_READERSTATE* readerState = &rgReaderStates[readerIndices[j]];
+        uint32_t eventState = is_pnp_notification_reader(readerStates[j].szReader)
+            ? readerStates[j].dwEventState
+            : filtered_event_state(&readerStates[j], pbAtrPrefixes, cbAtrPrefixes);
+
+        readerState->dwEventState = eventState;
+
+        if (eventState == readerStates[j].dwEventState)
+        {
+            readerState->cbAtr = readerStates[j].cbAtr;
+            memcpy(readerState->rgbAtr, readerStates[j].rgbAtr, sizeof(readerState->rgbAtr));
+        }
+        else
+        {
+            readerState->cbAtr = 0;
+            memset(readerState->rgbAtr, 0, sizeof(readerState->rgbAtr));
+        }
+    }
+
+    free(readerIndices);
+    free(readerStates);
+
+    return result;
+}
+
 int32_t
 NATIVEAPI
 Native_SCardTransmit(
@@ -184,7 +564,14 @@ Native_SCardTransmit(
     uint32_t* pcbRecvLength
 )
 {
-    return SCardTransmit(
+    const scard_backend_t* backend = scard_backend();
+
+    if (backend == NULL)
+    {
+        return SCARD_E_NO_SERVICE;
+    }
+
+    return backend->Transmit(
         hCard,
         pioSendPci,
         pbSendBuffer,
@@ -204,12 +591,27 @@ Native_SCardListReaders(
     uint32_t* pcchReaders
 )
 {
-    return SCardListReaders(
+    const scard_backend_t* backend = scard_backend();
+
+    if (backend == NULL)
+    {
+        return SCARD_E_NO_SERVICE;
+    }
+
+    // pcsc-lite's DWORD is 64 bits on LP64 platforms, so the length goes through a DWORD of our own rather than
+    // letting the library read and write past the caller's 32-bit one.
+    DWORD cchReaders = *pcchReaders;
+
+    LONG result = backend->ListReaders(
         hContext,
         mszGroups,
         mszReaders,
-        pcchReaders
+        &cchReaders
     );
+
+    *pcchReaders = (uint32_t)cchReaders;
+
+    return result;
 }
 
 int32_t
@@ -218,5 +620,116 @@ Native_SCardCancel(
     SCARDCONTEXT hContext
 )
 {
-    return SCardCancel(hContext);
+    const scard_backend_t* backend = scard_backend();
+
+    if (backend == NULL)
+    {
+        return SCARD_E_NO_SERVICE;
+    }
+
+    return backend->Cancel(hContext);
+}
+
+#ifndef PLATFORM_WINDOWS
+/*
+ * pcsc-lite reports the card state of SCardStatus as a bit mask, where
+ * Windows reports one value from SCARD_UNKNOWN (0) to SCARD_SPECIFIC (6).
+ * The most advanced state in the mask is reported the Windows way, so that
+ * callers see the same values on every platform.
+ */
+static uint32_t
+normalize_card_state(
+    DWORD dwState
+)
+{
+    uint32_t state = 0;
+
+    for (uint32_t bit = 1; bit <= 6; bit++)
+    {
+        if (dwState & (1u << bit))
+        {
+            state = bit;
+        }
+    }
+
+    return state;
+}
+#endif
+
+/*
+ * Reads the state, active protocol and ATR of the card behind hCard without
+ * sending it anything. pbAtr may be NULL, in which case only the ATR length
+ * is returned through pcbAtrLen.
+ */
+int32_t
+NATIVEAPI
+Native_SCardStatus(
+    SCARDHANDLE hCard,
+    uint32_t* pdwState,
+    uint32_t* pdwProtocol,
+    uint8_t* pbAtr,
+    uint32_t* pcbAtrLen
+)
+{
+    const scard_backend_t* backend = scard_backend();
+
+    if (backend == NULL)
+    {
+        return SCARD_E_NO_SERVICE;
+    }
+
+    DWORD cchReaderLen = 0;
+    DWORD dwState = 0;
+    DWORD dwProtocol = 0;
+    DWORD cbAtrLen = *pcbAtrLen;
+
+    LONG result = backend->Status(
+        hCard,
+        NULL,
+        &cchReaderLen,
+        &dwState,
+        &dwProtocol,
+        pbAtr,
+        &cbAtrLen
+    );
+
+#ifdef PLATFORM_WINDOWS
+    *pdwState = (uint32_t)dwState;
+#else
+    *pdwState = normalize_card_state(dwState);
+#endif
+    *pdwProtocol = (uint32_t)dwProtocol;
+    *pcbAtrLen = (uint32_t)cbAtrLen;
+
+    return result;
+}
+
+int32_t
+NATIVEAPI
+Native_SCardGetAttrib(
+    SCARDHANDLE hCard,
+    uint32_t dwAttrId,
+    uint8_t* pbAttr,
+    uint32_t* pcbAttrLen
+)
+{
+    const scard_backend_t* backend = scard_backend();
+
+    if (backend == NULL)
+    {
+        return SCARD_E_NO_SERVICE;
+    }
+
+    DWORD cbAttrLen = *pcbAttrLen;
+
+    LONG result = backend->GetAttrib(
+        hCard,
+        dwAttrId,
+        pbAttr,
+        &cbAttrLen
+    );
+
+    *pcbAttrLen = (uint32_t)cbAttrLen;
+
+    return result;
 }
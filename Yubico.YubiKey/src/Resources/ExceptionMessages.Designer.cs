@@ -1005,6 +1005,33 @@ namespace Yubico.YubiKey {
             }
         }
         
+        /// <summary>
+        ///   Looks up a localized string similar to A YubiKey whose smart card connections are exclusive cannot be kept warm..
+        /// </summary>
+        internal static string KeepWarmExclusiveConnection {
+            get {
+                return ResourceManager.GetString("KeepWarmExclusiveConnection", resourceCulture);
+            }
+        }
+        
+        /// <summary>
+        ///   Looks up a localized string similar to Only a YubiKey with a smart card interface can be kept warm..
+        /// </summary>
+        internal static string KeepWarmNoSmartCard {
+            get {
+                return ResourceManager.GetString("KeepWarmNoSmartCard", resourceCulture);
+            }
+        }
+        
+        /// <summary>
+        ///   Looks up a localized string similar to A YubiKey whose smart card connections are pinned to a thread cannot be kept warm..
+        /// </summary>
+        internal static string KeepWarmThreadAffinity {
+            get {
+                return ResourceManager.GetString("KeepWarmThreadAffinity", resourceCulture);
+            }
+        }
+        
         /// <summary>
         ///   Looks up a localized string similar to The keyboard connection does not support writing more than 64 bytes to the device..
         /// </summary>
@@ -1599,6 +1626,15 @@ namespace Yubico.YubiKey {
             }
         }
         
+        /// <summary>
+        ///   Looks up a localized string similar to The reader filter must be set before YubiKeyDeviceListener.Instance is first accessed..
+        /// </summary>
+        internal static string ReaderFilterAfterListenerCreated {
+            get {
+                return ResourceManager.GetString("ReaderFilterAfterListenerCreated", resourceCulture);
+            }
+        }
+        
         /// <summary>
         ///   Looks up a localized string similar to Renaming a credential is not supported on YubiKeys with firmware version less than 5.3.0..
         /// </summary>
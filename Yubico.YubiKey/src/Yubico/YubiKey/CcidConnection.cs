@@ -13,6 +13,8 @@
 // limitations under the License.
 
 using System;
+using System.Collections.Generic;
+using System.Diagnostics;
 using System.Globalization;
 using Yubico.Core.Buffers;
 using Yubico.YubiKey.InterIndustry.Commands;
@@ -25,30 +27,45 @@ namespace Yubico.YubiKey
 {
     internal class CcidConnection : IYubiKeyConnection
     {
+        // The applications whose AIDs are recognized for metrics. Fido2 shares its AID with FidoU2f.
+        private static readonly YubiKeyApplication[] MetricsApplications =
+        {
+            YubiKeyApplication.Management,
+            YubiKeyApplication.Otp,
+            YubiKeyApplication.FidoU2f,
+            YubiKeyApplication.Oath,
+            YubiKeyApplication.OpenPgp,
+            YubiKeyApplication.Piv,
+            YubiKeyApplication.OtpNdef,
+            YubiKeyApplication.YubiHsmAuth,
+        };
+
         private readonly Logger _log = Log.GetLogger();
 
         private readonly byte[]? _applicationId;
         private readonly IApduTransform _apduPipeline;
         private readonly ISmartCardConnection _smartCardConnection;
         private readonly YubiKeyApplication _yubiKeyApplication;
+        private readonly string _metricsApplication;
         private bool _disposedValue;
 
         public ISelectApplicationData? SelectApplicationData { get; set; }
 
-        public CcidConnection(ISmartCardDevice smartCardDevice, YubiKeyApplication yubiKeyApplication)
+        public CcidConnection(ISmartCardDevice smartCardDevice, YubiKeyApplication yubiKeyApplication, SmartCardConnectionOptions? connectionOptions = null)
         {
             if (yubiKeyApplication == YubiKeyApplication.Unknown)
             {
                 throw new NotSupportedException();
             }
 
-            _smartCardConnection = smartCardDevice.Connect();
+            _smartCardConnection = Connect(smartCardDevice, connectionOptions);
 
             _apduPipeline = new SmartCardTransform(_smartCardConnection);
             _apduPipeline = new ResponseChainingTransform(_apduPipeline);
             _apduPipeline = new CommandChainingTransform(_apduPipeline);
 
             _yubiKeyApplication = yubiKeyApplication;
+            _metricsApplication = yubiKeyApplication.ToString();
 
             // CCID has the concept of multiple applications. Since we cannot guarantee the
             // state of the smart card when connecting, we should always send down a connection
@@ -56,16 +73,17 @@ namespace Yubico.YubiKey
             SelectApplication();
         }
 
-        public CcidConnection(ISmartCardDevice smartCardDevice, byte[] applicationId)
+        public CcidConnection(ISmartCardDevice smartCardDevice, byte[] applicationId, SmartCardConnectionOptions? connectionOptions = null)
         {
             _applicationId = applicationId;
-            _smartCardConnection = smartCardDevice.Connect();
+            _smartCardConnection = Connect(smartCardDevice, connectionOptions);
 
             _apduPipeline = new SmartCardTransform(_smartCardConnection);
             _apduPipeline = new ResponseChainingTransform(_apduPipeline);
             _apduPipeline = new CommandChainingTransform(_apduPipeline);
 
             _yubiKeyApplication = YubiKeyApplication.Unknown;
+            _metricsApplication = GetMetricsApplication(applicationId);
 
             // CCID has the concept of multiple applications. Since we cannot guarantee the
             // state of the smart card when connecting, we should always send down a connection
@@ -73,14 +91,14 @@ namespace Yubico.YubiKey
             SelectApplication();
         }
 
-        public CcidConnection(ISmartCardDevice smartCardDevice, YubiKeyApplication yubiKeyApplication, Scp03.StaticKeys staticKeys)
+        public CcidConnection(ISmartCardDevice smartCardDevice, YubiKeyApplication yubiKeyApplication, Scp03.StaticKeys staticKeys, SmartCardConnectionOptions? connectionOptions = null)
         {
             if (yubiKeyApplication == YubiKeyApplication.Unknown)
             {
                 throw new NotSupportedException();
             }
 
-            _smartCardConnection = smartCardDevice.Connect();
+            _smartCardConnection = Connect(smartCardDevice, connectionOptions);
 
             _apduPipeline = new SmartCardTransform(_smartCardConnection);
             _apduPipeline = new Scp03ApduTransform(_apduPipeline, staticKeys);
@@ -89,6 +107,7 @@ namespace Yubico.YubiKey
             _apduPipeline = new OtpErrorTransform(_apduPipeline);
 
             _yubiKeyApplication = yubiKeyApplication;
+            _metricsApplication = yubiKeyApplication.ToString();
 
             // CCID has the concept of multiple applications. Since we cannot guarantee the
             // state of the smart card when connecting, we should always send down a connection
@@ -98,11 +117,11 @@ namespace Yubico.YubiKey
             _apduPipeline.Setup();
         }
 
-        public CcidConnection(ISmartCardDevice smartCardDevice, byte[] applicationId, Scp03.StaticKeys staticKeys)
+        public CcidConnection(ISmartCardDevice smartCardDevice, byte[] applicationId, Scp03.StaticKeys staticKeys, SmartCardConnectionOptions? connectionOptions = null)
         {
             _applicationId = applicationId;
 
-            _smartCardConnection = smartCardDevice.Connect();
+            _smartCardConnection = Connect(smartCardDevice, connectionOptions);
 
             _apduPipeline = new SmartCardTransform(_smartCardConnection);
             _apduPipeline = new Scp03ApduTransform(_apduPipeline, staticKeys);
@@ -111,6 +130,7 @@ namespace Yubico.YubiKey
             _apduPipeline = new OtpErrorTransform(_apduPipeline);
 
             _yubiKeyApplication = YubiKeyApplication.Unknown;
+            _metricsApplication = GetMetricsApplication(applicationId);
 
             // CCID has the concept of multiple applications. Since we cannot guarantee the
             // state of the smart card when connecting, we should always send down a connection
@@ -120,22 +140,56 @@ namespace Yubico.YubiKey
             _apduPipeline.Setup();
         }
 
+        // Tagging metrics with the raw AID would give the tag an unbounded set of values, so a connection opened by AID
+        // is tagged with the name of the application that AID selects, or Unknown.
+        private static string GetMetricsApplication(byte[] applicationId) =>
+            Array.Find(
+                MetricsApplications,
+                a => a.GetIso7816ApplicationId().AsSpan().SequenceEqual(applicationId)).ToString();
+
+        // Options can only be honored by devices that derive from SmartCardDevice. Anything else is opened as usual.
+        private static ISmartCardConnection Connect(ISmartCardDevice smartCardDevice, SmartCardConnectionOptions? connectionOptions) =>
+            connectionOptions is null || !(smartCardDevice is SmartCardDevice device)
+                ? smartCardDevice.Connect()
+                : device.Connect(connectionOptions);
+
         public TResponse SendCommand<TResponse>(IYubiKeyCommand<TResponse> yubiKeyCommand) where TResponse : IYubiKeyResponse
         {
-            using (IDisposable transaction = _smartCardConnection.BeginTransaction(out bool cardWasReset))
+            long startTimestamp = YubiKeyMetrics.StartCommand();
+            CommandApdu commandApdu = yubiKeyCommand.CreateCommandApdu();
+
+            using Activity? activity = YubiKeyActivitySource.StartApdu(yubiKeyCommand.GetType().Name, commandApdu);
+            _ = activity?.SetTag(YubiKeyMetrics.ApplicationTag, _metricsApplication);
+            _ = activity?.SetTag(YubiKeyMetrics.TransportTag, nameof(Transport.SmartCard));
+
+            ResponseApdu responseApdu;
+
+            try
             {
-                if (cardWasReset)
+                using (IDisposable transaction = _smartCardConnection.BeginTransaction(out bool cardWasReset))
                 {
-                    SelectApplication();
+                    if (cardWasReset)
+                    {
+                        YubiKeyMetrics.CardResets.Add(1, new KeyValuePair<string, object?>(YubiKeyMetrics.ApplicationTag, _metricsApplication));
+                        SelectApplication();
+                    }
+
+                    responseApdu = _apduPipeline.Invoke(
+                        commandApdu,
+                        yubiKeyCommand.GetType(),
+                        typeof(TResponse));
                 }
+            }
+            catch
+            {
+                YubiKeyMetrics.RecordCommand(_metricsApplication, nameof(Transport.SmartCard), yubiKeyCommand.GetType(), YubiKeyMetrics.ErrorOutcome, startTimestamp);
+                throw;
+            }
 
-                ResponseApdu responseApdu = _apduPipeline.Invoke(
-                    yubiKeyCommand.CreateCommandApdu(),
-                    yubiKeyCommand.GetType(),
-                    typeof(TResponse));
+            YubiKeyMetrics.RecordCommand(_metricsApplication, nameof(Transport.SmartCard), yubiKeyCommand.GetType(), YubiKeyMetrics.SuccessOutcome, startTimestamp);
+            YubiKeyActivitySource.SetResponse(activity, responseApdu);
 
-                return yubiKeyCommand.CreateResponseForApdu(responseApdu);
-            }
+            return yubiKeyCommand.CreateResponseForApdu(responseApdu);
         }
 
         private void SelectApplication()
@@ -148,7 +202,12 @@ namespace Yubico.YubiKey
             };
 
             _log.LogInformation("Selecting smart card application [{AID}]", Hex.BytesToHex(_applicationId ?? _yubiKeyApplication.GetIso7816ApplicationId()));
-            ResponseApdu responseApdu = _smartCardConnection.Transmit(selectApplicationCommand.CreateCommandApdu());
+
+            CommandApdu selectApdu = selectApplicationCommand.CreateCommandApdu();
+            using Activity? activity = YubiKeyActivitySource.StartApdu(nameof(SelectApplication), selectApdu);
+
+            ResponseApdu responseApdu = _smartCardConnection.Transmit(selectApdu);
+            YubiKeyActivitySource.SetResponse(activity, responseApdu);
 
             if (responseApdu.SW != SWConstants.Success)
             {
@@ -173,6 +232,7 @@ namespace Yubico.YubiKey
             {
                 if (disposing)
                 {
+                    _apduPipeline.Cleanup();
                     _smartCardConnection.Dispose();
                 }
 
@@ -150,6 +150,7 @@ namespace Yubico.YubiKey
             {
                 if (_openConnections.Contains(yubiKeyDevice))
                 {
+                    YubiKeyMetrics.ConnectionsRefused.Add(1);
                     connection = null;
 
                     return false;
@@ -170,6 +171,7 @@ namespace Yubico.YubiKey
                 // and entering the write lock.
                 if (_openConnections.Contains(yubiKeyDevice))
                 {
+                    YubiKeyMetrics.ConnectionsRefused.Add(1);
                     connection = null;
 
                     return false;
@@ -241,6 +243,7 @@ namespace Yubico.YubiKey
             {
                 if (_openConnections.Contains(yubiKeyDevice))
                 {
+                    YubiKeyMetrics.ConnectionsRefused.Add(1);
                     connection = null;
 
                     return false;
@@ -261,6 +264,7 @@ namespace Yubico.YubiKey
                 // and entering the write lock.
                 if (_openConnections.Contains(yubiKeyDevice))
                 {
+                    YubiKeyMetrics.ConnectionsRefused.Add(1);
                     connection = null;
 
                     return false;
@@ -87,13 +87,8 @@ namespace Yubico.YubiKey.Cryptography
         /// <param name="key">16-byte AES128 key</param>
         /// <param name="input">Input to compute the MAC over</param>
         /// <returns></returns>
-        public static byte[] AesCmac(byte[] key, ReadOnlySpan<byte> input)
+        public static byte[] AesCmac(ReadOnlySpan<byte> key, ReadOnlySpan<byte> input)
         {
-            if (key is null)
-            {
-                throw new ArgumentNullException(nameof(key));
-            }
-
             if (key.Length != 16)
             {
                 throw new ArgumentException(ExceptionMessages.IncorrectAesKeyLength, nameof(key));
@@ -32,6 +32,21 @@ namespace Yubico.YubiKey.Cryptography
         /// <param name="key">16-byte AES128 key</param>
         /// <param name="plaintext">16-byte input block</param>
         /// <returns>The 16-byte AES128 ciphertext</returns>
+        public static byte[] BlockCipher(ReadOnlySpan<byte> key, ReadOnlySpan<byte> plaintext)
+        {
+            byte[] keyArray = key.ToArray();
+
+            try
+            {
+                return BlockCipher(keyArray, plaintext);
+            }
+            finally
+            {
+                CryptographicOperations.ZeroMemory(keyArray);
+            }
+        }
+
+        /// <inheritdoc cref="BlockCipher(ReadOnlySpan{byte}, ReadOnlySpan{byte})"/>
         public static byte[] BlockCipher(byte[] key, ReadOnlySpan<byte> plaintext)
         {
             if (key is null)
@@ -88,6 +103,21 @@ namespace Yubico.YubiKey.Cryptography
         /// <param name="iv">16-byte initialization vector (IV)</param>
         /// <param name="plaintext">Input blocks; must be a non-zero multiple of 16 bytes long</param>
         /// <returns>Ciphertext of the same length as the plaintext</returns>
+        public static byte[] AesCbcEncrypt(ReadOnlySpan<byte> key, byte[] iv, ReadOnlySpan<byte> plaintext)
+        {
+            byte[] keyArray = key.ToArray();
+
+            try
+            {
+                return AesCbcEncrypt(keyArray, iv, plaintext);
+            }
+            finally
+            {
+                CryptographicOperations.ZeroMemory(keyArray);
+            }
+        }
+
+        /// <inheritdoc cref="AesCbcEncrypt(ReadOnlySpan{byte}, byte[], ReadOnlySpan{byte})"/>
         public static byte[] AesCbcEncrypt(byte[] key, byte[] iv, ReadOnlySpan<byte> plaintext)
         {
             if (key is null)
@@ -152,6 +182,21 @@ namespace Yubico.YubiKey.Cryptography
         /// <param name="iv">16-byte initialization vector (IV)</param>
         /// <param name="ciphertext">Input blocks; must be a non-zero multiple of 16 bytes long</param>
         /// <returns>Plaintext of the same length as the ciphertext</returns>
+        public static byte[] AesCbcDecrypt(ReadOnlySpan<byte> key, byte[] iv, ReadOnlySpan<byte> ciphertext)
+        {
+            byte[] keyArray = key.ToArray();
+
+            try
+            {
+                return AesCbcDecrypt(keyArray, iv, ciphertext);
+            }
+            finally
+            {
+                CryptographicOperations.ZeroMemory(keyArray);
+            }
+        }
+
+        /// <inheritdoc cref="AesCbcDecrypt(ReadOnlySpan{byte}, byte[], ReadOnlySpan{byte})"/>
         public static byte[] AesCbcDecrypt(byte[] key, byte[] iv, ReadOnlySpan<byte> ciphertext)
         {
             if (key is null)
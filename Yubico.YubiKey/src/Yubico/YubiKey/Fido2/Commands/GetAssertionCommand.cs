@@ -63,12 +63,7 @@ namespace Yubico.YubiKey.Fido2.Commands
         /// <inheritdoc />
         public CommandApdu CreateCommandApdu()
         {
-            byte[] cborData = Ctap2CborSerializer.Serialize(_getAssertionInput);
-
-            byte[] payload = new byte[1 + cborData.Length];
-            payload[0] = CtapGetAssertionCmd;
-
-            cborData.CopyTo(payload, 1);
+            byte[] payload = Ctap2CborSerializer.SerializeCommand(CtapGetAssertionCmd, _getAssertionInput);
 
             return new CommandApdu()
             {
@@ -63,12 +63,7 @@ namespace Yubico.YubiKey.Fido2.Commands
         /// <inheritdoc />
         public CommandApdu CreateCommandApdu()
         {
-            byte[] cborData = Ctap2CborSerializer.Serialize(_makeCredentialInput);
-
-            byte[] payload = new byte[1 + cborData.Length];
-            payload[0] = CtapMakeCredentialCmd;
-
-            cborData.CopyTo(payload, 1);
+            byte[] payload = Ctap2CborSerializer.SerializeCommand(CtapMakeCredentialCmd, _makeCredentialInput);
 
             return new CommandApdu()
             {
@@ -25,6 +25,12 @@ namespace Yubico.YubiKey.Fido2.Serialization
 {
     internal static class Ctap2CborSerializer
     {
+        // A full CTAPHID message can carry at most 7609 bytes, which is the most a command can legitimately need.
+        private const int MaxCachedCommandWriterSize = 7609;
+
+        [ThreadStatic]
+        private static CborWriter? _cachedCommandWriter;
+
         /// <summary>
         /// Checks if property is a nullable reference OR a nullable value type
         /// </summary>
@@ -332,6 +338,49 @@ namespace Yubico.YubiKey.Fido2.Serialization
             return writer.Encode();
         }
 
+        /// <summary>
+        /// Serializes the given object as the parameters of a CTAP2 authenticator command.
+        /// </summary>
+        /// <remarks>
+        /// <para>
+        /// The result is laid out exactly as the authenticator expects it in a CTAPHID_CBOR message: the one byte
+        /// command code followed by the CBOR-encoded parameters. The CBOR is encoded directly behind the command byte,
+        /// so the returned array is the only buffer allocated per call.
+        /// </para>
+        /// <para>
+        /// Each thread keeps one <see cref="CborWriter"/> that is reused across calls. The writer zeroes its buffer
+        /// when it is reset, so no request data lingers between calls.
+        /// </para>
+        /// </remarks>
+        /// <param name="commandByte">The CTAP2 authenticator command code.</param>
+        /// <param name="data">The command parameters.</param>
+        /// <returns>The command byte followed by the encoded parameters.</returns>
+        public static byte[] SerializeCommand(byte commandByte, object? data)
+        {
+            CborWriter writer = _cachedCommandWriter ??= new CborWriter(CborConformanceMode.Ctap2Canonical);
+
+            try
+            {
+                Serialize(writer, data);
+
+                byte[] payload = new byte[1 + writer.BytesWritten];
+                payload[0] = commandByte;
+                _ = writer.Encode(payload.AsSpan(1));
+
+                // Don't let one unusually large request pin a large buffer to this thread forever.
+                if (writer.BytesWritten > MaxCachedCommandWriterSize)
+                {
+                    _cachedCommandWriter = null;
+                }
+
+                return payload;
+            }
+            finally
+            {
+                writer.Reset();
+            }
+        }
+
         /// <summary>
         /// Serializes data in the given object using the given CborWriter.
         /// </summary>
@@ -28,7 +28,7 @@ namespace Yubico.YubiKey
         {
             _fidoConnection = hidDevice.ConnectToIOReports();
 
-            _apduPipeline = new FidoTransform(_fidoConnection);
+            _apduPipeline = new FidoTransform(_fidoConnection, CtapHidChannelRegistry.GetDeviceKey(hidDevice));
 
             _apduPipeline.Setup();
         }
@@ -36,13 +36,37 @@ namespace Yubico.YubiKey
         public TResponse SendCommand<TResponse>(IYubiKeyCommand<TResponse> yubiKeyCommand)
             where TResponse : IYubiKeyResponse
         {
+            long startTimestamp = YubiKeyMetrics.StartCommand();
+
             CommandApdu commandApdu = yubiKeyCommand.CreateCommandApdu();
 
-            ResponseApdu responseApdu = _apduPipeline.Invoke(commandApdu, yubiKeyCommand.GetType(), typeof(TResponse));
+            using System.Diagnostics.Activity? activity = YubiKeyActivitySource.StartApdu(yubiKeyCommand.GetType().Name, commandApdu);
+            _ = activity?.SetTag(YubiKeyMetrics.TransportTag, nameof(Transport.HidFido));
+
+            ResponseApdu responseApdu;
+
+            try
+            {
+                responseApdu = _apduPipeline.Invoke(commandApdu, yubiKeyCommand.GetType(), typeof(TResponse));
+            }
+            catch
+            {
+                YubiKeyMetrics.RecordCommand(GetMetricsApplication(yubiKeyCommand.GetType()), nameof(Transport.HidFido), yubiKeyCommand.GetType(), YubiKeyMetrics.ErrorOutcome, startTimestamp);
+                throw;
+            }
+
+            YubiKeyMetrics.RecordCommand(GetMetricsApplication(yubiKeyCommand.GetType()), nameof(Transport.HidFido), yubiKeyCommand.GetType(), YubiKeyMetrics.SuccessOutcome, startTimestamp);
+            YubiKeyActivitySource.SetResponse(activity, responseApdu);
 
             return yubiKeyCommand.CreateResponseForApdu(responseApdu);
         }
 
+        // U2F and FIDO2 share the FIDO HID interface, so the application is told apart by the command's namespace.
+        private static string GetMetricsApplication(System.Type commandType) =>
+            commandType.Namespace == typeof(U2f.Commands.AuthenticateCommand).Namespace
+                ? nameof(YubiKeyApplication.FidoU2f)
+                : nameof(YubiKeyApplication.Fido2);
+
         public InterIndustry.Commands.ISelectApplicationData? SelectApplicationData { get; set; }
 
         protected virtual void Dispose(bool disposing)
@@ -51,6 +75,7 @@ namespace Yubico.YubiKey
             {
                 if (disposing)
                 {
+                    _apduPipeline.Cleanup();
                     _fidoConnection.Dispose();
                 }
 
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 using System;
+using System.Diagnostics;
 using Yubico.Core.Devices.Hid;
 using Yubico.Core.Iso7816;
 using Yubico.YubiKey.Pipelines;
@@ -39,9 +40,27 @@ namespace Yubico.YubiKey
         public TResponse SendCommand<TResponse>(IYubiKeyCommand<TResponse> yubiKeyCommand)
             where TResponse : IYubiKeyResponse
         {
+            long startTimestamp = YubiKeyMetrics.StartCommand();
+
             CommandApdu apdu = yubiKeyCommand.CreateCommandApdu();
 
-            ResponseApdu responseApdu = _apduPipeline.Invoke(apdu, yubiKeyCommand.GetType(), typeof(TResponse));
+            using Activity? activity = YubiKeyActivitySource.StartApdu(yubiKeyCommand.GetType().Name, apdu);
+            _ = activity?.SetTag(YubiKeyMetrics.TransportTag, nameof(Transport.HidKeyboard));
+
+            ResponseApdu responseApdu;
+
+            try
+            {
+                responseApdu = _apduPipeline.Invoke(apdu, yubiKeyCommand.GetType(), typeof(TResponse));
+            }
+            catch
+            {
+                YubiKeyMetrics.RecordCommand(nameof(YubiKeyApplication.Otp), nameof(Transport.HidKeyboard), yubiKeyCommand.GetType(), YubiKeyMetrics.ErrorOutcome, startTimestamp);
+                throw;
+            }
+
+            YubiKeyMetrics.RecordCommand(nameof(YubiKeyApplication.Otp), nameof(Transport.HidKeyboard), yubiKeyCommand.GetType(), YubiKeyMetrics.SuccessOutcome, startTimestamp);
+            YubiKeyActivitySource.SetResponse(activity, responseApdu);
 
             return yubiKeyCommand.CreateResponseForApdu(responseApdu);
         }
@@ -355,10 +355,7 @@ namespace Yubico.YubiKey.Otp.Operations
                     // making sure our generated password can be represented with
                     // the chosen keyboard layout.
                     _passwordHidCodes = new byte[password.Length];
-                    for (int i = 0; i < password.Length; ++i)
-                    {
-                        _passwordHidCodes[i] = translator[password[i]];
-                    }
+                    _ = translator.GetHidCodes(password, _passwordHidCodes);
 
                     // At this point, we don't need to reference the password data.
                     _password = _generatedPassword = Array.Empty<char>();
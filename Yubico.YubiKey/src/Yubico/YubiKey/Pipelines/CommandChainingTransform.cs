@@ -13,6 +13,7 @@
 // limitations under the License.
 
 using System;
+using System.Diagnostics;
 using Yubico.Core.Iso7816;
 
 namespace Yubico.YubiKey.Pipelines
@@ -46,8 +47,11 @@ namespace Yubico.YubiKey.Pipelines
                 return _pipeline.Invoke(command, commandType, responseType);
             }
 
+            using Activity? activity = YubiKeyActivitySource.StartApdu(nameof(CommandChainingTransform), command);
+
             ReadOnlyMemory<byte> sourceData = command.Data;
             ResponseApdu? responseApdu = null;
+            int chainLength = 0;
 
             while (!sourceData.IsEmpty)
             {
@@ -65,8 +69,12 @@ namespace Yubico.YubiKey.Pipelines
                 };
 
                 responseApdu = _pipeline.Invoke(partialApdu, commandType, responseType);
+                chainLength++;
             }
 
+            YubiKeyMetrics.CommandChainLength.Record(chainLength, YubiKeyMetrics.CommandTypeTag(commandType));
+            YubiKeyActivitySource.SetResponse(activity, responseApdu!);
+
             return responseApdu!; // Covered by Debug.Assert above.
         }
 
@@ -0,0 +1,120 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using System.Collections.Concurrent;
+using System.Globalization;
+using Yubico.Core.Devices.Hid;
+
+namespace Yubico.YubiKey.Pipelines
+{
+    /// <summary>
+    /// A process-wide registry of CTAPHID channels that have already been allocated by an authenticator.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Acquiring a CTAPHID channel requires a CTAPHID_INIT exchange on the broadcast channel. A channel ID remains
+    /// valid for as long as the authenticator stays attached, so there is no need to pay for that round trip every time
+    /// a new <see cref="FidoConnection"/> is created. Once a connection is done with its channel, it returns the ID here
+    /// and the next connection to the same authenticator rents it instead of sending CTAPHID_INIT again.
+    /// </para>
+    /// <para>
+    /// A channel is only ever handed to one connection at a time; renting removes it from the registry. Entries are
+    /// keyed by the device's path as well as its vendor, product, and parent identifiers so that a different device
+    /// reusing an operating system path never receives a stale channel. Entries for a path are dropped when the device
+    /// is removed. Should a stale channel still slip through, <see cref="FidoTransform"/> recovers by re-initializing
+    /// when the authenticator reports an invalid channel.
+    /// </para>
+    /// </remarks>
+    internal static class CtapHidChannelRegistry
+    {
+        // An application rarely needs more than a couple of concurrent channels to a single authenticator. Anything
+        // beyond this is simply discarded and the authenticator will eventually recycle it.
+        private const int MaxIdleChannelsPerDevice = 4;
+
+        private static readonly ConcurrentDictionary<string, ConcurrentStack<uint>> _idleChannels =
+            new ConcurrentDictionary<string, ConcurrentStack<uint>>(StringComparer.Ordinal);
+
+        /// <summary>
+        /// Computes the key that identifies an authenticator within the registry.
+        /// </summary>
+        /// <param name="hidDevice">The FIDO HID device.</param>
+        /// <returns>A string that uniquely identifies the device instance.</returns>
+        public static string GetDeviceKey(IHidDevice hidDevice)
+        {
+            if (hidDevice is null)
+            {
+                throw new ArgumentNullException(nameof(hidDevice));
+            }
+
+            return string.Format(
+                CultureInfo.InvariantCulture,
+                "{0}|{1:X4}|{2:X4}|{3}",
+                hidDevice.Path,
+                hidDevice.VendorId,
+                hidDevice.ProductId,
+                hidDevice.ParentDeviceId ?? string.Empty);
+        }
+
+        /// <summary>
+        /// Attempts to take an idle channel previously allocated by the given device.
+        /// </summary>
+        /// <param name="deviceKey">The key returned by <see cref="GetDeviceKey(IHidDevice)"/>.</param>
+        /// <param name="channelId">The channel ID, if one was available.</param>
+        /// <returns>`true` if an idle channel was found, `false` otherwise.</returns>
+        public static bool TryRent(string deviceKey, out uint channelId)
+        {
+            if (_idleChannels.TryGetValue(deviceKey, out ConcurrentStack<uint> channels)
+                && channels.TryPop(out channelId))
+            {
+                return true;
+            }
+
+            channelId = 0;
+            return false;
+        }
+
+        /// <summary>
+        /// Makes a channel available to the next connection to the given device.
+        /// </summary>
+        /// <param name="deviceKey">The key returned by <see cref="GetDeviceKey(IHidDevice)"/>.</param>
+        /// <param name="channelId">A channel ID that is known to be valid and idle.</param>
+        public static void Return(string deviceKey, uint channelId)
+        {
+            ConcurrentStack<uint> channels = _idleChannels.GetOrAdd(deviceKey, _ => new ConcurrentStack<uint>());
+
+            if (channels.Count < MaxIdleChannelsPerDevice)
+            {
+                channels.Push(channelId);
+            }
+        }
+
+        /// <summary>
+        /// Drops every idle channel that belongs to a device at the given path.
+        /// </summary>
+        /// <param name="devicePath">The <see cref="Core.Devices.IDevice.Path"/> of the removed device.</param>
+        public static void Invalidate(string devicePath)
+        {
+            string prefix = devicePath + "|";
+
+            foreach (string key in _idleChannels.Keys)
+            {
+                if (key.StartsWith(prefix, StringComparison.Ordinal))
+                {
+                    _ = _idleChannels.TryRemove(key, out _);
+                }
+            }
+        }
+    }
+}
@@ -42,8 +42,18 @@ namespace Yubico.YubiKey.Pipelines
 
         internal readonly IHidConnection _hidConnection;
 
+        private readonly string? _deviceKey;
+
         private uint? _channelId;
 
+        // Set while a request/response exchange is in flight. If an exchange is interrupted the channel may still have
+        // a partial message pending on it, so it must not be handed to another connection.
+        private bool _channelInUse;
+
+        // Request packets are framed in place into this buffer. Every IHidConnection copies the report before
+        // returning from SetReport, so the buffer can be reused for the next packet right away.
+        private readonly byte[] _packetBuffer = new byte[PacketSize];
+
         public bool IsChannelIdAcquired => _channelId.HasValue;
 
         public FidoTransform(IHidConnection hidConnection)
@@ -56,7 +66,28 @@ namespace Yubico.YubiKey.Pipelines
             _hidConnection = hidConnection;
         }
 
-        public void Setup() => AcquireCtapHidChannel();
+        /// <summary>
+        /// Constructs a transform that reuses idle channels from the <see cref="CtapHidChannelRegistry"/>.
+        /// </summary>
+        /// <param name="hidConnection">The I/O report connection to the FIDO device.</param>
+        /// <param name="deviceKey">The device's key, from <see cref="CtapHidChannelRegistry.GetDeviceKey"/>.</param>
+        public FidoTransform(IHidConnection hidConnection, string deviceKey)
+            : this(hidConnection)
+        {
+            _deviceKey = deviceKey;
+        }
+
+        public void Setup()
+        {
+            if (!(_deviceKey is null)
+                && CtapHidChannelRegistry.TryRent(_deviceKey, out uint idleChannelId))
+            {
+                _channelId = idleChannelId;
+                return;
+            }
+
+            AcquireCtapHidChannel();
+        }
 
         // In the case where we received a U2F HID error, the response APDU's
         // data field will contain the error code (1 byte long), and the Status
@@ -70,7 +101,7 @@ namespace Yubico.YubiKey.Pipelines
             }
 
             byte ctapCmd = commandApdu.Ins;
-            byte[] ctapData = commandApdu.Data.ToArray();
+            ReadOnlySpan<byte> ctapData = commandApdu.Data.Span;
 
             if (ctapData.Length >= MaxPayloadSize)
             {
@@ -79,6 +110,16 @@ namespace Yubico.YubiKey.Pipelines
 
             byte[] responseData = TransmitCommand(_channelId!.Value, ctapCmd, ctapData, out byte responseByte);
 
+            // A channel taken from the registry may have been invalidated by the authenticator (for example,
+            // if it was power cycled without us noticing). Allocate a fresh channel and try exactly once more.
+            if (IsInvalidChannelError(responseByte, responseData))
+            {
+                YubiKeyMetrics.CtapHidChannelRetries.Add(1);
+                AcquireCtapHidChannel();
+
+                responseData = TransmitCommand(_channelId!.Value, ctapCmd, ctapData, out responseByte);
+            }
+
             ResponseApdu responseApdu =
                 responseByte switch
                 {
@@ -90,12 +131,25 @@ namespace Yubico.YubiKey.Pipelines
             return responseApdu;
         }
 
-        public void Cleanup() => _channelId = null;
-
-        private static byte[] ConstructInitPacket(uint cid, byte cmd, ReadOnlySpan<byte> data, int totalDataLength)
+        public void Cleanup()
         {
-            byte[] packet = new byte[PacketSize];
+            bool channelIsReusable = _channelId.HasValue && !_channelInUse;
+
+            if (channelIsReusable && !(_deviceKey is null))
+            {
+                CtapHidChannelRegistry.Return(_deviceKey, _channelId!.Value);
+            }
 
+            _channelId = null;
+        }
+
+        private static bool IsInvalidChannelError(byte responseByte, byte[] responseData) =>
+            responseByte == (byte)CtapHidCommand.Error
+            && responseData.Length == 1
+            && responseData[0] == (byte)U2f.U2fHidStatus.Ctap1ErrInvalidChannel;
+
+        private static void ConstructInitPacket(byte[] packet, uint cid, byte cmd, ReadOnlySpan<byte> data, int totalDataLength)
+        {
             BinaryPrimitives.WriteUInt32BigEndian(packet, cid);
 
             // always set bit 7 for init packets
@@ -104,23 +158,19 @@ namespace Yubico.YubiKey.Pipelines
             packet[5] = (byte)(totalDataLength >> 8);
             packet[6] = (byte)(totalDataLength & 0xFF);
 
-            data.CopyTo(packet.AsSpan(7));
-
-            return packet;
+            data.CopyTo(packet.AsSpan(InitHeaderSize));
+            packet.AsSpan(InitHeaderSize + data.Length).Clear();
         }
 
-        private static byte[] ConstructContinuationPacket(uint cid, byte seq, ReadOnlySpan<byte> data)
+        private static void ConstructContinuationPacket(byte[] packet, uint cid, byte seq, ReadOnlySpan<byte> data)
         {
-            byte[] packet = new byte[PacketSize];
-
             BinaryPrimitives.WriteUInt32BigEndian(packet, cid);
 
             // always unset bit 7 for cont packets
             packet[4] = (byte)(seq & 0b0111_1111);
 
-            data.CopyTo(packet.AsSpan(5));
-
-            return packet;
+            data.CopyTo(packet.AsSpan(ContinuationHeaderSize));
+            packet.AsSpan(ContinuationHeaderSize + data.Length).Clear();
         }
 
         // This function applies a mask to remove the initial frame identifier (0x80)
@@ -130,35 +180,51 @@ namespace Yubico.YubiKey.Pipelines
         private static int GetPacketBcnt(byte[] packet) =>
             (packet[5] << 8) | (packet[6]);
 
-        private byte[] TransmitCommand(uint channelId, byte commandByte, byte[] data, out byte responseByte)
+        private byte[] TransmitCommand(uint channelId, byte commandByte, ReadOnlySpan<byte> data, out byte responseByte)
         {
+            _channelInUse = true;
+
             SendRequest(channelId, commandByte, data);
 
             byte[] responseData = ReceiveResponse(out responseByte);
 
+            _channelInUse = false;
+
             return responseData;
         }
 
         private void SendRequest(uint channelId, byte commandByte, ReadOnlySpan<byte> data)
         {
-            // send init request packet
-            bool requestFitsInInit = data.Length <= InitDataSize;
-            ReadOnlySpan<byte> dataInInitPacket = requestFitsInInit ? data : data.Slice(0, InitDataSize);
-            _hidConnection.SetReport(ConstructInitPacket(channelId, commandByte, dataInInitPacket, data.Length));
-
-            if (!requestFitsInInit)
+            try
             {
-                // send continuation request packets if necessary
-                data = data[InitDataSize..];
+                // send init request packet
+                bool requestFitsInInit = data.Length <= InitDataSize;
+                ReadOnlySpan<byte> dataInInitPacket = requestFitsInInit ? data : data.Slice(0, InitDataSize);
+                ConstructInitPacket(_packetBuffer, channelId, commandByte, dataInInitPacket, data.Length);
+                _hidConnection.SetReport(_packetBuffer);
 
-                byte seq = 0;
-                while (data.Length > ContinuationDataSize)
+                if (!requestFitsInInit)
                 {
-                    _hidConnection.SetReport(ConstructContinuationPacket(channelId, seq, data[..ContinuationDataSize]));
-                    data = data[ContinuationDataSize..];
-                    seq++;
+                    // send continuation request packets if necessary
+                    data = data[InitDataSize..];
+
+                    byte seq = 0;
+                    while (data.Length > ContinuationDataSize)
+                    {
+                        ConstructContinuationPacket(_packetBuffer, channelId, seq, data[..ContinuationDataSize]);
+                        _hidConnection.SetReport(_packetBuffer);
+                        data = data[ContinuationDataSize..];
+                        seq++;
+                    }
+                    ConstructContinuationPacket(_packetBuffer, channelId, seq, data);
+                    _hidConnection.SetReport(_packetBuffer);
                 }
-                _hidConnection.SetReport(ConstructContinuationPacket(channelId, seq, data));
+            }
+            finally
+            {
+                // Request data may be sensitive (for example, a PIN/UV auth token), so don't leave it in the buffer,
+                // even if a SetReport failed part way through the message.
+                Array.Clear(_packetBuffer, 0, PacketSize);
             }
         }
 
@@ -14,6 +14,7 @@
 
 using System;
 using System.Collections.Generic;
+using System.Diagnostics;
 using Yubico.YubiKey.InterIndustry.Commands;
 using Yubico.Core.Iso7816;
 
@@ -41,15 +42,19 @@ namespace Yubico.YubiKey.Pipelines
                 throw new ArgumentNullException(nameof(command));
             }
 
+            using Activity? activity = YubiKeyActivitySource.StartApdu(nameof(ResponseChainingTransform), command);
+
             ResponseApdu response = _pipeline.Invoke(command, commandType, responseType);
 
             // Unless we see that bytes are available, there's nothing for this transform to do.
             if (response.SW1 != SW1Constants.BytesAvailable)
             {
+                YubiKeyActivitySource.SetResponse(activity, response);
                 return response;
             }
 
             var tempBuffer = new List<byte>();
+            int chainLength = 0;
 
             do
             {
@@ -57,15 +62,21 @@ namespace Yubico.YubiKey.Pipelines
 
                 var getResponseCommand = new GetResponseCommand(command, response.SW2);
                 response = _pipeline.Invoke(getResponseCommand.CreateCommandApdu(), commandType, responseType);
+                chainLength++;
             }
             while (response.SW1 == SW1Constants.BytesAvailable);
 
+            YubiKeyMetrics.ResponseChainLength.Record(chainLength, YubiKeyMetrics.CommandTypeTag(commandType));
+
             if (response.SW == SWConstants.Success)
             {
                 tempBuffer.AddRange(response.Data.ToArray());
             }
 
-            return new ResponseApdu(tempBuffer.ToArray(), response.SW);
+            var chainedResponse = new ResponseApdu(tempBuffer.ToArray(), response.SW);
+            YubiKeyActivitySource.SetResponse(activity, chainedResponse);
+
+            return chainedResponse;
         }
 
         public void Setup() => _pipeline.Setup();
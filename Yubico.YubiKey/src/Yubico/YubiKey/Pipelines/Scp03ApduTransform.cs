@@ -13,6 +13,7 @@
 // limitations under the License.
 
 using System;
+using System.Diagnostics;
 using System.Security.Cryptography;
 using Yubico.YubiKey.Scp03.Commands;
 using Yubico.YubiKey.Scp03;
@@ -30,7 +31,7 @@ namespace Yubico.YubiKey.Pipelines
     ///
     /// Requires pre-shared <see cref="StaticKeys"/>.
     /// </remarks>
-    internal class Scp03ApduTransform : IApduTransform
+    internal sealed class Scp03ApduTransform : IApduTransform, IDisposable
     {
         private readonly IApduTransform _pipeline;
         private readonly Session _session;
@@ -81,10 +82,13 @@ namespace Yubico.YubiKey.Pipelines
 
         public ResponseApdu Invoke(CommandApdu command, Type commandType, Type responseType)
         {
+            using Activity? activity = YubiKeyActivitySource.StartApdu(nameof(Scp03ApduTransform), command);
+
             // Encode command
             CommandApdu encodedCommand = _session.EncodeCommand(command);
             // Pass along the encoded command
             ResponseApdu response = _pipeline.Invoke(encodedCommand, commandType, responseType);
+            YubiKeyActivitySource.SetResponse(activity, response);
             // Decode response and return it
             
             // Special carve out for SelectApplication here, since there will be nothing to decode
@@ -96,7 +100,13 @@ namespace Yubico.YubiKey.Pipelines
             return _session.DecodeResponse(response);
         }
 
-        public void Cleanup() => _pipeline.Cleanup();
+        public void Cleanup()
+        {
+            _session.Dispose();
+            _pipeline.Cleanup();
+        }
+
+        public void Dispose() => _session.Dispose();
 
         private void PerformInitializeUpdate(byte[] hostChallenge)
         {
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 using System;
+using System.Diagnostics;
 using System.Globalization;
 using System.Security;
 using Yubico.YubiKey.Piv.Commands;
@@ -153,6 +154,8 @@ namespace Yubico.YubiKey.Piv
         /// </exception>
         public byte[] Sign(byte slotNumber, ReadOnlyMemory<byte> dataToSign)
         {
+            using Activity? activity = YubiKeyActivitySource.Source.StartActivity("PivSession.Sign");
+
             // This will verify the slot number and dataToSign length. If one or
             // both are incorrect, the call will throw an exception.
             var signCommand = new AuthenticateSignCommand(dataToSign, slotNumber);
@@ -260,6 +263,8 @@ namespace Yubico.YubiKey.Piv
         /// </exception>
         public byte[] Decrypt(byte slotNumber, ReadOnlyMemory<byte> dataToDecrypt)
         {
+            using Activity? activity = YubiKeyActivitySource.Source.StartActivity("PivSession.Decrypt");
+
             // This will verify the slot number and dataToDecrypt length. If one
             // or both are incorrect, the call will throw an exception.
             var decryptCommand = new AuthenticateDecryptCommand(dataToDecrypt, slotNumber);
@@ -359,6 +364,8 @@ namespace Yubico.YubiKey.Piv
         /// </exception>
         public byte[] KeyAgree(byte slotNumber, PivPublicKey correspondentPublicKey)
         {
+            using Activity? activity = YubiKeyActivitySource.Source.StartActivity("PivSession.KeyAgree");
+
             if (correspondentPublicKey is null)
             {
                 throw new ArgumentNullException(nameof(correspondentPublicKey));
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 using System;
+using System.Diagnostics;
 using System.Security;
 using System.Globalization;
 using Yubico.YubiKey.Piv.Commands;
@@ -1022,6 +1023,8 @@ namespace Yubico.YubiKey.Piv
             ReadOnlySpan<byte> mgmtKey,
             PivAlgorithm algorithm)
         {
+            using Activity? activity = YubiKeyActivitySource.Source.StartActivity("PivSession.AuthenticateManagementKey");
+
             var initCommand = new InitializeAuthenticateManagementKeyCommand(mutualAuthentication, algorithm);
             InitializeAuthenticateManagementKeyResponse initResponse = Connection.SendCommand(initCommand);
 
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 using System;
+using System.Diagnostics;
 using System.Security;
 using System.Globalization;
 using System.Security.Cryptography;
@@ -278,6 +279,8 @@ namespace Yubico.YubiKey.Piv
         /// </exception>
         public bool TryVerifyPin(ReadOnlyMemory<byte> pin, out int? retriesRemaining)
         {
+            using Activity? activity = YubiKeyActivitySource.Source.StartActivity("PivSession.VerifyPin");
+
             _log.LogInformation("Try to verify the PIV PIN with supplied PIN.");
             retriesRemaining = null;
             PinVerified = false;
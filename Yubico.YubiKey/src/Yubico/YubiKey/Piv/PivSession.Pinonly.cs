@@ -19,6 +19,7 @@ using System.Security.Cryptography;
 using Yubico.YubiKey.Piv.Commands;
 using Yubico.YubiKey.Piv.Objects;
 using Yubico.YubiKey.Cryptography;
+using Yubico.Core.Buffers;
 using Yubico.Core.Logging;
 
 namespace Yubico.YubiKey.Piv
@@ -1224,22 +1225,23 @@ namespace Yubico.YubiKey.Piv
             return true;
         }
 
-        // This class keeps track of the key data and its length.
-        private sealed class MgmtKeyHolder : IDisposable
+        // This class keeps track of the key data and its length. Once it is
+        // disposed, KeyData is empty and the buffer is back in the pool.
+        internal sealed class MgmtKeyHolder : IDisposable
         {
             // This property will be the key data, of the appropriate length.
             public Memory<byte> KeyData { get; private set; }
 
             private const int PinDerivedSaltLength = 16;
             private const int MaxKeyLength = 32;
-            private readonly byte[] _keyBuffer = new byte[MaxKeyLength];
-            private readonly Memory<byte> _keyData;
+            private readonly SecureBuffer _keyBuffer = SecureBufferPool.Shared.Rent(MaxKeyLength);
+            private Memory<byte> _keyData;
 
             private bool _disposed;
 
             public MgmtKeyHolder()
             {
-                _keyData = new Memory<byte>(_keyBuffer);
+                _keyData = _keyBuffer.Memory;
                 KeyData = _keyData;
 
                 _disposed = false;
@@ -1260,6 +1262,8 @@ namespace Yubico.YubiKey.Piv
                     _ => 24,
                 };
 
+                ThrowIfDisposed();
+
                 if (!newData.IsEmpty)
                 {
                     newData.CopyTo(_keyData);
@@ -1267,10 +1271,11 @@ namespace Yubico.YubiKey.Piv
                 else
                 {
                     using RandomNumberGenerator randomObject = CryptographyProviders.RngCreator();
+                    ArraySegment<byte> keySegment = _keyBuffer.Segment;
 
                     do
                     {
-                        randomObject.GetBytes(_keyBuffer, 0, newLength);
+                        randomObject.GetBytes(keySegment.Array!, keySegment.Offset, newLength);
                     } while (IsKeyDataWeak(algorithm));
                 }
 
@@ -1285,6 +1290,8 @@ namespace Yubico.YubiKey.Piv
             public ReadOnlyMemory<byte> DeriveKeyData(
                 ReadOnlyMemory<byte> pin, ReadOnlyMemory<byte> salt, PivAlgorithm algorithm)
             {
+                ThrowIfDisposed();
+
                 ReadOnlyMemory<byte> returnValue = salt;
 
                 if (salt.Length != PinDerivedSaltLength)
@@ -1319,7 +1326,13 @@ namespace Yubico.YubiKey.Piv
                     _ => 24,
                 };
 
+                ThrowIfDisposed();
+
                 byte[] result = Array.Empty<byte>();
+
+                // Rfc2898DeriveBytes only takes the password as an array of its
+                // exact length, so it gets a copy that is zeroed as soon as the
+                // key is derived.
                 byte[] pinData = pin.ToArray();
                 try
                 {
@@ -1328,13 +1341,13 @@ namespace Yubico.YubiKey.Piv
                     using var kdf = new Rfc2898DeriveBytes(pinData, saltData, 10000);
                     result = kdf.GetBytes(newLength);
 #pragma warning restore CA5379, CA5387
-                    Array.Copy(result, _keyBuffer, newLength);
+                    result.AsSpan(0, newLength).CopyTo(_keyData.Span);
                     KeyData = _keyData.Slice(0, newLength);
                 }
                 finally
                 {
-                    CryptographicOperations.ZeroMemory(result);
                     CryptographicOperations.ZeroMemory(pinData);
+                    CryptographicOperations.ZeroMemory(result);
                 }
             }
 
@@ -1364,9 +1377,21 @@ namespace Yubico.YubiKey.Piv
                     return;
                 }
 
-                CryptographicOperations.ZeroMemory(_keyData.Span);
+                // The buffer goes back to the pool, where another caller may
+                // rent it, so drop every view of it first.
+                KeyData = Memory<byte>.Empty;
+                _keyData = Memory<byte>.Empty;
+                _keyBuffer.Dispose();
                 _disposed = true;
             }
+
+            private void ThrowIfDisposed()
+            {
+                if (_disposed)
+                {
+                    throw new ObjectDisposedException(nameof(MgmtKeyHolder));
+                }
+            }
         }
 
         private sealed class SpecialKeyCollector : IDisposable
@@ -1380,8 +1405,8 @@ namespace Yubico.YubiKey.Piv
 
             private const int MaxPinLength = 8;
             private int _pinLength;
-            private readonly Memory<byte> _pinMemory;
-            private readonly byte[] _pinData = new byte[MaxPinLength];
+            private Memory<byte> _pinMemory;
+            private readonly SecureBuffer _pinData = SecureBufferPool.Shared.Rent(MaxPinLength);
 
             private bool _disposed;
 
@@ -1401,7 +1426,7 @@ namespace Yubico.YubiKey.Piv
                 _currentKey.SetKeyData(_defaultKey, PivAlgorithm.TripleDes);
 
                 PinCollected = false;
-                _pinMemory = new Memory<byte>(_pinData);
+                _pinMemory = _pinData.Memory;
                 _pinLength = 0;
 
                 _disposed = false;
@@ -1689,7 +1714,9 @@ namespace Yubico.YubiKey.Piv
 
                 _currentKey.Dispose();
                 _newKey.Dispose();
-                CryptographicOperations.ZeroMemory(_pinMemory.Span);
+                _pinMemory = Memory<byte>.Empty;
+                _pinLength = 0;
+                _pinData.Dispose();
                 _disposed = true;
             }
         }
@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+using System;
 using System.Buffers.Binary;
 using Yubico.YubiKey.Cryptography;
 
@@ -19,7 +20,7 @@ namespace Yubico.YubiKey.Scp03
 {
     internal static class ChannelEncryption
     {
-        public static byte[] EncryptData(byte[] payload, byte[] key, int encryptionCounter)
+        public static byte[] EncryptData(byte[] payload, ReadOnlySpan<byte> key, int encryptionCounter)
         {
             // NB: Could skip this if the payload is empty (rather than sending a 16-byte encrypted '0x800000...' payload
             byte[] countBytes = new byte[sizeof(int)];
@@ -35,7 +36,7 @@ namespace Yubico.YubiKey.Scp03
             return encryptedData;
         }
 
-        public static byte[] DecryptData(byte[] payload, byte[] key, int encryptionCounter)
+        public static byte[] DecryptData(byte[] payload, ReadOnlySpan<byte> key, int encryptionCounter)
         {
             byte[] countBytes = new byte[sizeof(int)];
             BinaryPrimitives.WriteInt32BigEndian(countBytes, encryptionCounter);
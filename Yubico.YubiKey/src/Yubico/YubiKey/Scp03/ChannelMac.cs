@@ -23,7 +23,7 @@ namespace Yubico.YubiKey.Scp03
 {
     internal static class ChannelMac
     {
-        public static (CommandApdu macdApdu, byte[] newMacChainingValue) MacApdu(CommandApdu apdu, byte[] macKey, byte[] macChainingValue)
+        public static (CommandApdu macdApdu, byte[] newMacChainingValue) MacApdu(CommandApdu apdu, ReadOnlySpan<byte> macKey, byte[] macChainingValue)
         {
             if (macChainingValue.Length != 16)
             {
@@ -42,7 +42,7 @@ namespace Yubico.YubiKey.Scp03
             return (AddDataToApdu(apdu, macChainingValue.Take(8).ToArray()), macChainingValue);
         }
 
-        public static void VerifyRmac(byte[] response, byte[] rmacKey, byte[] macChainingValue)
+        public static void VerifyRmac(byte[] response, ReadOnlySpan<byte> rmacKey, byte[] macChainingValue)
         {
             if (response.Length < 8)
             {
@@ -12,7 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-using System.Linq;
+using System;
+using Yubico.Core.Buffers;
 using Yubico.YubiKey.Cryptography;
 
 namespace Yubico.YubiKey.Scp03
@@ -25,7 +26,7 @@ namespace Yubico.YubiKey.Scp03
         public const byte DDC_CARD_CRYPTOGRAM = 0x00;
         public const byte DDC_HOST_CRYPTOGRAM = 0x01;
 
-        public static byte[] Derive(byte dataDerivationConstant, byte outputLen, byte[] kdfKey, byte[] hostChallenge, byte[] cardChallenge)
+        public static byte[] Derive(byte dataDerivationConstant, byte outputLen, ReadOnlySpan<byte> kdfKey, byte[] hostChallenge, byte[] cardChallenge)
         {
             byte[] macInp = new byte[32];
             macInp[11] = dataDerivationConstant;
@@ -43,14 +44,19 @@ namespace Yubico.YubiKey.Scp03
             return Cmac.AesCmac(kdfKey, macInp);
         }
 
-        public static byte[] DeriveCryptogram(byte dataDerivationConstant, byte[] key, byte[] hostChallenge, byte[] cardChallenge) =>
+        public static byte[] DeriveCryptogram(byte dataDerivationConstant, ReadOnlySpan<byte> key, byte[] hostChallenge, byte[] cardChallenge) =>
             Derive(dataDerivationConstant, 0x40, key, hostChallenge, cardChallenge);
 
         public static SessionKeys DeriveSessionKeysFromStaticKeys(StaticKeys staticKeys, byte[] hostChallenge, byte[] cardChallenge)
         {
-            byte[] SMAC = Derive(DDC_SMAC, 0x80, staticKeys.ChannelMacKey.ToArray(), hostChallenge, cardChallenge);
-            byte[] SENC = Derive(DDC_SENC, 0x80, staticKeys.ChannelEncryptionKey.ToArray(), hostChallenge, cardChallenge);
-            byte[] SRMAC = Derive(DDC_SRMAC, 0x80, staticKeys.ChannelMacKey.ToArray(), hostChallenge, cardChallenge);
+            using SecureBuffer macKey = SecureBufferPool.Shared.Rent(staticKeys.ChannelMacKey.Length);
+            using SecureBuffer encryptionKey = SecureBufferPool.Shared.Rent(staticKeys.ChannelEncryptionKey.Length);
+            staticKeys.ChannelMacKey.Span.CopyTo(macKey.Span);
+            staticKeys.ChannelEncryptionKey.Span.CopyTo(encryptionKey.Span);
+
+            byte[] SMAC = Derive(DDC_SMAC, 0x80, macKey.Span, hostChallenge, cardChallenge);
+            byte[] SENC = Derive(DDC_SENC, 0x80, encryptionKey.Span, hostChallenge, cardChallenge);
+            byte[] SRMAC = Derive(DDC_SRMAC, 0x80, macKey.Span, hostChallenge, cardChallenge);
             return new SessionKeys(SMAC, SENC, SRMAC);
         }
     }
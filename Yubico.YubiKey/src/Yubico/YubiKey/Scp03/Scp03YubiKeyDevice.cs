@@ -25,6 +25,7 @@ namespace Yubico.YubiKey
             : base(device.GetSmartCardDevice(), null, null, device)
         {
             StaticKeys = staticKeys;
+            SmartCardConnectionOptions = device.SmartCardConnectionOptions;
         }
 
         public override bool TryConnect(
@@ -38,7 +39,7 @@ namespace Yubico.YubiKey
                 return false;
             }
 
-            connection = new CcidConnection(GetSmartCardDevice(), application, StaticKeys);
+            connection = new CcidConnection(GetSmartCardDevice(), application, StaticKeys, SmartCardConnectionOptions);
 
             return true;
         }
@@ -54,7 +55,7 @@ namespace Yubico.YubiKey
                 return false;
             }
 
-            connection = new CcidConnection(GetSmartCardDevice(), applicationId, StaticKeys);
+            connection = new CcidConnection(GetSmartCardDevice(), applicationId, StaticKeys, SmartCardConnectionOptions);
 
             return true;
         }
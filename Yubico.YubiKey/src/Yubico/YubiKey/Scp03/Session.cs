@@ -20,7 +20,7 @@ using Yubico.Core.Iso7816;
 
 namespace Yubico.YubiKey.Scp03
 {
-    internal class Session
+    internal sealed class Session : IDisposable
     {
         private SessionKeys? _sessionKeys;
         private byte[]? _hostChallenge;
@@ -99,6 +99,7 @@ namespace Yubico.YubiKey.Scp03
             _keyInfo = initializeUpdateResponse.KeyInfo.ToArray();
             byte[] cardChallenge = initializeUpdateResponse.CardChallenge.ToArray();
             byte[] cardCryptogram = initializeUpdateResponse.CardCryptogram.ToArray();
+            _sessionKeys?.Dispose();
             _sessionKeys = Derivation.DeriveSessionKeysFromStaticKeys(staticKeys, _hostChallenge, cardChallenge);
 
             // check supplied card cryptogram
@@ -235,5 +236,13 @@ namespace Yubico.YubiKey.Scp03
             fullDecryptedResponse[decryptedData.Length + 1] = response.SW2;
             return new ResponseApdu(fullDecryptedResponse);
         }
+
+        // Zeroes the session keys and returns them to the secure pool. The
+        // session cannot encode or decode anything afterwards.
+        public void Dispose()
+        {
+            _sessionKeys?.Dispose();
+            _sessionKeys = null;
+        }
     }
 }
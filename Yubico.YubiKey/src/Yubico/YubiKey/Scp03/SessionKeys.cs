@@ -12,19 +12,48 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+using System;
+using System.Security.Cryptography;
+using Yubico.Core.Buffers;
+
 namespace Yubico.YubiKey.Scp03
 {
-    internal class SessionKeys
+    // The session keys live in buffers from the secure pool for as long as the
+    // session is open, and are zeroed when it is disposed. Reading a key after
+    // that throws ObjectDisposedException.
+    internal sealed class SessionKeys : IDisposable
     {
-        public byte[] SessionMacKey { get; set; }
-        public byte[] SessionEncryptionKey { get; set; }
-        public byte[] SessionRmacKey { get; set; }
+        private readonly SecureBuffer _sessionMacKey;
+        private readonly SecureBuffer _sessionEncryptionKey;
+        private readonly SecureBuffer _sessionRmacKey;
+
+        public ReadOnlySpan<byte> SessionMacKey => _sessionMacKey.Span;
+        public ReadOnlySpan<byte> SessionEncryptionKey => _sessionEncryptionKey.Span;
+        public ReadOnlySpan<byte> SessionRmacKey => _sessionRmacKey.Span;
 
+        // The keys are copied into secure buffers, and the arrays passed in are
+        // zeroed.
         public SessionKeys(byte[] sessionMacKey, byte[] sessionEncryptionKey, byte[] sessionRmacKey)
         {
-            SessionMacKey = sessionMacKey;
-            SessionEncryptionKey = sessionEncryptionKey;
-            SessionRmacKey = sessionRmacKey;
+            _sessionMacKey = TakeKey(sessionMacKey);
+            _sessionEncryptionKey = TakeKey(sessionEncryptionKey);
+            _sessionRmacKey = TakeKey(sessionRmacKey);
+        }
+
+        public void Dispose()
+        {
+            _sessionMacKey.Dispose();
+            _sessionEncryptionKey.Dispose();
+            _sessionRmacKey.Dispose();
+        }
+
+        private static SecureBuffer TakeKey(byte[] key)
+        {
+            SecureBuffer buffer = SecureBufferPool.Shared.Rent(key.Length);
+            key.CopyTo(buffer.Span);
+            CryptographicOperations.ZeroMemory(key);
+
+            return buffer;
         }
     }
 }
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 using System;
+using System.Collections.Generic;
 using System.Diagnostics;
 using System.Diagnostics.CodeAnalysis;
 using System.Globalization;
@@ -560,6 +561,89 @@ namespace Yubico.YubiKey.U2f
             return response.StatusWord == SWConstants.ConditionsNotSatisfied;
         }
 
+        /// <summary>
+        /// Verify a list of key handles, stopping at the first one that is a
+        /// YubiKey handle matching its <c>applicationId</c> and the
+        /// <c>clientDataHash</c>.
+        /// </summary>
+        /// <remarks>
+        /// A relying party that has registered several U2F credentials for one
+        /// account does not know which of them, if any, belongs to the YubiKey
+        /// currently in use. Rather than calling
+        /// <see cref="VerifyKeyHandle"/> once per candidate, call this method
+        /// with all of them.
+        /// <para>
+        /// All the checks are sent over this session's connection, so they
+        /// share a single CTAPHID channel, and they reuse a single command
+        /// object. Every candidate is validated before the first check is
+        /// sent, so a malformed candidate never leaves the batch half done.
+        /// The candidates are checked in order and no further commands are
+        /// sent once a match is found.
+        /// </para>
+        /// <para>
+        /// As with <see cref="VerifyKeyHandle"/>, a candidate that does not
+        /// belong to the YubiKey, or that does not match its application ID,
+        /// simply does not match.
+        /// </para>
+        /// </remarks>
+        /// <param name="clientDataHash">
+        /// A SHA-256 hash of the client data. See
+        /// <see cref="VerifyKeyHandle"/> for more information.
+        /// </param>
+        /// <param name="candidates">
+        /// The application ID (origin data) and key handle pairs to check, in
+        /// the order in which they should be tried.
+        /// </param>
+        /// <returns>
+        /// The index within <c>candidates</c> of the first key handle that
+        /// matches, or -1 if none of them does.
+        /// </returns>
+        /// <exception cref="ArgumentNullException">
+        /// The <c>candidates</c> argument is null.
+        /// </exception>
+        /// <exception cref="ArgumentException">
+        /// The <c>clientDataHash</c>, or an application ID or key handle, is
+        /// not the correct length.
+        /// </exception>
+        public int VerifyKeyHandles(
+            ReadOnlyMemory<byte> clientDataHash,
+            IReadOnlyList<(ReadOnlyMemory<byte> ApplicationId, ReadOnlyMemory<byte> KeyHandle)> candidates)
+        {
+            if (candidates is null)
+            {
+                throw new ArgumentNullException(nameof(candidates));
+            }
+
+            var command = new AuthenticateCommand()
+            {
+                ControlByte = U2fAuthenticationType.CheckOnly,
+                ClientDataHash = clientDataHash,
+            };
+
+            // The command's setters check the lengths, so run every candidate
+            // through them before anything is sent.
+            for (int index = 0; index < candidates.Count; index++)
+            {
+                command.ApplicationId = candidates[index].ApplicationId;
+                command.KeyHandle = candidates[index].KeyHandle;
+            }
+
+            for (int index = 0; index < candidates.Count; index++)
+            {
+                command.ApplicationId = candidates[index].ApplicationId;
+                command.KeyHandle = candidates[index].KeyHandle;
+
+                AuthenticateResponse response = Connection.SendCommand(command);
+
+                if (response.StatusWord == SWConstants.ConditionsNotSatisfied)
+                {
+                    return index;
+                }
+            }
+
+            return -1;
+        }
+
         /// <summary>
         /// Authenticates a credential. Throw an exception if the method is not
         /// able to perform the operation.
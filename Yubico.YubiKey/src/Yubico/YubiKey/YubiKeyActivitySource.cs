@@ -0,0 +1,77 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System.Diagnostics;
+using System.Globalization;
+using Yubico.Core.Iso7816;
+
+namespace Yubico.YubiKey
+{
+    /// <summary>
+    /// The source of the "Yubico.YubiKey" tracing spans.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Spans nest in the same order a command travels: a session operation such as <c>PivSession.Sign</c>, then one
+    /// span per command sent over the connection, then one per pipeline transform, and finally the native transmit
+    /// spans emitted by the "Yubico.Core" source. Listen to both sources to see the complete picture.
+    /// </para>
+    /// <para>
+    /// <see cref="ActivitySource.StartActivity(string, ActivityKind)"/> returns <c>null</c> when nothing is listening,
+    /// so every tag is set through a null check and costs nothing in that case.
+    /// </para>
+    /// <para>
+    /// The APDU length tags count the data field only, not the header or the status word.
+    /// </para>
+    /// </remarks>
+    internal static class YubiKeyActivitySource
+    {
+        public const string Name = "Yubico.YubiKey";
+
+        public const string CommandLengthTag = "yubikey.apdu.command.length";
+        public const string ResponseLengthTag = "yubikey.apdu.response.length";
+        public const string StatusWordTag = "yubikey.apdu.sw";
+
+        public static readonly ActivitySource Source = new ActivitySource(Name);
+
+        /// <summary>
+        /// Starts a span covering one trip of <paramref name="command"/> through a connection or transform.
+        /// </summary>
+        /// <param name="name">The name of the span.</param>
+        /// <param name="command">The APDU being sent.</param>
+        /// <returns>The new activity, or <c>null</c> if no one is listening.</returns>
+        public static Activity? StartApdu(string name, CommandApdu command)
+        {
+            Activity? activity = Source.StartActivity(name);
+
+            _ = activity?.SetTag(CommandLengthTag, command.Data.Length);
+
+            return activity;
+        }
+
+        /// <summary>
+        /// Tags a span started by <see cref="StartApdu"/> with the response that came back.
+        /// </summary>
+        public static void SetResponse(Activity? activity, ResponseApdu response)
+        {
+            if (activity is null)
+            {
+                return;
+            }
+
+            _ = activity.SetTag(ResponseLengthTag, response.Data.Length);
+            _ = activity.SetTag(StatusWordTag, response.SW.ToString("X4", CultureInfo.InvariantCulture));
+        }
+    }
+}
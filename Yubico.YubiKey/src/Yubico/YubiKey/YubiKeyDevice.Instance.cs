@@ -76,6 +76,17 @@ namespace Yubico.YubiKey
 
         internal bool IsNfcDevice { get; private set; }
 
+        /// <summary>
+        /// How smart card connections to this YubiKey are opened, or null to open them shared.
+        /// </summary>
+        /// <remarks>
+        /// Set <see cref="SmartCardConnectionOptions.Exclusive"/> on a YubiKey that no other application uses, such as
+        /// a dedicated signing key, to skip the PC/SC transaction that otherwise brackets every command. While such a
+        /// connection is open, any other attempt to connect to the YubiKey over smart card fails, including the ones
+        /// the SDK makes itself to read device information.
+        /// </remarks>
+        public SmartCardConnectionOptions? SmartCardConnectionOptions { get; set; }
+
         private ISmartCardDevice? _smartCardDevice;
         private IHidDevice? _hidFidoDevice;
         private IHidDevice? _hidKeyboardDevice;
@@ -261,7 +272,7 @@ namespace Yubico.YubiKey
                 return false;
             }
 
-            connection = new CcidConnection(_smartCardDevice, application);
+            connection = new CcidConnection(_smartCardDevice, application, SmartCardConnectionOptions);
 
             return true;
         }
@@ -278,7 +289,7 @@ namespace Yubico.YubiKey
                 return false;
             }
 
-            connection = new CcidConnection(_smartCardDevice, applicationId);
+            connection = new CcidConnection(_smartCardDevice, applicationId, SmartCardConnectionOptions);
 
             return true;
         }
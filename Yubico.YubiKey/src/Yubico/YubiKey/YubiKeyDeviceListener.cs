@@ -14,6 +14,7 @@
 
 using System;
 using System.Collections.Generic;
+using System.Diagnostics;
 using System.Linq;
 using System.Threading;
 using Yubico.Core.Devices;
@@ -21,6 +22,7 @@ using Yubico.Core.Devices.Hid;
 using Yubico.Core.Devices.SmartCard;
 using Yubico.Core.Logging;
 using Yubico.YubiKey.DeviceExtensions;
+using Yubico.YubiKey.Pipelines;
 
 namespace Yubico.YubiKey
 {
@@ -44,15 +46,67 @@ namespace Yubico.YubiKey
         /// </summary>
         public static YubiKeyDeviceListener Instance => _lazyInstance.Value;
 
+        /// <summary>
+        /// The filter applied to the smart card readers that <see cref="Instance"/> watches, or null to watch every
+        /// reader.
+        /// </summary>
+        /// <remarks>
+        /// The filter is read once, when <see cref="Instance"/> is first accessed. Set it before then. On systems with
+        /// many readers that can never hold a YubiKey, such as terminal servers with redirected or virtual readers, a
+        /// filter from <see cref="CreateYubiKeyReaderFilter"/> keeps the card activity in those readers from waking
+        /// the listener.
+        /// </remarks>
+        /// <exception cref="InvalidOperationException">
+        /// The filter is set after <see cref="Instance"/> has been created.
+        /// </exception>
+        public static SmartCardReaderFilter? ReaderFilter
+        {
+            get
+            {
+                lock (_readerFilterLock)
+                {
+                    return _readerFilter;
+                }
+            }
+            set
+            {
+                lock (_readerFilterLock)
+                {
+                    if (_readerFilterTaken)
+                    {
+                        throw new InvalidOperationException(ExceptionMessages.ReaderFilterAfterListenerCreated);
+                    }
+
+                    _readerFilter = value;
+                }
+            }
+        }
+
+        /// <summary>
+        /// Creates a <see cref="SmartCardReaderFilter"/> that reports only cards whose ATR is
+        /// one of the <see cref="ProductAtrs.AllYubiKeys"/>.
+        /// </summary>
+        /// <param name="readerNamePatterns">
+        /// Patterns that a reader's name must match for the reader to be watched, for example <c>"Yubico*"</c>. Leave
+        /// empty to watch every reader, which is needed to see YubiKeys presented to NFC readers.
+        /// </param>
+        /// <returns>The new filter.</returns>
+        public static SmartCardReaderFilter CreateYubiKeyReaderFilter(params string[] readerNamePatterns) =>
+            new SmartCardReaderFilter(readerNamePatterns, ProductAtrs.AllYubiKeys);
+
+        private static readonly object _readerFilterLock = new object();
+        private static SmartCardReaderFilter? _readerFilter;
+        private static bool _readerFilterTaken;
+
         private static readonly Lazy<YubiKeyDeviceListener> _lazyInstance =
             new Lazy<YubiKeyDeviceListener>(() => new YubiKeyDeviceListener());
 
-        private static readonly ReaderWriterLockSlim RwLock = new ReaderWriterLockSlim(LockRecursionPolicy.NoRecursion);
-
+        private readonly ReaderWriterLockSlim _rwLock = new ReaderWriterLockSlim(LockRecursionPolicy.NoRecursion);
         private readonly Logger _log = Log.GetLogger();
         private readonly Dictionary<IYubiKeyDevice, bool> _internalCache = new Dictionary<IYubiKeyDevice, bool>();
-        private readonly HidDeviceListener _hidListener = HidDeviceListener.Create();
-        private readonly SmartCardDeviceListener _smartCardListener = SmartCardDeviceListener.Create();
+        private readonly HidDeviceListener? _hidListener;
+        private readonly SmartCardDeviceListener? _smartCardListener;
+        private readonly Func<List<IDevice>> _deviceSource;
 
         private readonly Thread? _listenerThread;
         private readonly bool _isListening;
@@ -61,6 +115,10 @@ namespace Yubico.YubiKey
         {
             _log.LogInformation("Creating YubiKeyDeviceListener instance.");
 
+            _hidListener = HidDeviceListener.Create();
+            _smartCardListener = SmartCardDeviceListener.Create(TakeReaderFilter());
+            _deviceSource = GetDevices;
+
             _listenerThread = new Thread(ListenForChanges) { IsBackground = true };
             _isListening = true;
 
@@ -70,14 +128,39 @@ namespace Yubico.YubiKey
             _listenerThread.Start();
         }
 
+        /// <summary>
+        /// Creates a listener that takes its devices from <paramref name="deviceSource"/> instead of the platform, and
+        /// that updates only when <see cref="Update"/> is called. This lets the benchmarks and tests run the cache
+        /// reconciliation against simulated devices.
+        /// </summary>
+        internal YubiKeyDeviceListener(Func<List<IDevice>> deviceSource)
+        {
+            _deviceSource = deviceSource;
+        }
+
         internal List<IYubiKeyDevice> GetAll() => _internalCache.Keys.ToList();
 
+        // Returns the filter for the shared listener and refuses any later change, which would otherwise be ignored.
+        internal static SmartCardReaderFilter? TakeReaderFilter()
+        {
+            lock (_readerFilterLock)
+            {
+                _readerFilterTaken = true;
+                return _readerFilter;
+            }
+        }
+
         private void ListenForChanges()
         {
             using var updateEvent = new ManualResetEvent(false);
 
             _log.LogInformation("YubiKey device listener thread started. ThreadID is {ThreadID}.", Environment.CurrentManagedThreadId);
 
+            if (_smartCardListener is null || _hidListener is null)
+            {
+                return;
+            }
+
             _smartCardListener.Arrived += (s, e) =>
             {
                 _log.LogInformation("Arrival of smart card {SmartCard} is triggering update.", e.Device);
@@ -99,6 +182,12 @@ namespace Yubico.YubiKey
             _hidListener.Removed += (s, e) =>
             {
                 _log.LogInformation("Removal of HID {HidDevice} is triggering update.", e.Device);
+
+                if (!(e.Device is null))
+                {
+                    CtapHidChannelRegistry.Invalidate(e.Device.Path);
+                }
+
                 _ = updateEvent.Set();
             };
 
@@ -116,14 +205,16 @@ namespace Yubico.YubiKey
             GC.KeepAlive(updateEvent);
         }
 
-        private void Update()
+        internal void Update()
         {
-            RwLock.EnterWriteLock();
+            long startTimestamp = YubiKeyMetrics.ListenerUpdateDuration.Enabled ? Stopwatch.GetTimestamp() : 0;
+
+            _rwLock.EnterWriteLock();
             _log.LogInformation("Entering write-lock.");
 
             ResetCacheMarkers();
 
-            List<IDevice> devicesToProcess = GetDevices();
+            List<IDevice> devicesToProcess = _deviceSource();
 
             _log.LogInformation("Cache currently aware of {Count} YubiKeys.", _internalCache.Count);
 
@@ -191,7 +282,12 @@ namespace Yubico.YubiKey
                 OnDeviceArrived(new YubiKeyDeviceEventArgs(addedKey));
             }
 
-            RwLock.ExitWriteLock();
+            _rwLock.ExitWriteLock();
+
+            if (startTimestamp != 0)
+            {
+                YubiKeyMetrics.ListenerUpdateDuration.Record(YubiKeyMetrics.ElapsedMilliseconds(startTimestamp));
+            }
         }
 
         private List<IDevice> GetDevices()
@@ -332,7 +428,7 @@ namespace Yubico.YubiKey
             {
                 if (disposing)
                 {
-                    RwLock.Dispose();
+                    _rwLock.Dispose();
                 }
                 _disposedValue = true;
             }
@@ -0,0 +1,370 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Threading;
+using Yubico.Core.Devices.SmartCard;
+using Yubico.Core.Logging;
+
+namespace Yubico.YubiKey
+{
+    /// <summary>
+    /// Keeps the smart cards of designated YubiKeys powered, so that the first command after a quiet period does not
+    /// pay for a cold reset.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// The smart card service powers down a card once no application has it open. The next connection then finds the
+    /// card cold, and has to wait for it to power up and re-select its application. This shows up as a latency spike
+    /// on whichever command happens to come first. This class holds a shared connection to each YubiKey added to it,
+    /// so the card stays open between the application's own connections. It never begins a transaction, reconnects or
+    /// sends an APDU on that connection, so it cannot reset the card or get in the way of the application.
+    /// </para>
+    /// <para>
+    /// Shortly before each idle threshold it reads the status of every held connection, which is a call to the smart
+    /// card service that leaves the card alone. A connection whose card has been removed or reset is closed, and a new
+    /// one is opened as soon as the card is back. The results are counted by the
+    /// "yubikey.smartcard.keep_warm.ready_checks" and "yubikey.smartcard.keep_warm.not_ready_checks" instruments of
+    /// the "Yubico.YubiKey" meter. Connections that cannot report a status are held, but not checked.
+    /// </para>
+    /// <para>
+    /// The connections held here share the card with the application's own connections and are checked from a timer
+    /// thread, so a YubiKey whose <see cref="YubiKeyDevice.SmartCardConnectionOptions"/> ask for exclusive access or
+    /// thread affinity cannot be added.
+    /// </para>
+    /// </remarks>
+    public sealed class YubiKeyKeepWarm : IDisposable
+    {
+        private readonly Logger _log = Log.GetLogger();
+        private readonly object _lock = new object();
+        private readonly Dictionary<string, KeptCard> _cards = new Dictionary<string, KeptCard>();
+        private readonly Timer _timer;
+        private readonly TimeSpan _checkInterval;
+        private bool _disposed;
+
+        /// <summary>
+        /// How long the smart card service lets a card sit idle before powering it down.
+        /// </summary>
+        public TimeSpan IdleThreshold { get; }
+
+        /// <summary>
+        /// Creates a scheduler that keeps cards from sitting idle for <paramref name="idleThreshold"/>.
+        /// </summary>
+        /// <param name="idleThreshold">
+        /// How long the smart card service lets a card sit idle before powering it down.
+        /// </param>
+        /// <exception cref="ArgumentOutOfRangeException">
+        /// <paramref name="idleThreshold"/> is not positive.
+        /// </exception>
+        public YubiKeyKeepWarm(TimeSpan idleThreshold)
+        {
+            if (idleThreshold <= TimeSpan.Zero)
+            {
+                throw new ArgumentOutOfRangeException(nameof(idleThreshold));
+            }
+
+            IdleThreshold = idleThreshold;
+
+            // Check a fifth of the threshold early, so that a late timer tick still lands in time.
+            _checkInterval = TimeSpan.FromTicks(idleThreshold.Ticks - (idleThreshold.Ticks / 5));
+            _timer = new Timer(_ => CheckAll(), null, Timeout.InfiniteTimeSpan, Timeout.InfiniteTimeSpan);
+        }
+
+        /// <summary>
+        /// Starts keeping <paramref name="yubiKey"/> warm. Adding a YubiKey that is already kept warm has no effect.
+        /// </summary>
+        /// <param name="yubiKey">A YubiKey with a smart card interface.</param>
+        /// <exception cref="ArgumentNullException">
+        /// <paramref name="yubiKey"/> is null.
+        /// </exception>
+        /// <exception cref="ArgumentException">
+        /// <paramref name="yubiKey"/> has no smart card interface, or is configured for exclusive connections or for
+        /// connections with thread affinity.
+        /// </exception>
+        /// <exception cref="PlatformInterop.SCardException">
+        /// The connection to the YubiKey could not be opened.
+        /// </exception>
+        /// <exception cref="ObjectDisposedException">
+        /// This instance has been disposed.
+        /// </exception>
+        public void Add(IYubiKeyDevice yubiKey)
+        {
+            if (yubiKey is null)
+            {
+                throw new ArgumentNullException(nameof(yubiKey));
+            }
+
+            if (!(yubiKey is YubiKeyDevice device) || !device.HasSmartCard)
+            {
+                throw new ArgumentException(ExceptionMessages.KeepWarmNoSmartCard, nameof(yubiKey));
+            }
+
+            if (device.SmartCardConnectionOptions?.Exclusive == true)
+            {
+                throw new ArgumentException(ExceptionMessages.KeepWarmExclusiveConnection, nameof(yubiKey));
+            }
+
+            if (device.SmartCardConnectionOptions?.ThreadAffinity == true)
+            {
+                throw new ArgumentException(ExceptionMessages.KeepWarmThreadAffinity, nameof(yubiKey));
+            }
+
+            ISmartCardDevice smartCardDevice = device.GetSmartCardDevice();
+
+            lock (_lock)
+            {
+                ThrowIfDisposed();
+
+                if (_cards.ContainsKey(smartCardDevice.Path))
+                {
+                    return;
+                }
+            }
+
+            // Connecting is a call to the smart card service, so it is made outside the lock. If another thread added
+            // the same YubiKey in the meantime, the new connection is the one that gets closed.
+            ISmartCardConnection connection = smartCardDevice.Connect();
+
+            lock (_lock)
+            {
+                if (!_disposed && !_cards.ContainsKey(smartCardDevice.Path))
+                {
+                    _cards.Add(smartCardDevice.Path, new KeptCard(smartCardDevice, connection));
+                    _log.LogInformation("Keeping smart card {Path} warm.", smartCardDevice.Path);
+
+                    if (_cards.Count == 1)
+                    {
+                        _ = _timer.Change(_checkInterval, _checkInterval);
+                    }
+
+                    return;
+                }
+            }
+
+            connection.Dispose();
+            ThrowIfDisposed();
+        }
+
+        /// <summary>
+        /// Stops keeping <paramref name="yubiKey"/> warm, and closes the connection held to it.
+        /// </summary>
+        /// <param name="yubiKey">A YubiKey previously passed to <see cref="Add"/>.</param>
+        /// <returns>True if the YubiKey was being kept warm.</returns>
+        public bool Remove(IYubiKeyDevice yubiKey)
+        {
+            if (!(yubiKey is YubiKeyDevice device) || !device.HasSmartCard)
+            {
+                return false;
+            }
+
+            string path = device.GetSmartCardDevice().Path;
+            ISmartCardConnection? connection;
+
+            lock (_lock)
+            {
+                if (!_cards.TryGetValue(path, out KeptCard card))
+                {
+                    return false;
+                }
+
+                _ = _cards.Remove(path);
+                connection = card.Connection;
+                card.Connection = null;
+
+                if (_cards.Count == 0)
+                {
+                    _ = _timer.Change(Timeout.InfiniteTimeSpan, Timeout.InfiniteTimeSpan);
+                }
+            }
+
+            connection?.Dispose();
+
+            return true;
+        }
+
+        /// <summary>
+        /// Checks every card now. The timer calls this once per check interval.
+        /// </summary>
+        /// <remarks>
+        /// The cards are copied under the lock and checked outside it, so a slow smart card service never holds up
+        /// <see cref="Add"/> or <see cref="Remove"/>. Each check reads the connection's status, and only a card found
+        /// removed or reset costs a reconnect.
+        /// </remarks>
+        internal void CheckAll()
+        {
+            KeyValuePair<string, KeptCard>[] cards;
+
+            lock (_lock)
+            {
+                cards = _cards.ToArray();
+            }
+
+            foreach (KeyValuePair<string, KeptCard> entry in cards)
+            {
+                Check(entry.Key, entry.Value);
+            }
+        }
+
+        private void Check(string path, KeptCard card)
+        {
+            ISmartCardConnection? connection;
+
+            lock (_lock)
+            {
+                connection = card.Connection;
+            }
+
+            if (connection is null)
+            {
+                Reopen(path, card);
+                return;
+            }
+
+            if (!(connection is ISmartCardConnectionStatus statusConnection))
+            {
+                return;
+            }
+
+            try
+            {
+                SmartCardConnectionStatus status = statusConnection.GetStatus();
+
+                if (status.State == SmartCardState.Specific)
+                {
+                    YubiKeyMetrics.KeepWarmReadyChecks.Add(1);
+                    return;
+                }
+
+                _log.LogInformation(
+                    "Smart card {Path} was in state {State} at the keep-warm check.", path, status.State);
+            }
+            catch (Exception e) when (
+                e is PlatformInterop.SCardException
+                || e is PlatformInterop.PlatformApiException
+                || e is InvalidOperationException)
+            {
+                // Most likely the YubiKey was removed or reset, or the connection was closed by Remove while this
+                // round was running. This runs on a timer thread, so nothing may escape.
+                _log.LogInformation(e, "Keep-warm check of smart card {Path} failed.", path);
+            }
+
+            YubiKeyMetrics.KeepWarmNotReadyChecks.Add(1);
+
+            // The handle is dead, and would stay dead even after the YubiKey came back. Close it and start over.
+            lock (_lock)
+            {
+                if (card.Connection != connection)
+                {
+                    return;
+                }
+
+                card.Connection = null;
+            }
+
+            connection.Dispose();
+            Reopen(path, card);
+        }
+
+        private void Reopen(string path, KeptCard card)
+        {
+            ISmartCardConnection connection;
+
+            try
+            {
+                connection = card.Device.Connect();
+            }
+            catch (Exception e) when (
+                e is PlatformInterop.SCardException
+                || e is PlatformInterop.PlatformApiException
+                || e is InvalidOperationException)
+            {
+                // The YubiKey is most likely still out of its reader. The next round tries again.
+                _log.LogDebug(e, "Could not reopen smart card {Path} for keep-warm.", path);
+                return;
+            }
+
+            lock (_lock)
+            {
+                if (!_disposed && _cards.TryGetValue(path, out KeptCard current) && current == card
+                    && card.Connection is null)
+                {
+                    card.Connection = connection;
+                    _log.LogInformation("Reopened smart card {Path} for keep-warm.", path);
+                    return;
+                }
+            }
+
+            connection.Dispose();
+        }
+
+        private void ThrowIfDisposed()
+        {
+            if (_disposed)
+            {
+                throw new ObjectDisposedException(nameof(YubiKeyKeepWarm));
+            }
+        }
+
+        /// <inheritdoc />
+        public void Dispose()
+        {
+            var connections = new List<ISmartCardConnection>();
+
+            lock (_lock)
+            {
+                if (_disposed)
+                {
+                    return;
+                }
+
+                _disposed = true;
+                _timer.Dispose();
+
+                foreach (KeptCard card in _cards.Values)
+                {
+                    if (!(card.Connection is null))
+                    {
+                        connections.Add(card.Connection);
+                        card.Connection = null;
+                    }
+                }
+
+                _cards.Clear();
+            }
+
+            foreach (ISmartCardConnection connection in connections)
+            {
+                connection.Dispose();
+            }
+        }
+
+        // A YubiKey being kept warm. The connection is null while the card is away and has not been reopened yet.
+        // It is only read or written under the lock.
+        private sealed class KeptCard
+        {
+            public ISmartCardDevice Device { get; }
+
+            public ISmartCardConnection? Connection { get; set; }
+
+            public KeptCard(ISmartCardDevice device, ISmartCardConnection connection)
+            {
+                Device = device;
+                Connection = connection;
+            }
+        }
+    }
+}
@@ -0,0 +1,168 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Diagnostics.Metrics;
+
+namespace Yubico.YubiKey
+{
+    /// <summary>
+    /// The instruments the SDK publishes through the "Yubico.YubiKey" <see cref="Meter"/>.
+    /// </summary>
+    /// <remarks>
+    /// <para>
+    /// Applications collect these with any System.Diagnostics.Metrics listener, for example OpenTelemetry or
+    /// `dotnet-counters monitor --counters Yubico.YubiKey`. Nothing needs to be enabled in the SDK itself, and no
+    /// logging is involved.
+    /// </para>
+    /// <para>
+    /// Command instruments are tagged with <see cref="ApplicationTag"/>, <see cref="TransportTag"/>,
+    /// <see cref="CommandTag"/> and <see cref="OutcomeTag"/>. When no listener is attached, recording a measurement costs a field read; the timing
+    /// helpers do not even read the clock.
+    /// </para>
+    /// </remarks>
+    internal static class YubiKeyMetrics
+    {
+        public const string MeterName = "Yubico.YubiKey";
+
+        public const string ApplicationTag = "yubikey.application";
+        public const string TransportTag = "yubikey.transport";
+        public const string CommandTag = "yubikey.command";
+        public const string OutcomeTag = "yubikey.outcome";
+
+        /// <summary>
+        /// The <see cref="OutcomeTag"/> of a command that got a response, whatever its status word.
+        /// </summary>
+        public const string SuccessOutcome = "success";
+
+        /// <summary>
+        /// The <see cref="OutcomeTag"/> of a command whose transport threw before a response arrived.
+        /// </summary>
+        public const string ErrorOutcome = "error";
+
+        private static readonly Meter _meter = new Meter(MeterName);
+
+        /// <summary>
+        /// The number of commands sent through an <see cref="IYubiKeyConnection"/>.
+        /// </summary>
+        public static readonly Counter<long> Commands =
+            _meter.CreateCounter<long>("yubikey.commands", "{command}", "Commands sent to a YubiKey.");
+
+        /// <summary>
+        /// The round trip time of a command, from building its APDU to receiving the complete response.
+        /// </summary>
+        public static readonly Histogram<double> CommandDuration =
+            _meter.CreateHistogram<double>("yubikey.command.duration", "ms", "Time taken by a YubiKey command.");
+
+        /// <summary>
+        /// The number of APDUs a command had to be split into by command chaining.
+        /// </summary>
+        public static readonly Histogram<int> CommandChainLength =
+            _meter.CreateHistogram<int>("yubikey.apdu.command_chain.length", "{apdu}", "APDUs sent per chained command.");
+
+        /// <summary>
+        /// The number of GET RESPONSE APDUs needed to collect a chained response.
+        /// </summary>
+        public static readonly Histogram<int> ResponseChainLength =
+            _meter.CreateHistogram<int>("yubikey.apdu.response_chain.length", "{apdu}", "GET RESPONSE APDUs per chained response.");
+
+        /// <summary>
+        /// The number of times a smart card was found to have been reset and the application had to be re-selected.
+        /// </summary>
+        public static readonly Counter<long> CardResets =
+            _meter.CreateCounter<long>("yubikey.smartcard.resets", "{reset}", "Commands that had to re-select after SCARD_W_RESET_CARD.");
+
+        /// <summary>
+        /// The number of keep-warm checks that found a smart card powered and ready for commands.
+        /// </summary>
+        public static readonly Counter<long> KeepWarmReadyChecks =
+            _meter.CreateCounter<long>("yubikey.smartcard.keep_warm.ready_checks", "{check}", "Keep-warm checks that found the card ready for commands.");
+
+        /// <summary>
+        /// The number of keep-warm checks that found a smart card in any other state, or could not read its state.
+        /// </summary>
+        public static readonly Counter<long> KeepWarmNotReadyChecks =
+            _meter.CreateCounter<long>("yubikey.smartcard.keep_warm.not_ready_checks", "{check}", "Keep-warm checks that found the card not ready, or could not read its state.");
+
+        /// <summary>
+        /// The number of times a CTAPHID channel had to be re-allocated and the request retried.
+        /// </summary>
+        public static readonly Counter<long> CtapHidChannelRetries =
+            _meter.CreateCounter<long>("yubikey.ctaphid.channel_retries", "{retry}", "Requests retried after an invalid CTAPHID channel.");
+
+        /// <summary>
+        /// The number of connection attempts refused because the YubiKey already had an open connection.
+        /// </summary>
+        public static readonly Counter<long> ConnectionsRefused =
+            _meter.CreateCounter<long>("yubikey.connections.refused", "{connection}", "Connections refused by the ConnectionManager.");
+
+        /// <summary>
+        /// The time taken by the device listener to rescan and reconcile its cache.
+        /// </summary>
+        public static readonly Histogram<double> ListenerUpdateDuration =
+            _meter.CreateHistogram<double>("yubikey.listener.update.duration", "ms", "Time taken by a YubiKeyDeviceListener update.");
+
+        /// <summary>
+        /// Captures a start time for <see cref="RecordCommand"/>, or zero if nobody is listening.
+        /// </summary>
+        public static long StartCommand() => CommandDuration.Enabled ? Stopwatch.GetTimestamp() : 0;
+
+        /// <summary>
+        /// Records one command, whether it got a response or failed.
+        /// </summary>
+        /// <param name="application">The application the connection is bound to.</param>
+        /// <param name="transport">The name of the <see cref="Transport"/> the command went over.</param>
+        /// <param name="commandType">The type of the <see cref="IYubiKeyCommand{TResponse}"/>.</param>
+        /// <param name="outcome"><see cref="SuccessOutcome"/> or <see cref="ErrorOutcome"/>.</param>
+        /// <param name="startTimestamp">The value previously returned by <see cref="StartCommand"/>.</param>
+        public static void RecordCommand(string application, string transport, Type commandType, string outcome, long startTimestamp)
+        {
+            if (!Commands.Enabled && !CommandDuration.Enabled)
+            {
+                return;
+            }
+
+            var applicationTag = new KeyValuePair<string, object?>(ApplicationTag, application);
+            var transportTag = new KeyValuePair<string, object?>(TransportTag, transport);
+            var commandTag = new KeyValuePair<string, object?>(CommandTag, commandType.Name);
+            var outcomeTag = new KeyValuePair<string, object?>(OutcomeTag, outcome);
+
+            Commands.Add(1, applicationTag, transportTag, commandTag, outcomeTag);
+
+            if (startTimestamp != 0)
+            {
+                CommandDuration.Record(
+                    ElapsedMilliseconds(startTimestamp),
+                    applicationTag,
+                    transportTag,
+                    commandTag,
+                    outcomeTag);
+            }
+        }
+
+        /// <summary>
+        /// Converts a <see cref="Stopwatch.GetTimestamp"/> value into the milliseconds elapsed since.
+        /// </summary>
+        public static double ElapsedMilliseconds(long startTimestamp) =>
+            (Stopwatch.GetTimestamp() - startTimestamp) * 1000.0 / Stopwatch.Frequency;
+
+        /// <summary>
+        /// Creates the tag that identifies a command type on the pipeline instruments.
+        /// </summary>
+        public static KeyValuePair<string, object?> CommandTypeTag(Type commandType) =>
+            new KeyValuePair<string, object?>(CommandTag, commandType.Name);
+    }
+}
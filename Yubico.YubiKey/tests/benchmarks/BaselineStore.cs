@@ -0,0 +1,138 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.IO;
+using System.Linq;
+using System.Text.Json;
+using BenchmarkDotNet.Reports;
+
+namespace Yubico.YubiKey.Benchmarks
+{
+    // The stored results that a benchmark run is checked against. There is one
+    // JSON file per benchmark class, holding the mean time and allocations of
+    // each case. Timings only compare fairly on the machine that recorded
+    // them, so the files in the repository are a reference point for review
+    // and CI agents should keep their own; allocations are deterministic and
+    // compare anywhere.
+    internal sealed class BaselineStore
+    {
+        // How much slower than its baseline a benchmark may run before the
+        // check fails. Anything tighter is lost in run to run noise.
+        private const double MeanTolerance = 0.10;
+
+        private static readonly JsonSerializerOptions SerializerOptions = new JsonSerializerOptions { WriteIndented = true };
+
+        private readonly string _directory;
+
+        public BaselineStore(string directory)
+        {
+            _directory = directory;
+        }
+
+        public void Update(IEnumerable<Summary> summaries)
+        {
+            _ = Directory.CreateDirectory(_directory);
+
+            foreach (IGrouping<string, (string Type, BaselineEntry Entry)> group in GetResults(summaries).GroupBy(r => r.Type))
+            {
+                Dictionary<string, BaselineEntry> entries = Load(group.Key);
+
+                foreach ((_, BaselineEntry entry) in group)
+                {
+                    entries[entry.Benchmark] = entry;
+                }
+
+                File.WriteAllText(
+                    GetPath(group.Key),
+                    JsonSerializer.Serialize(entries.Values.OrderBy(e => e.Benchmark, StringComparer.Ordinal).ToList(), SerializerOptions));
+            }
+        }
+
+        // Writes one line per benchmark and returns false if any regressed.
+        public bool Check(IEnumerable<Summary> summaries, TextWriter output)
+        {
+            bool passed = true;
+            var loaded = new Dictionary<string, Dictionary<string, BaselineEntry>>();
+
+            foreach ((string type, BaselineEntry result) in GetResults(summaries))
+            {
+                if (!loaded.TryGetValue(type, out Dictionary<string, BaselineEntry>? entries))
+                {
+                    entries = Load(type);
+                    loaded[type] = entries;
+                }
+
+                if (!entries.TryGetValue(result.Benchmark, out BaselineEntry? baseline))
+                {
+                    output.WriteLine($"NEW        {result.Benchmark}");
+                    continue;
+                }
+
+                double meanChange = (result.MeanNanoseconds / baseline.MeanNanoseconds) - 1;
+                long allocationChange = result.AllocatedBytesPerOperation - baseline.AllocatedBytesPerOperation;
+                bool regressed = meanChange > MeanTolerance || allocationChange > 0;
+                passed &= !regressed;
+
+                output.WriteLine(string.Format(
+                    CultureInfo.InvariantCulture,
+                    "{0,-10} {1}: time {2:+0.0%;-0.0%;0.0%}, allocated {3:+#,0;-#,0;0} B/op",
+                    regressed ? "REGRESSED" : "ok",
+                    result.Benchmark,
+                    meanChange,
+                    allocationChange));
+            }
+
+            return passed;
+        }
+
+        private static IEnumerable<(string Type, BaselineEntry Entry)> GetResults(IEnumerable<Summary> summaries) =>
+            from summary in summaries
+            from report in summary.Reports
+            where !(report.ResultStatistics is null)
+            select (
+                report.BenchmarkCase.Descriptor.Type.Name,
+                new BaselineEntry
+                {
+                    Benchmark = report.BenchmarkCase.DisplayInfo,
+                    MeanNanoseconds = report.ResultStatistics.Mean,
+                    AllocatedBytesPerOperation = report.GcStats.GetBytesAllocatedPerOperation(report.BenchmarkCase),
+                });
+
+        private Dictionary<string, BaselineEntry> Load(string type)
+        {
+            string path = GetPath(type);
+
+            if (!File.Exists(path))
+            {
+                return new Dictionary<string, BaselineEntry>();
+            }
+
+            return JsonSerializer.Deserialize<List<BaselineEntry>>(File.ReadAllText(path))
+                .ToDictionary(e => e.Benchmark, StringComparer.Ordinal);
+        }
+
+        private string GetPath(string type) => Path.Combine(_directory, type + ".json");
+
+        internal sealed class BaselineEntry
+        {
+            public string Benchmark { get; set; } = string.Empty;
+            public double MeanNanoseconds { get; set; }
+            public long AllocatedBytesPerOperation { get; set; }
+        }
+    }
+}
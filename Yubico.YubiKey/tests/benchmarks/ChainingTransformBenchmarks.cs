@@ -0,0 +1,118 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using BenchmarkDotNet.Attributes;
+using Yubico.Core.Iso7816;
+using Yubico.YubiKey.Pipelines;
+
+namespace Yubico.YubiKey.Benchmarks
+{
+    // The ISO 7816 chaining transforms, with the card replaced by a transform
+    // that answers immediately. CommandChaining splits long commands into
+    // 255 byte APDUs; ResponseChaining collects a long response with GET
+    // RESPONSE.
+    [MemoryDiagnoser]
+    public class ChainingTransformBenchmarks
+    {
+        private CommandApdu _apdu = new CommandApdu();
+        private CommandChainingTransform _commandChaining = new CommandChainingTransform(new SuccessTransform());
+        private ResponseChainingTransform _responseChaining = new ResponseChainingTransform(new SuccessTransform());
+
+        [Params(255, 2048, 8192)]
+        public int Length { get; set; }
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            _apdu = new CommandApdu { Ins = 0xDB, P1 = 0x3F, P2 = 0xFF, Data = new byte[Length] };
+            _commandChaining = new CommandChainingTransform(new SuccessTransform());
+            _responseChaining = new ResponseChainingTransform(new ChainedResponseTransform(Length));
+        }
+
+        [Benchmark]
+        public ResponseApdu CommandChaining() =>
+            _commandChaining.Invoke(_apdu, typeof(object), typeof(object));
+
+        [Benchmark]
+        public ResponseApdu ResponseChaining() =>
+            _responseChaining.Invoke(_apdu, typeof(object), typeof(object));
+
+        // Accepts every command.
+        private sealed class SuccessTransform : IApduTransform
+        {
+            private static readonly ResponseApdu Success = new ResponseApdu(Array.Empty<byte>(), SWConstants.Success);
+
+            public ResponseApdu Invoke(CommandApdu command, Type commandType, Type responseType) => Success;
+
+            public void Setup()
+            {
+            }
+
+            public void Cleanup()
+            {
+            }
+        }
+
+        // Returns a response of the given length 256 bytes at a time, the way
+        // the YubiKey does: 61xx while more bytes remain and 9000 with the last
+        // piece.
+        private sealed class ChainedResponseTransform : IApduTransform
+        {
+            private const int PieceLength = 256;
+
+            private readonly ResponseApdu[] _pieces;
+            private int _next;
+
+            public ChainedResponseTransform(int length)
+            {
+                int count = (length + PieceLength - 1) / PieceLength;
+                _pieces = new ResponseApdu[count];
+
+                for (int index = 0; index < count; index++)
+                {
+                    int remaining = length - (index * PieceLength);
+                    int pieceLength = Math.Min(remaining, PieceLength);
+                    int left = remaining - pieceLength;
+
+                    short sw = left == 0
+                        ? SWConstants.Success
+                        : (short)((SW1Constants.BytesAvailable << 8) | Math.Min(left, 0xFF));
+
+                    _pieces[index] = new ResponseApdu(new byte[pieceLength], sw);
+                }
+            }
+
+            public ResponseApdu Invoke(CommandApdu command, Type commandType, Type responseType)
+            {
+                // A command that is not GET RESPONSE starts a new response.
+                if (command.Ins != 0xC0)
+                {
+                    _next = 0;
+                }
+
+                return _pieces[_next++];
+            }
+
+            public void Setup()
+            {
+            }
+
+            public void Cleanup()
+            {
+            }
+        }
+    }
+}
@@ -0,0 +1,52 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using BenchmarkDotNet.Attributes;
+using Yubico.Core.Iso7816;
+
+namespace Yubico.YubiKey.Benchmarks
+{
+    // Building the wire encoding of a command, which happens once per APDU
+    // sent to the YubiKey.
+    [MemoryDiagnoser]
+    public class CommandApduBenchmarks
+    {
+        private CommandApdu _apdu = new CommandApdu();
+
+        [Params(0, 255, 2048)]
+        public int DataLength { get; set; }
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            var data = new byte[DataLength];
+            new Random(DataLength).NextBytes(data);
+
+            _apdu = new CommandApdu
+            {
+                Cla = 0x00,
+                Ins = 0x87,
+                P1 = 0x11,
+                P2 = 0x9A,
+                Data = data,
+                Ne = 256,
+            };
+        }
+
+        [Benchmark]
+        public byte[] AsByteArray() => _apdu.AsByteArray();
+    }
+}
@@ -0,0 +1,49 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using BenchmarkDotNet.Attributes;
+using Yubico.Core.Buffers;
+
+namespace Yubico.YubiKey.Benchmarks
+{
+    // The CRC used to check OTP configuration and Yubico OTP payloads. The batch case checksums the buffer as a run
+    // of 16 byte OTP tickets.
+    [MemoryDiagnoser]
+    public class Crc13239Benchmarks
+    {
+        private const int TicketLength = 16;
+
+        private byte[] _data = Array.Empty<byte>();
+        private short[] _checksums = Array.Empty<short>();
+
+        [Params(16, 64, 1024)]
+        public int Length { get; set; }
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            _data = new byte[Length];
+            _checksums = new short[Length / TicketLength];
+            new Random(Length).NextBytes(_data);
+        }
+
+        [Benchmark]
+        public short Calculate() => Crc13239.Calculate(_data);
+
+        [Benchmark]
+        public int CalculateTickets() => Crc13239.Calculate(_data, TicketLength, _checksums);
+    }
+}
@@ -0,0 +1,75 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using System.Collections.Generic;
+using BenchmarkDotNet.Attributes;
+using Yubico.YubiKey.Fido2;
+using Yubico.YubiKey.Fido2.Serialization;
+
+namespace Yubico.YubiKey.Benchmarks
+{
+    // The reflection-based CTAP2 CBOR serializer, on a typical GetAssertion
+    // request and GetInfo response.
+    [MemoryDiagnoser]
+    public class Ctap2CborBenchmarks
+    {
+        private const byte GetAssertionCommand = 0x02;
+
+        private GetAssertionInput _getAssertion = new GetAssertionInput();
+        private byte[] _deviceInfo = Array.Empty<byte>();
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            _getAssertion = new GetAssertionInput
+            {
+                RelyingPartyId = "example.com",
+                ClientDataHash = new byte[32],
+                AllowList = new[]
+                {
+                    new PublicKeyCredentialDescriptor { Type = "public-key", Id = new byte[64] },
+                    new PublicKeyCredentialDescriptor { Type = "public-key", Id = new byte[64] },
+                },
+                Options = new Dictionary<string, bool> { ["up"] = true },
+            };
+
+            _deviceInfo = Ctap2CborSerializer.Serialize(new DeviceInfo
+            {
+                Versions = new[] { "U2F_V2", "FIDO_2_0", "FIDO_2_1_PRE" },
+                Extensions = new[] { "credProtect", "hmac-secret" },
+                AAGuid = new byte[16],
+                Options = new Dictionary<string, bool>
+                {
+                    ["rk"] = true,
+                    ["up"] = true,
+                    ["plat"] = false,
+                    ["clientPin"] = true,
+                    ["credentialMgmtPreview"] = true,
+                },
+                MaxMessageSize = 1200,
+                PinUserVerificationAuthenticatorProtocols = new[] { 1 },
+            });
+        }
+
+        [Benchmark]
+        public byte[] SerializeGetAssertion() =>
+            Ctap2CborSerializer.SerializeCommand(GetAssertionCommand, _getAssertion);
+
+        [Benchmark]
+        public DeviceInfo DeserializeDeviceInfo() =>
+            Ctap2CborSerializer.Deserialize<DeviceInfo>(_deviceInfo);
+    }
+}
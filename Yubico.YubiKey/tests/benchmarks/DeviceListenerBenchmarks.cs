@@ -0,0 +1,51 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System.Collections.Generic;
+using System.Linq;
+using BenchmarkDotNet.Attributes;
+using Yubico.Core.Devices;
+using Yubico.YubiKey.TestUtilities.Emulation;
+
+namespace Yubico.YubiKey.Benchmarks
+{
+    // The device listener's cache reconciliation, with emulated YubiKeys in
+    // place of the platform device enumeration. Populate talks to every key
+    // to read its device info; Rescan is the steady state where every device
+    // is already known.
+    [MemoryDiagnoser]
+    public class DeviceListenerBenchmarks
+    {
+        private List<IDevice> _devices = new List<IDevice>();
+        private YubiKeyDeviceListener _listener = new YubiKeyDeviceListener(() => new List<IDevice>());
+
+        [Params(1, 16, 128)]
+        public int DeviceCount { get; set; }
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            _devices = EmulatedYubiKey.CreateMany(DeviceCount).Cast<IDevice>().ToList();
+            _listener = new YubiKeyDeviceListener(() => _devices);
+            _listener.Update();
+        }
+
+        [Benchmark]
+        public void Populate() => new YubiKeyDeviceListener(() => _devices).Update();
+
+        [Benchmark]
+        public void Rescan() => _listener.Update();
+    }
+}
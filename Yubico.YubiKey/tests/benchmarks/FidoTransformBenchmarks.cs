@@ -0,0 +1,138 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using System.Buffers.Binary;
+using System.Collections.Generic;
+using BenchmarkDotNet.Attributes;
+using Yubico.Core.Devices.Hid;
+using Yubico.Core.Iso7816;
+using Yubico.YubiKey.Pipelines;
+
+namespace Yubico.YubiKey.Benchmarks
+{
+    // Framing a CTAP2 request into CTAPHID reports and reassembling the
+    // response, against a HID connection that answers immediately.
+    [MemoryDiagnoser]
+    public class FidoTransformBenchmarks
+    {
+        private const string DeviceKey = "benchmark";
+        private const uint ChannelId = 0x01020304;
+
+        private CommandApdu _apdu = new CommandApdu();
+        private FidoTransform _transform = new FidoTransform(new LoopbackHidConnection(0), DeviceKey);
+
+        [Params(64, 1024, 4096)]
+        public int MessageLength { get; set; }
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            // Hand the transform an idle channel so that it does not need to
+            // send CTAPHID_INIT.
+            CtapHidChannelRegistry.Return(DeviceKey, ChannelId);
+
+            _transform = new FidoTransform(new LoopbackHidConnection(MessageLength), DeviceKey);
+            _transform.Setup();
+            _apdu = new CommandApdu { Ins = 0x10, Data = new byte[MessageLength] };
+        }
+
+        [Benchmark]
+        public ResponseApdu Invoke() => _transform.Invoke(_apdu, typeof(object), typeof(object));
+
+        // Consumes a request and replies with a CTAPHID_CBOR response of a
+        // fixed length on the same channel.
+        private sealed class LoopbackHidConnection : IHidConnection
+        {
+            private const int ReportSize = 64;
+            private const int InitDataSize = ReportSize - 7;
+            private const int ContinuationDataSize = ReportSize - 5;
+
+            private readonly int _responseLength;
+            private readonly Queue<byte[]> _pending = new Queue<byte[]>();
+            private readonly List<byte[]> _reports = new List<byte[]>();
+            private int _requestRemaining;
+
+            public LoopbackHidConnection(int responseLength)
+            {
+                _responseLength = responseLength;
+            }
+
+            public int InputReportSize => ReportSize;
+
+            public int OutputReportSize => ReportSize;
+
+            public void SetReport(byte[] report)
+            {
+                if ((report[4] & 0x80) != 0)
+                {
+                    int length = (report[5] << 8) | report[6];
+                    _requestRemaining = Math.Max(0, length - InitDataSize);
+                }
+                else
+                {
+                    _requestRemaining = Math.Max(0, _requestRemaining - ContinuationDataSize);
+                }
+
+                if (_requestRemaining == 0)
+                {
+                    QueueResponse(BinaryPrimitives.ReadUInt32BigEndian(report));
+                }
+            }
+
+            public byte[] GetReport() => _pending.Dequeue();
+
+            public void Dispose()
+            {
+            }
+
+            // The transform copies the response out of each report, so the
+            // same report buffers are reused for every request.
+            private void QueueResponse(uint channelId)
+            {
+                int remaining = _responseLength;
+                int index = 0;
+
+                do
+                {
+                    if (_reports.Count == index)
+                    {
+                        _reports.Add(new byte[ReportSize]);
+                    }
+
+                    byte[] report = _reports[index];
+                    BinaryPrimitives.WriteUInt32BigEndian(report, channelId);
+
+                    if (index == 0)
+                    {
+                        report[4] = 0x90;
+                        report[5] = (byte)(_responseLength >> 8);
+                        report[6] = (byte)_responseLength;
+                        remaining -= InitDataSize;
+                    }
+                    else
+                    {
+                        report[4] = (byte)(index - 1);
+                        remaining -= ContinuationDataSize;
+                    }
+
+                    _pending.Enqueue(report);
+                    index++;
+                }
+                while (remaining > 0);
+            }
+        }
+    }
+}
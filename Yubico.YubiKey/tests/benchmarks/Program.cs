@@ -0,0 +1,102 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using BenchmarkDotNet.Columns;
+using BenchmarkDotNet.Configs;
+using BenchmarkDotNet.Diagnosers;
+using BenchmarkDotNet.Exporters.Json;
+using BenchmarkDotNet.Reports;
+using BenchmarkDotNet.Running;
+
+namespace Yubico.YubiKey.Benchmarks
+{
+    // Runs the SDK benchmarks. Build in Release and run from this directory:
+    //
+    //   dotnet run -c Release -- --filter '*'
+    //   dotnet run -c Release -- --filter '*Tlv*' --check-baselines
+    //   dotnet run -c Release -- --filter '*' --update-baselines
+    //
+    // Every run reports the mean time, operations per second and bytes
+    // allocated per operation. --check-baselines compares the results against
+    // the files in baselines/ and exits with 1 if anything got slower by more
+    // than the tolerance or allocates more than it used to.
+    // --update-baselines rewrites the entries for the benchmarks that ran.
+    // --baselines <directory> uses a different directory. All other arguments
+    // go to BenchmarkDotNet.
+    public static class Program
+    {
+        private const string CheckOption = "--check-baselines";
+        private const string UpdateOption = "--update-baselines";
+        private const string DirectoryOption = "--baselines";
+        private const string DefaultBaselineDirectory = "baselines";
+
+        public static int Main(string[] args)
+        {
+            var benchmarkArgs = new List<string>();
+            bool checkBaselines = false;
+            bool updateBaselines = false;
+            string baselineDirectory = DefaultBaselineDirectory;
+
+            for (int index = 0; index < args.Length; index++)
+            {
+                switch (args[index])
+                {
+                    case CheckOption:
+                        checkBaselines = true;
+                        break;
+
+                    case UpdateOption:
+                        updateBaselines = true;
+                        break;
+
+                    case DirectoryOption when index + 1 < args.Length:
+                        baselineDirectory = args[++index];
+                        break;
+
+                    default:
+                        benchmarkArgs.Add(args[index]);
+                        break;
+                }
+            }
+
+            IConfig config = DefaultConfig.Instance
+                .AddDiagnoser(MemoryDiagnoser.Default)
+                .AddColumn(StatisticColumn.OperationsPerSecond)
+                .AddExporter(JsonExporter.Full);
+
+            List<Summary> summaries = BenchmarkSwitcher
+                .FromAssembly(typeof(Program).Assembly)
+                .Run(benchmarkArgs.ToArray(), config)
+                .ToList();
+
+            var baselines = new BaselineStore(baselineDirectory);
+
+            if (updateBaselines)
+            {
+                baselines.Update(summaries);
+                Console.WriteLine($"Baselines written to {baselineDirectory}.");
+            }
+            else if (checkBaselines)
+            {
+                return baselines.Check(summaries, Console.Out) ? 0 : 1;
+            }
+
+            return 0;
+        }
+    }
+}
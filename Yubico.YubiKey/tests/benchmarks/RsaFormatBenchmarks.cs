@@ -0,0 +1,66 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using BenchmarkDotNet.Attributes;
+using Yubico.YubiKey.Cryptography;
+
+namespace Yubico.YubiKey.Benchmarks
+{
+    // Formatting and parsing RSA 2048 blocks, which the PIV application does
+    // in software around every RSA sign and decrypt.
+    [MemoryDiagnoser]
+    public class RsaFormatBenchmarks
+    {
+        private const int KeySize = RsaFormat.KeySizeBits2048;
+        private const int Digest = RsaFormat.Sha256;
+
+        private readonly byte[] _digest = new byte[32];
+        private readonly byte[] _message = new byte[32];
+
+        private byte[] _pkcs1Signature = Array.Empty<byte>();
+        private byte[] _pssSignature = Array.Empty<byte>();
+        private byte[] _oaepBlock = Array.Empty<byte>();
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            new Random(2048).NextBytes(_digest);
+            new Random(256).NextBytes(_message);
+
+            _pkcs1Signature = RsaFormat.FormatPkcs1Sign(_digest, Digest, KeySize);
+            _pssSignature = RsaFormat.FormatPkcs1Pss(_digest, Digest, KeySize);
+            _oaepBlock = RsaFormat.FormatPkcs1Oaep(_message, Digest, KeySize);
+        }
+
+        [Benchmark]
+        public byte[] FormatPkcs1Sign() => RsaFormat.FormatPkcs1Sign(_digest, Digest, KeySize);
+
+        [Benchmark]
+        public bool ParsePkcs1Verify() => RsaFormat.TryParsePkcs1Verify(_pkcs1Signature, out _, out _);
+
+        [Benchmark]
+        public byte[] FormatPkcs1Pss() => RsaFormat.FormatPkcs1Pss(_digest, Digest, KeySize);
+
+        [Benchmark]
+        public bool ParsePkcs1Pss() => RsaFormat.TryParsePkcs1Pss(_pssSignature, _digest, Digest, out _, out _);
+
+        [Benchmark]
+        public byte[] FormatPkcs1Oaep() => RsaFormat.FormatPkcs1Oaep(_message, Digest, KeySize);
+
+        [Benchmark]
+        public bool ParsePkcs1Oaep() => RsaFormat.TryParsePkcs1Oaep(_oaepBlock, Digest, out _);
+    }
+}
@@ -0,0 +1,95 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using BenchmarkDotNet.Attributes;
+using Yubico.Core.Iso7816;
+using Yubico.YubiKey.Cryptography;
+using Yubico.YubiKey.Scp03;
+
+namespace Yubico.YubiKey.Benchmarks
+{
+    // The per-APDU work of an SCP03 session: encrypting and MACing a command,
+    // and verifying and decrypting a response.
+    [MemoryDiagnoser]
+    public class Scp03Benchmarks
+    {
+        private const int Counter = 1;
+
+        private readonly byte[] _encryptionKey = Fill(16, 0x40);
+        private readonly byte[] _macKey = Fill(16, 0x50);
+        private readonly byte[] _rmacKey = Fill(16, 0x60);
+        private readonly byte[] _chainingValue = Fill(16, 0x70);
+
+        private byte[] _payload = Array.Empty<byte>();
+        private byte[] _response = Array.Empty<byte>();
+
+        [Params(16, 255, 1024)]
+        public int PayloadLength { get; set; }
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            _payload = Fill(PayloadLength, 0x11);
+
+            // Build the response the way the YubiKey would: the data encrypted
+            // under the response IV, followed by the first 8 bytes of the RMAC.
+            byte[] ivInput = new byte[16];
+            ivInput[0] = 0x80;
+            ivInput[15] = Counter;
+            byte[] iv = AesUtilities.BlockCipher(_encryptionKey, ivInput);
+            byte[] encrypted = AesUtilities.AesCbcEncrypt(_encryptionKey, iv, Padding.PadToBlockSize(_payload));
+
+            byte[] macInput = new byte[16 + encrypted.Length + 2];
+            _chainingValue.CopyTo(macInput, 0);
+            encrypted.CopyTo(macInput, 16);
+            macInput[macInput.Length - 2] = SW1Constants.Success;
+            macInput[macInput.Length - 1] = SWConstants.Success & 0xFF;
+            byte[] rmac = Cmac.AesCmac(_rmacKey, macInput);
+
+            _response = new byte[encrypted.Length + 8];
+            encrypted.CopyTo(_response, 0);
+            Array.Copy(rmac, 0, _response, encrypted.Length, 8);
+        }
+
+        [Benchmark]
+        public CommandApdu Wrap()
+        {
+            byte[] encrypted = ChannelEncryption.EncryptData(_payload, _encryptionKey, Counter);
+            var apdu = new CommandApdu { Cla = 0x84, Ins = 0xDB, P1 = 0x3F, P2 = 0xFF, Data = encrypted };
+
+            return ChannelMac.MacApdu(apdu, _macKey, _chainingValue).macdApdu;
+        }
+
+        [Benchmark]
+        public byte[] Unwrap()
+        {
+            ChannelMac.VerifyRmac(_response, _rmacKey, _chainingValue);
+
+            return ChannelEncryption.DecryptData(_response.AsSpan(0, _response.Length - 8).ToArray(), _encryptionKey, Counter);
+        }
+
+        private static byte[] Fill(int length, byte value)
+        {
+            byte[] buffer = new byte[length];
+            for (int index = 0; index < length; index++)
+            {
+                buffer[index] = (byte)(value + index);
+            }
+
+            return buffer;
+        }
+    }
+}
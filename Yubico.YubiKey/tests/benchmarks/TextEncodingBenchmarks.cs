@@ -0,0 +1,64 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using BenchmarkDotNet.Attributes;
+using Yubico.Core.Buffers;
+
+namespace Yubico.YubiKey.Benchmarks
+{
+    // The text encodings used for serial numbers, OTPs and OATH secrets.
+    [MemoryDiagnoser]
+    public class TextEncodingBenchmarks
+    {
+        private byte[] _data = Array.Empty<byte>();
+        private string _base16 = string.Empty;
+        private string _base32 = string.Empty;
+        private string _modHex = string.Empty;
+
+        // Multiples of five bytes, so that Base32 needs no padding.
+        [Params(20, 320, 4000)]
+        public int Length { get; set; }
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            _data = new byte[Length];
+            new Random(Length).NextBytes(_data);
+
+            _base16 = Base16.EncodeBytes(_data);
+            _base32 = Base32.EncodeBytes(_data);
+            _modHex = ModHex.EncodeBytes(_data);
+        }
+
+        [Benchmark]
+        public string Base16Encode() => Base16.EncodeBytes(_data);
+
+        [Benchmark]
+        public byte[] Base16Decode() => Base16.DecodeText(_base16);
+
+        [Benchmark]
+        public string Base32Encode() => Base32.EncodeBytes(_data);
+
+        [Benchmark]
+        public byte[] Base32Decode() => Base32.DecodeText(_base32);
+
+        [Benchmark]
+        public string ModHexEncode() => ModHex.EncodeBytes(_data);
+
+        [Benchmark]
+        public byte[] ModHexDecode() => ModHex.DecodeText(_modHex);
+    }
+}
@@ -0,0 +1,76 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using BenchmarkDotNet.Attributes;
+using Yubico.Core.Tlv;
+
+namespace Yubico.YubiKey.Benchmarks
+{
+    // Parsing the kind of TLV encodings the YubiKey returns: a run of short
+    // elements, and a template holding a long (two byte length) element.
+    [MemoryDiagnoser]
+    public class TlvReaderBenchmarks
+    {
+        private const int ElementCount = 16;
+
+        private byte[] _flat = Array.Empty<byte>();
+        private byte[] _nested = Array.Empty<byte>();
+
+        [GlobalSetup]
+        public void Setup()
+        {
+            var writer = new TlvWriter();
+            for (int index = 0; index < ElementCount; index++)
+            {
+                writer.WriteValue(0x01 + index, new byte[8]);
+            }
+
+            _flat = writer.Encode();
+
+            writer = new TlvWriter();
+            using (writer.WriteNestedTlv(0x7F49))
+            {
+                writer.WriteValue(0x81, new byte[256]);
+                writer.WriteValue(0x82, new byte[] { 0x01, 0x00, 0x01 });
+            }
+
+            _nested = writer.Encode();
+        }
+
+        [Benchmark]
+        public int ReadFlat()
+        {
+            var reader = new TlvReader(_flat);
+            int total = 0;
+
+            while (reader.HasData)
+            {
+                total += reader.ReadValue(reader.PeekTag()).Length;
+            }
+
+            return total;
+        }
+
+        [Benchmark]
+        public int ReadNested()
+        {
+            var reader = new TlvReader(_nested);
+            TlvReader template = reader.ReadNestedTlv(0x7F49);
+
+            return template.ReadValue(0x81).Length + template.ReadValue(0x82).Length;
+        }
+    }
+}
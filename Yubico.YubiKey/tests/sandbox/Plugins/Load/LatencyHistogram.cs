@@ -0,0 +1,116 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using System.Numerics;
+
+namespace Yubico.YubiKey.TestApp.Plugins.Load
+{
+    // Counts latencies in microseconds without allocating. Values below 32 are
+    // counted exactly; above that each power of two is split into 32 buckets,
+    // so a percentile read back is within about 3% of the true value. Each
+    // worker thread records into its own histogram and they are merged at the
+    // end.
+    internal sealed class LatencyHistogram
+    {
+        private const int SubBucketBits = 5;
+        private const int SubBucketCount = 1 << SubBucketBits;
+        private const int BucketCount = (64 - SubBucketBits + 1) * SubBucketCount;
+
+        private readonly long[] _counts = new long[BucketCount];
+
+        public long Count { get; private set; }
+        public long MaxMicroseconds { get; private set; }
+
+        public void Record(long microseconds)
+        {
+            if (microseconds < 0)
+            {
+                microseconds = 0;
+            }
+
+            _counts[GetIndex(microseconds)]++;
+            Count++;
+
+            if (microseconds > MaxMicroseconds)
+            {
+                MaxMicroseconds = microseconds;
+            }
+        }
+
+        public void Add(LatencyHistogram other)
+        {
+            for (int index = 0; index < BucketCount; index++)
+            {
+                _counts[index] += other._counts[index];
+            }
+
+            Count += other.Count;
+            MaxMicroseconds = Math.Max(MaxMicroseconds, other.MaxMicroseconds);
+        }
+
+        // The latency that percentile percent of the recorded values are at or
+        // below, taken as the middle of the bucket it falls in.
+        public double GetPercentileMicroseconds(double percentile)
+        {
+            if (Count == 0)
+            {
+                return 0;
+            }
+
+            long rank = Math.Max(1, (long)Math.Ceiling(percentile / 100 * Count));
+            long seen = 0;
+
+            for (int index = 0; index < BucketCount; index++)
+            {
+                seen += _counts[index];
+
+                if (seen >= rank)
+                {
+                    (long lower, long width) = GetBucket(index);
+                    return Math.Min(lower + (width - 1) / 2.0, MaxMicroseconds);
+                }
+            }
+
+            return MaxMicroseconds;
+        }
+
+        private static int GetIndex(long value)
+        {
+            if (value < SubBucketCount)
+            {
+                return (int)value;
+            }
+
+            int shift = 63 - BitOperations.LeadingZeroCount((ulong)value) - SubBucketBits;
+            int subBucket = (int)(value >> shift) - SubBucketCount;
+
+            return (SubBucketCount * (shift + 1)) + subBucket;
+        }
+
+        private static (long lower, long width) GetBucket(int index)
+        {
+            if (index < SubBucketCount)
+            {
+                return (index, 1);
+            }
+
+            int shift = (index / SubBucketCount) - 1;
+            long lower = (long)((index % SubBucketCount) + SubBucketCount) << shift;
+
+            return (lower, 1L << shift);
+        }
+    }
+}
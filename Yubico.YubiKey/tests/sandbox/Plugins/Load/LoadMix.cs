@@ -0,0 +1,124 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.Linq;
+
+namespace Yubico.YubiKey.TestApp.Plugins.Load
+{
+    internal enum LoadOperation
+    {
+        PivSign,
+        PivDecrypt,
+        OathCalculate,
+        Fido2Assertion,
+        OtpChallengeResponse,
+    }
+
+    // The weighted mix of operations each worker draws from, parsed from a
+    // string such as "piv-sign=4,oath=2,otp=1". An operation named without a
+    // weight gets a weight of 1.
+    internal sealed class LoadMix
+    {
+        private static readonly Dictionary<string, LoadOperation> OperationNames =
+            new Dictionary<string, LoadOperation>(StringComparer.OrdinalIgnoreCase)
+            {
+                ["piv-sign"] = LoadOperation.PivSign,
+                ["piv-decrypt"] = LoadOperation.PivDecrypt,
+                ["oath"] = LoadOperation.OathCalculate,
+                ["fido2"] = LoadOperation.Fido2Assertion,
+                ["otp"] = LoadOperation.OtpChallengeResponse,
+            };
+
+        private readonly LoadOperation[] _operations;
+        private readonly int[] _cumulativeWeights;
+
+        private LoadMix(LoadOperation[] operations, int[] weights)
+        {
+            _operations = operations;
+            _cumulativeWeights = new int[weights.Length];
+
+            int total = 0;
+            for (int index = 0; index < weights.Length; index++)
+            {
+                total += weights[index];
+                _cumulativeWeights[index] = total;
+            }
+        }
+
+        public IReadOnlyList<LoadOperation> Operations => _operations;
+
+        public static string ValidNames => string.Join(", ", OperationNames.Keys);
+
+        public static string GetName(LoadOperation operation) =>
+            OperationNames.First(pair => pair.Value == operation).Key;
+
+        public static LoadMix Parse(string mix)
+        {
+            var operations = new List<LoadOperation>();
+            var weights = new List<int>();
+
+            foreach (string entry in mix.Split(',', StringSplitOptions.RemoveEmptyEntries))
+            {
+                string[] parts = entry.Split('=', 2);
+                string name = parts[0].Trim();
+
+                if (!OperationNames.TryGetValue(name, out LoadOperation operation))
+                {
+                    throw new ArgumentException($"[{ name }] is not an operation. Valid operations are { ValidNames }.");
+                }
+
+                int weight = 1;
+                if (parts.Length == 2
+                    && (!int.TryParse(parts[1], NumberStyles.None, CultureInfo.InvariantCulture, out weight) || weight == 0))
+                {
+                    throw new ArgumentException($"[{ parts[1] }] is not a valid weight for [{ name }].");
+                }
+
+                if (operations.Contains(operation))
+                {
+                    throw new ArgumentException($"[{ name }] appears more than once in the mix.");
+                }
+
+                operations.Add(operation);
+                weights.Add(weight);
+            }
+
+            if (operations.Count == 0)
+            {
+                throw new ArgumentException("The mix must name at least one operation.");
+            }
+
+            return new LoadMix(operations.ToArray(), weights.ToArray());
+        }
+
+        public bool Contains(LoadOperation operation) => Array.IndexOf(_operations, operation) >= 0;
+
+        public LoadOperation Next(Random random)
+        {
+            int value = random.Next(_cumulativeWeights[_cumulativeWeights.Length - 1]);
+            int index = 0;
+
+            while (value >= _cumulativeWeights[index])
+            {
+                index++;
+            }
+
+            return _operations[index];
+        }
+    }
+}
@@ -0,0 +1,428 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Linq;
+using System.Threading;
+using Yubico.Core.Devices;
+using Yubico.Core.Devices.Hid;
+using Yubico.Core.Devices.SmartCard;
+using Yubico.YubiKey.TestUtilities.Emulation;
+
+namespace Yubico.YubiKey.TestApp.Plugins.Load
+{
+    // Drives a mix of operations across several YubiKeys from several threads
+    // and reports throughput, latency percentiles, ConnectionManager refusals
+    // and GC activity. Meant for sizing hosts that share a pool of keys
+    // between many clients.
+    //
+    // Each operation asks the ConnectionManager for a key, starting with the
+    // key after the one the worker used last. If the key is already in use the
+    // refusal is counted and the worker moves on to the next key, so with more
+    // threads than keys the refusal rate shows how contended the pool is. The
+    // latency of an operation runs from the successful connect (which selects
+    // the application) to the connection being closed.
+    class LoadPlugin : PluginBase
+    {
+        public override string Name => "Load";
+
+        public override string Description =>
+            "Runs a mix of PIV, OATH, FIDO2 and OTP operations across several YubiKeys and reports throughput and latency.";
+
+        public LoadPlugin(IOutput output) : base(output)
+        {
+            Parameters["command"].Description =
+                "[command] Either 'run' or 'provision'. 'provision' overwrites PIV slots 9A and 9D, the OTP long press "
+                + "slot, an OATH credential and a FIDO2 credential on every key, so that 'run' can use them. Emulated "
+                + "keys are always provisioned. If not specified, 'run' is assumed.";
+            Parameters["keys"] = new Parameter
+            {
+                Name = "Keys",
+                Shortcut = "k",
+                Description = "[count] The number of keys to use. If not specified, every connected key is used, or "
+                    + "one emulated key.",
+                Type = typeof(int),
+                Required = false
+            };
+            Parameters["emulated"] = new Parameter
+            {
+                Name = "Emulated",
+                Shortcut = "e",
+                Description = "[true/false] Use in-process emulated keys instead of connected ones. Emulated keys "
+                    + "support PIV, OATH and OTP.",
+                Type = typeof(bool),
+                Required = false
+            };
+            Parameters["threads"] = new Parameter
+            {
+                Name = "Threads",
+                Shortcut = "t",
+                Description = $"[count] The number of client threads. Defaults to { DefaultThreads }.",
+                Type = typeof(int),
+                Required = false
+            };
+            Parameters["duration"] = new Parameter
+            {
+                Name = "Duration",
+                Shortcut = "d",
+                Description = $"[seconds] How long to measure for. Defaults to { DefaultDuration }.",
+                Type = typeof(int),
+                Required = false
+            };
+            Parameters["warmup"] = new Parameter
+            {
+                Name = "Warmup",
+                Shortcut = "w",
+                Description = $"[seconds] How long to run before measuring. Defaults to { DefaultWarmup }.",
+                Type = typeof(int),
+                Required = false
+            };
+            Parameters["mix"] = new Parameter
+            {
+                Name = "Mix",
+                Shortcut = "m",
+                Description = "[operation=weight,...] The operations to run and their relative weights, for example "
+                    + $"'piv-sign=4,oath=1'. Valid operations are { LoadMix.ValidNames }. Defaults to '{ DefaultMix }'.",
+                Type = typeof(string),
+                Required = false
+            };
+            Parameters["latency"] = new Parameter
+            {
+                Name = "Latency",
+                Shortcut = "l",
+                Description = "[milliseconds] How long an emulated key takes to answer each APDU. Defaults to 0.",
+                Type = typeof(int),
+                Required = false
+            };
+        }
+
+        public override void HandleParameters()
+        {
+            base.HandleParameters();
+
+            _provision = Command.ToLower() switch
+            {
+                "" => false,
+                "run" => false,
+                "provision" => true,
+                _ => throw new ArgumentException($"[{ Command }] is not a valid command for this plugin")
+            };
+
+            _keyCount = (int?)Parameters["keys"].Value;
+            _emulated = (bool?)Parameters["emulated"].Value ?? false;
+            _threadCount = (int?)Parameters["threads"].Value ?? DefaultThreads;
+            _duration = TimeSpan.FromSeconds((int?)Parameters["duration"].Value ?? DefaultDuration);
+            _warmup = TimeSpan.FromSeconds((int?)Parameters["warmup"].Value ?? DefaultWarmup);
+            _mix = LoadMix.Parse((string?)Parameters["mix"].Value ?? DefaultMix);
+            _emulatorLatency = TimeSpan.FromMilliseconds((int?)Parameters["latency"].Value ?? 0);
+
+            if (_keyCount <= 0 || _threadCount <= 0 || _duration <= TimeSpan.Zero || _warmup < TimeSpan.Zero)
+            {
+                throw new ArgumentException("Keys, threads and duration must be positive, and warmup must not be negative.");
+            }
+        }
+
+        public override bool Execute()
+        {
+            List<LoadTarget> targets = _emulated ? CreateEmulatedTargets() : FindTargets();
+
+            if (targets.Count == 0)
+            {
+                Output.WriteLine("No YubiKeys found.", OutputLevel.Error);
+                return false;
+            }
+
+            if (_provision || _emulated)
+            {
+                foreach (LoadTarget target in targets)
+                {
+                    target.Provision(_mix, message => Output.WriteLine(message));
+                }
+
+                if (_provision)
+                {
+                    Output.WriteLine($"Provisioned { targets.Count } YubiKeys.");
+                    return true;
+                }
+            }
+
+            foreach (LoadTarget target in targets)
+            {
+                target.Prepare(_mix);
+            }
+
+            Output.WriteLine(
+                $"Running { string.Join(",", _mix.Operations.Select(LoadMix.GetName)) } on { targets.Count }"
+                + $"{ (_emulated ? " emulated" : string.Empty) } keys with { _threadCount } threads for "
+                + $"{ _duration.TotalSeconds } s after { _warmup.TotalSeconds } s of warmup.");
+
+            Worker[] workers = Enumerable.Range(0, _threadCount)
+                .Select(index => new Worker(index, targets, _mix))
+                .ToArray();
+            Thread[] threads = workers
+                .Select(worker => new Thread(worker.Run) { IsBackground = true, Name = $"Load worker {worker.Index}" })
+                .ToArray();
+
+            foreach (Thread thread in threads)
+            {
+                thread.Start();
+            }
+
+            Thread.Sleep(_warmup);
+
+            var gcBefore = GcSnapshot.Take();
+            var stopwatch = Stopwatch.StartNew();
+
+            foreach (Worker worker in workers)
+            {
+                worker.IsMeasuring = true;
+            }
+
+            Thread.Sleep(_duration);
+
+            foreach (Worker worker in workers)
+            {
+                worker.IsMeasuring = false;
+            }
+
+            stopwatch.Stop();
+            var gcAfter = GcSnapshot.Take();
+
+            foreach (Worker worker in workers)
+            {
+                worker.Stop();
+            }
+
+            foreach (Thread thread in threads)
+            {
+                thread.Join();
+            }
+
+            Report(workers, stopwatch.Elapsed, gcBefore, gcAfter);
+
+            return workers.All(worker => worker.Errors.Sum() == 0);
+        }
+
+        private List<LoadTarget> CreateEmulatedTargets() =>
+            EmulatedYubiKey.CreateMany(_keyCount ?? 1)
+                .Select(emulated =>
+                {
+                    emulated.Latency.Default = _emulatorLatency;
+                    return LoadTarget.FromEmulated(emulated);
+                })
+                .ToList();
+
+        private List<LoadTarget> FindTargets()
+        {
+            var platformDevices = new List<IDevice>(SmartCardDevice.GetSmartCardDevices());
+            platformDevices.AddRange(HidDevice.GetHidDevices());
+
+            return YubiKeyDevice.FindAll()
+                .Take(_keyCount ?? int.MaxValue)
+                .Select(yubiKey => LoadTarget.FromYubiKey(yubiKey, platformDevices))
+                .ToList();
+        }
+
+        private void Report(Worker[] workers, TimeSpan elapsed, GcSnapshot gcBefore, GcSnapshot gcAfter)
+        {
+            Output.WriteLine(
+                $"{ "Operation",-12} { "Count",10} { "Ops/s",10} { "Errors",8} "
+                + $"{ "p50 ms",9} { "p99 ms",9} { "p99.9 ms",9} { "Max ms",9}");
+
+            var total = new LatencyHistogram();
+            long totalErrors = 0;
+
+            foreach (LoadOperation operation in _mix.Operations)
+            {
+                var histogram = new LatencyHistogram();
+                long errors = 0;
+
+                foreach (Worker worker in workers)
+                {
+                    histogram.Add(worker.Latencies[(int)operation]);
+                    errors += worker.Errors[(int)operation];
+                }
+
+                total.Add(histogram);
+                totalErrors += errors;
+
+                WriteRow(LoadMix.GetName(operation), histogram, errors, elapsed);
+            }
+
+            WriteRow("total", total, totalErrors, elapsed);
+
+            long attempts = workers.Sum(worker => worker.ConnectAttempts);
+            long refusals = workers.Sum(worker => worker.Refusals);
+            double refusalRate = attempts == 0 ? 0 : (double)refusals / attempts;
+
+            Output.WriteLine(
+                $"Connection attempts { attempts }, refused by the ConnectionManager { refusals } "
+                + $"({ refusalRate:P1}, { refusals / elapsed.TotalSeconds:F0}/s).");
+
+            long allocated = gcAfter.AllocatedBytes - gcBefore.AllocatedBytes;
+            double perOperation = total.Count == 0 ? 0 : (double)allocated / total.Count;
+
+            Output.WriteLine(
+                $"GC collections gen0 { gcAfter.Gen0 - gcBefore.Gen0 }, gen1 { gcAfter.Gen1 - gcBefore.Gen1 }, "
+                + $"gen2 { gcAfter.Gen2 - gcBefore.Gen2 }; allocated { allocated / (1024.0 * 1024.0):F1} MB "
+                + $"({ perOperation:F0} B/op); heap { gcAfter.HeapBytes / (1024.0 * 1024.0):F1} MB.");
+        }
+
+        private void WriteRow(string name, LatencyHistogram histogram, long errors, TimeSpan elapsed) =>
+            Output.WriteLine(
+                $"{ name,-12} { histogram.Count,10} { histogram.Count / elapsed.TotalSeconds,10:F1} { errors,8} "
+                + $"{ histogram.GetPercentileMicroseconds(50) / 1000,9:F3} "
+                + $"{ histogram.GetPercentileMicroseconds(99) / 1000,9:F3} "
+                + $"{ histogram.GetPercentileMicroseconds(99.9) / 1000,9:F3} "
+                + $"{ histogram.MaxMicroseconds / 1000.0,9:F3}");
+
+        private sealed class Worker
+        {
+            private static readonly int OperationCount = Enum.GetValues(typeof(LoadOperation)).Length;
+
+            private readonly IReadOnlyList<LoadTarget> _targets;
+            private readonly LoadMix _mix;
+            private readonly Random _random;
+            private volatile bool _isStopping;
+            private volatile bool _isMeasuring;
+
+            public Worker(int index, IReadOnlyList<LoadTarget> targets, LoadMix mix)
+            {
+                Index = index;
+                _targets = targets;
+                _mix = mix;
+                _random = new Random(index);
+                Latencies = Enumerable.Range(0, OperationCount).Select(_ => new LatencyHistogram()).ToArray();
+                Errors = new long[OperationCount];
+            }
+
+            public int Index { get; }
+            public LatencyHistogram[] Latencies { get; }
+            public long[] Errors { get; }
+            public long ConnectAttempts { get; private set; }
+            public long Refusals { get; private set; }
+
+            public bool IsMeasuring
+            {
+                set => _isMeasuring = value;
+            }
+
+            public void Stop() => _isStopping = true;
+
+            public void Run()
+            {
+                int next = Index;
+                int consecutiveRefusals = 0;
+
+                while (!_isStopping)
+                {
+                    LoadOperation operation = _mix.Next(_random);
+                    LoadTarget target = _targets[next++ % _targets.Count];
+                    bool measuring = _isMeasuring;
+
+                    long start = Stopwatch.GetTimestamp();
+
+                    if (measuring)
+                    {
+                        ConnectAttempts++;
+                    }
+
+                    if (!target.TryConnect(LoadTarget.GetApplication(operation), out IYubiKeyConnection? connection))
+                    {
+                        if (measuring)
+                        {
+                            Refusals++;
+                        }
+
+                        // Every key is busy, so let the workers holding them run.
+                        if (++consecutiveRefusals >= _targets.Count)
+                        {
+                            consecutiveRefusals = 0;
+                            _ = Thread.Yield();
+                        }
+
+                        continue;
+                    }
+
+                    consecutiveRefusals = 0;
+
+                    try
+                    {
+                        target.Execute(operation, connection);
+
+                        if (measuring)
+                        {
+                            Latencies[(int)operation].Record(
+                                (Stopwatch.GetTimestamp() - start) * 1_000_000 / Stopwatch.Frequency);
+                        }
+                    }
+                    catch (Exception)
+                    {
+                        if (measuring)
+                        {
+                            Errors[(int)operation]++;
+                        }
+                    }
+                    finally
+                    {
+                        connection.Dispose();
+                        target.Release();
+                    }
+                }
+            }
+        }
+
+        private readonly struct GcSnapshot
+        {
+            public int Gen0 { get; }
+            public int Gen1 { get; }
+            public int Gen2 { get; }
+            public long AllocatedBytes { get; }
+            public long HeapBytes { get; }
+
+            private GcSnapshot(int gen0, int gen1, int gen2, long allocatedBytes, long heapBytes)
+            {
+                Gen0 = gen0;
+                Gen1 = gen1;
+                Gen2 = gen2;
+                AllocatedBytes = allocatedBytes;
+                HeapBytes = heapBytes;
+            }
+
+            public static GcSnapshot Take() => new GcSnapshot(
+                GC.CollectionCount(0),
+                GC.CollectionCount(1),
+                GC.CollectionCount(2),
+                GC.GetTotalAllocatedBytes(true),
+                GC.GetGCMemoryInfo().HeapSizeBytes);
+        }
+
+        private const int DefaultThreads = 4;
+        private const int DefaultDuration = 10;
+        private const int DefaultWarmup = 2;
+        private const string DefaultMix = "piv-sign";
+
+        private bool _provision;
+        private int? _keyCount;
+        private bool _emulated;
+        private int _threadCount;
+        private TimeSpan _duration;
+        private TimeSpan _warmup;
+        private LoadMix _mix = LoadMix.Parse(DefaultMix);
+        private TimeSpan _emulatorLatency;
+    }
+}
@@ -0,0 +1,302 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using System.Collections.Generic;
+using System.Diagnostics.CodeAnalysis;
+using System.Linq;
+using System.Security.Cryptography;
+using Yubico.Core.Devices;
+using Yubico.Core.Devices.Hid;
+using Yubico.YubiKey.Cryptography;
+using Yubico.YubiKey.Fido2;
+using Yubico.YubiKey.Fido2.Commands;
+using Yubico.YubiKey.Oath;
+using Yubico.YubiKey.Oath.Commands;
+using Yubico.YubiKey.Otp;
+using Yubico.YubiKey.Otp.Commands;
+using Yubico.YubiKey.Piv;
+using Yubico.YubiKey.Piv.Commands;
+using Yubico.YubiKey.TestUtilities.Emulation;
+
+namespace Yubico.YubiKey.TestApp.Plugins.Load
+{
+    // One YubiKey under load: the platform devices that reach it, and the
+    // inputs for each operation.
+    //
+    // The operations use fixed slots and names, which Provision writes:
+    //   PIV     ECC P-256 key in 9A for signing, RSA 2048 key in 9D for
+    //           decryption, both with PIN and touch policy Never.
+    //   OATH    TOTP credential "Yubico:load@example.com".
+    //   OTP     HMAC-SHA1 challenge-response in the long press slot.
+    //   FIDO2   Discoverable credential for load.example.com, asserted with
+    //           user presence off.
+    internal sealed class LoadTarget
+    {
+        private const byte SignSlot = PivSlot.Authentication;
+        private const byte DecryptSlot = PivSlot.KeyManagement;
+        private const Slot OtpSlot = Slot.LongPress;
+        private const string OathIssuer = "Yubico";
+        private const string OathAccount = "load@example.com";
+        private const string RelyingPartyId = "load.example.com";
+
+        private static readonly byte[] DefaultManagementKey =
+        {
+            0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+            0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+            0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+        };
+
+        private readonly IReadOnlyList<IDevice> _devices;
+        private readonly Credential _oathCredential =
+            new Credential(OathIssuer, OathAccount, CredentialType.Totp, CredentialPeriod.Period30);
+        private readonly byte[] _challenge = new byte[64];
+        private readonly byte[] _clientDataHash = new byte[32];
+        private byte[] _signInput = Array.Empty<byte>();
+        private byte[] _decryptInput = Array.Empty<byte>();
+
+        private LoadTarget(IYubiKeyDevice yubiKey, IReadOnlyList<IDevice> devices, bool isEmulated)
+        {
+            YubiKey = yubiKey;
+            IsEmulated = isEmulated;
+            _devices = devices;
+
+            RandomNumberGenerator.Fill(_challenge);
+            RandomNumberGenerator.Fill(_clientDataHash);
+        }
+
+        public IYubiKeyDevice YubiKey { get; }
+
+        public bool IsEmulated { get; }
+
+        public static LoadTarget FromEmulated(EmulatedYubiKey emulated) =>
+            new LoadTarget(emulated.AsYubiKeyDevice(), new IDevice[] { emulated }, true);
+
+        public static LoadTarget FromYubiKey(IYubiKeyDevice yubiKey, IEnumerable<IDevice> platformDevices) =>
+            new LoadTarget(yubiKey, platformDevices.Where(yubiKey.Contains).ToList(), false);
+
+        public static YubiKeyApplication GetApplication(LoadOperation operation) => operation switch
+        {
+            LoadOperation.PivSign => YubiKeyApplication.Piv,
+            LoadOperation.PivDecrypt => YubiKeyApplication.Piv,
+            LoadOperation.OathCalculate => YubiKeyApplication.Oath,
+            LoadOperation.Fido2Assertion => YubiKeyApplication.Fido2,
+            LoadOperation.OtpChallengeResponse => YubiKeyApplication.Otp,
+            _ => throw new ArgumentOutOfRangeException(nameof(operation)),
+        };
+
+        // Overwrites the slots and credentials listed above for every operation
+        // in the mix. Creating the FIDO2 credential needs a touch.
+        public void Provision(LoadMix mix, Action<string> notify)
+        {
+            if (mix.Contains(LoadOperation.PivSign) || mix.Contains(LoadOperation.PivDecrypt))
+            {
+                using var piv = new PivSession(YubiKey) { KeyCollector = SubmitDefaultManagementKey };
+                _ = piv.GenerateKeyPair(SignSlot, PivAlgorithm.EccP256, PivPinPolicy.Never, PivTouchPolicy.Never);
+                _ = piv.GenerateKeyPair(DecryptSlot, PivAlgorithm.Rsa2048, PivPinPolicy.Never, PivTouchPolicy.Never);
+            }
+
+            if (mix.Contains(LoadOperation.OathCalculate))
+            {
+                using var oath = new OathSession(YubiKey);
+                oath.AddCredential(new Credential(
+                    OathIssuer, OathAccount, CredentialType.Totp, Oath.HashAlgorithm.Sha1,
+                    "GEZDGNBVGY3TQOJQGEZDGNBVGY3TQOJQ", CredentialPeriod.Period30, 6, null, false));
+            }
+
+            if (mix.Contains(LoadOperation.OtpChallengeResponse))
+            {
+                byte[] key = new byte[20];
+                RandomNumberGenerator.Fill(key);
+
+                using var otp = new OtpSession(YubiKey);
+                otp.ConfigureChallengeResponse(OtpSlot).UseHmacSha1().UseKey(key).Execute();
+            }
+
+            if (mix.Contains(LoadOperation.Fido2Assertion))
+            {
+                notify($"Touch YubiKey { YubiKey.SerialNumber } to create its FIDO2 credential.");
+
+                using IYubiKeyConnection connection = YubiKey.Connect(YubiKeyApplication.Fido2);
+                _ = connection.SendCommand(new MakeCredentialCommand(new MakeCredentialInput
+                {
+                    ClientDataHash = _clientDataHash,
+                    RelyingParty = new RelyingParty { Id = RelyingPartyId, Name = "Load test" },
+                    User = new PublicKeyCredentialUserEntity
+                    {
+                        Id = new byte[] { 0x01 },
+                        Name = "load@example.com",
+                        DisplayName = "Load test",
+                    },
+                    PublicKeyCredentialParameters = new[]
+                    {
+                        new PublicKeyCredentialParameter { Algorithm = CoseAlgorithmIdentifier.ES256, Type = "public-key" },
+                    },
+                    Options = new Dictionary<string, bool> { ["rk"] = true },
+                })).GetData();
+            }
+        }
+
+        // Builds the inputs for the operations in the mix, checking that the
+        // YubiKey was provisioned for them.
+        public void Prepare(LoadMix mix)
+        {
+            if (mix.Contains(LoadOperation.Fido2Assertion) && !_devices.Any(IsFidoDevice))
+            {
+                throw new NotSupportedException(
+                    $"YubiKey { YubiKey.SerialNumber } has no FIDO interface. Emulated keys only support PIV, OATH and OTP.");
+            }
+
+            if (!mix.Contains(LoadOperation.PivSign) && !mix.Contains(LoadOperation.PivDecrypt))
+            {
+                return;
+            }
+
+            using var piv = new PivSession(YubiKey);
+
+            if (mix.Contains(LoadOperation.PivSign))
+            {
+                PivMetadata metadata = GetUsableMetadata(piv, SignSlot);
+                byte[] digest = new byte[metadata.Algorithm == PivAlgorithm.EccP384 ? 48 : 32];
+                RandomNumberGenerator.Fill(digest);
+
+                _signInput = metadata.Algorithm.IsRsa()
+                    ? RsaFormat.FormatPkcs1Sign(digest, RsaFormat.Sha256, metadata.Algorithm.KeySizeBits())
+                    : digest;
+            }
+
+            if (mix.Contains(LoadOperation.PivDecrypt))
+            {
+                PivMetadata metadata = GetUsableMetadata(piv, DecryptSlot);
+
+                if (!(metadata.PublicKey is PivRsaPublicKey publicKey))
+                {
+                    throw new NotSupportedException(
+                        $"YubiKey { YubiKey.SerialNumber } slot { DecryptSlot:X2} does not hold an RSA key.");
+                }
+
+                using var rsa = RSA.Create(new RSAParameters
+                {
+                    Modulus = publicKey.Modulus.ToArray(),
+                    Exponent = publicKey.PublicExponent.ToArray(),
+                });
+
+                _decryptInput = rsa.Encrypt(new byte[32], RSAEncryptionPadding.Pkcs1);
+            }
+        }
+
+        // Asks the ConnectionManager for the YubiKey. It refuses if another
+        // worker already has it; call Release once the connection is disposed.
+        public bool TryConnect(
+            YubiKeyApplication application,
+            [MaybeNullWhen(returnValue: false)] out IYubiKeyConnection connection)
+        {
+            IDevice? device = GetDevice(application);
+
+            if (device is null)
+            {
+                throw new NotSupportedException(
+                    $"YubiKey { YubiKey.SerialNumber } has no interface for the { application } application.");
+            }
+
+            return ConnectionManager.Instance.TryCreateConnection(YubiKey, device, application, out connection);
+        }
+
+        public void Release() => ConnectionManager.Instance.EndConnection(YubiKey);
+
+        public void Execute(LoadOperation operation, IYubiKeyConnection connection)
+        {
+            switch (operation)
+            {
+                case LoadOperation.PivSign:
+                    _ = connection.SendCommand(new AuthenticateSignCommand(_signInput, SignSlot)).GetData();
+                    break;
+
+                case LoadOperation.PivDecrypt:
+                    _ = connection.SendCommand(new AuthenticateDecryptCommand(_decryptInput, DecryptSlot)).GetData();
+                    break;
+
+                case LoadOperation.OathCalculate:
+                    _ = connection.SendCommand(new CalculateCredentialCommand(_oathCredential, ResponseFormat.Truncated)).GetData();
+                    break;
+
+                case LoadOperation.Fido2Assertion:
+                    _ = connection.SendCommand(new GetAssertionCommand(new GetAssertionInput
+                    {
+                        RelyingPartyId = RelyingPartyId,
+                        ClientDataHash = _clientDataHash,
+                        AllowList = null,
+                        Options = new Dictionary<string, bool> { ["up"] = false },
+                    })).GetData();
+                    break;
+
+                case LoadOperation.OtpChallengeResponse:
+                    _ = connection.SendCommand(
+                        new ChallengeResponseCommand(OtpSlot, ChallengeResponseAlgorithm.HmacSha1, _challenge)).GetData();
+                    break;
+
+                default:
+                    throw new ArgumentOutOfRangeException(nameof(operation));
+            }
+        }
+
+        // Prefers the HID interfaces for FIDO and OTP, as YubiKeyDevice does.
+        private IDevice? GetDevice(YubiKeyApplication application)
+        {
+            IDevice? device = application switch
+            {
+                YubiKeyApplication.Fido2 => _devices.FirstOrDefault(IsFidoDevice),
+                YubiKeyApplication.Otp => _devices.FirstOrDefault(d => d is IHidDevice { UsagePage: HidUsagePage.Keyboard }),
+                _ => null,
+            };
+
+            return device ?? _devices.FirstOrDefault(d => ConnectionManager.DeviceSupportsApplication(d, application));
+        }
+
+        private PivMetadata GetUsableMetadata(PivSession piv, byte slot)
+        {
+            PivMetadata metadata = piv.GetMetadata(slot);
+
+            if (metadata.Algorithm == PivAlgorithm.None
+                || metadata.PinPolicy != PivPinPolicy.Never
+                || metadata.TouchPolicy != PivTouchPolicy.Never)
+            {
+                throw new InvalidOperationException(
+                    $"YubiKey { YubiKey.SerialNumber } slot { slot:X2} needs a key with PIN and touch policy Never. "
+                    + "Run the provision command first.");
+            }
+
+            return metadata;
+        }
+
+        private static bool IsFidoDevice(IDevice device) => device is IHidDevice { UsagePage: HidUsagePage.Fido };
+
+        private static bool SubmitDefaultManagementKey(KeyEntryData keyEntryData)
+        {
+            switch (keyEntryData.Request)
+            {
+                case KeyEntryRequest.Release:
+                    return true;
+
+                case KeyEntryRequest.AuthenticatePivManagementKey when !keyEntryData.IsRetry:
+                    keyEntryData.SubmitValue(DefaultManagementKey);
+                    return true;
+
+                default:
+                    return false;
+            }
+        }
+    }
+}
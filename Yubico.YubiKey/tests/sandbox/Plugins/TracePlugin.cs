@@ -0,0 +1,108 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using Yubico.Core.Buffers;
+using Yubico.Core.Devices.Tracing;
+
+namespace Yubico.YubiKey.TestApp.Plugins
+{
+    class TracePlugin : PluginBase
+    {
+        public override string Name => "Trace";
+
+        public override string Description => "Reads a device trace written by DeviceTraceRecorder.";
+
+        public TracePlugin(IOutput output) : base(output)
+        {
+            Parameters["command"].Description =
+                "[command] Either 'summary', which prints the latency of each APDU instruction and CTAPHID "
+                + "command, or 'dump', which prints every record. If not specified, 'summary' is assumed.";
+            Parameters["file"] = new Parameter
+            {
+                Name = "File",
+                Shortcut = "f",
+                Description = "The trace file to read.",
+                Type = typeof(string),
+                Required = true
+            };
+        }
+
+        public override void HandleParameters()
+        {
+            base.HandleParameters();
+
+            _filePath = (string)(Parameters["file"].Value ?? string.Empty);
+
+            switch (Command.ToLower())
+            {
+                case "":
+                case "summary":
+                    _dump = false;
+                    break;
+                case "dump":
+                    _dump = true;
+                    break;
+                default:
+                    throw new ArgumentException($"[{ Command }] is not a valid command for this plugin");
+            }
+        }
+
+        public override bool Execute()
+        {
+            using DeviceTraceReader reader = DeviceTraceReader.Open(_filePath);
+
+            Output.WriteLine($"Trace started {reader.StartTimeUtc:u}, {reader.RecordCount} records, {reader.DroppedCount} dropped.");
+
+            if (_dump)
+            {
+                foreach (DeviceTraceRecord record in reader)
+                {
+                    string flags = (record.IsRedacted ? " redacted" : "") + (record.IsTruncated ? " truncated" : "");
+                    Output.WriteLine(
+                        $"{record.Timestamp.TotalMilliseconds,12:F3} ms  #{record.ConnectionId,-4} {record.Kind,-16}"
+                        + $"{record.Elapsed.TotalMilliseconds,10:F3} ms{flags}");
+
+                    if (!record.Command.IsEmpty)
+                    {
+                        Output.WriteLine($"    > {Hex.BytesToHex(record.Command.Span)}");
+                    }
+
+                    if (!record.Response.IsEmpty)
+                    {
+                        Output.WriteLine($"    < {Hex.BytesToHex(record.Response.Span)}");
+                    }
+                }
+
+                return true;
+            }
+
+            Output.WriteLine($"{"Kind",-16} {"INS",3} {"Count",8} {"Mean ms",10} {"p50 ms",10} {"p95 ms",10} {"Max ms",10}");
+
+            foreach (DeviceTraceInstructionSummary summary in reader.SummarizeByInstruction())
+            {
+                string kind = summary.Kind == DeviceTraceRecordKind.Apdu ? "APDU" : "CTAPHID";
+                Output.WriteLine(
+                    $"{kind,-16} {summary.Instruction,3:X2} {summary.Count,8} "
+                    + $"{summary.Mean.TotalMilliseconds,10:F3} {summary.Median.TotalMilliseconds,10:F3} "
+                    + $"{summary.Percentile95.TotalMilliseconds,10:F3} {summary.Max.TotalMilliseconds,10:F3}");
+            }
+
+            return true;
+        }
+
+        private string _filePath = string.Empty;
+        private bool _dump;
+    }
+}
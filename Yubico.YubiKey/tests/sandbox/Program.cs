@@ -20,6 +20,7 @@ using System.Linq;
 using System.Text;
 using Yubico.YubiKey.TestApp.Plugins.Otp;
 using Yubico.YubiKey.TestApp.Plugins;
+using Yubico.YubiKey.TestApp.Plugins.Load;
 using Yubico.YubiKey.TestUtilities;
 
 namespace Yubico.YubiKey.TestApp
@@ -54,6 +55,8 @@ namespace Yubico.YubiKey.TestApp
                 ["smartcardevents"] = (output) => new SmartCardDeviceListenerPlugin(output),
                 ["feature"] = (output) => new YubiKeyFeaturePlugin(output),
                 ["david"] = (output) => new DavidPlugin(output),
+                ["trace"] = (output) => new TracePlugin(output),
+                ["load"] = (output) => new LoadPlugin(output),
             };
 
         static int Main(string[] args)
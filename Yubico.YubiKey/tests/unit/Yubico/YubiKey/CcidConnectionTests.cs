@@ -0,0 +1,139 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using System.Collections.Generic;
+using System.Diagnostics.Metrics;
+using Moq;
+using Xunit;
+using Yubico.Core.Devices.SmartCard;
+using Yubico.Core.Iso7816;
+using Yubico.PlatformInterop;
+
+namespace Yubico.YubiKey
+{
+    public class CcidConnectionTests
+    {
+        private readonly Mock<SmartCardDevice> _smartCardDeviceMock =
+            new Mock<SmartCardDevice>("Yubico YubiKey CCID", null);
+
+        private readonly Mock<ISmartCardConnection> _smartCardConnectionMock = new Mock<ISmartCardConnection>();
+
+        public CcidConnectionTests()
+        {
+            _ = _smartCardConnectionMock
+                .Setup(x => x.Transmit(It.IsAny<CommandApdu>()))
+                .Returns(new ResponseApdu(Array.Empty<byte>(), SWConstants.Success));
+        }
+
+        [Fact]
+        public void Constructor_WithOptions_ConnectsWithOptions()
+        {
+            var options = new SmartCardConnectionOptions { Exclusive = true, ThreadAffinity = true };
+            _ = _smartCardDeviceMock
+                .Setup(x => x.Connect(options)).Returns(_smartCardConnectionMock.Object);
+
+            using var connection = new CcidConnection(_smartCardDeviceMock.Object, YubiKeyApplication.Piv, options);
+
+            _smartCardDeviceMock.Verify(x => x.Connect(options), Times.Once());
+            _smartCardDeviceMock.Verify(x => x.Connect(), Times.Never());
+        }
+
+        [Fact]
+        public void Constructor_WithoutOptions_ConnectsAsBefore()
+        {
+            _ = _smartCardDeviceMock
+                .Setup(x => x.Connect()).Returns(_smartCardConnectionMock.Object);
+
+            using var connection = new CcidConnection(_smartCardDeviceMock.Object, YubiKeyApplication.Piv);
+
+            _smartCardDeviceMock.Verify(x => x.Connect(), Times.Once());
+            _smartCardDeviceMock.Verify(x => x.Connect(It.IsAny<SmartCardConnectionOptions>()), Times.Never());
+        }
+
+        [Fact]
+        public void SendCommand_TransactionThrows_RecordsErrorOutcome()
+        {
+            _ = _smartCardDeviceMock
+                .Setup(x => x.Connect()).Returns(_smartCardConnectionMock.Object);
+            bool cardWasReset = false;
+            _ = _smartCardConnectionMock
+                .Setup(x => x.BeginTransaction(out cardWasReset))
+                .Throws(new SCardException("The card was removed."));
+
+            var outcomes = new List<string>();
+            using MeterListener listener = ListenForCommands<Piv.Commands.VersionCommand>(outcomes);
+
+            using var connection = new CcidConnection(_smartCardDeviceMock.Object, YubiKeyApplication.Piv);
+
+            _ = Assert.Throws<SCardException>(() => connection.SendCommand(new Piv.Commands.VersionCommand()));
+
+            Assert.Equal(new[] { "Piv:" + YubiKeyMetrics.ErrorOutcome }, outcomes);
+        }
+
+        [Fact]
+        public void SendCommand_ConnectedByAid_TagsApplicationName()
+        {
+            _ = _smartCardDeviceMock
+                .Setup(x => x.Connect()).Returns(_smartCardConnectionMock.Object);
+            bool cardWasReset = false;
+            _ = _smartCardConnectionMock
+                .Setup(x => x.BeginTransaction(out cardWasReset))
+                .Returns(Mock.Of<IDisposable>());
+
+            var outcomes = new List<string>();
+            using MeterListener listener = ListenForCommands<Piv.Commands.VersionCommand>(outcomes);
+
+            using var connection = new CcidConnection(
+                _smartCardDeviceMock.Object,
+                YubiKeyApplication.Piv.GetIso7816ApplicationId());
+
+            _ = connection.SendCommand(new Piv.Commands.VersionCommand());
+
+            Assert.Equal(new[] { "Piv:" + YubiKeyMetrics.SuccessOutcome }, outcomes);
+        }
+
+        // Collects "application:outcome" for each command of type TCommand counted while the listener is alive.
+        private static MeterListener ListenForCommands<TCommand>(List<string> outcomes)
+        {
+            var listener = new MeterListener();
+            listener.InstrumentPublished = (instrument, l) =>
+            {
+                if (instrument == YubiKeyMetrics.Commands)
+                {
+                    l.EnableMeasurementEvents(instrument);
+                }
+            };
+            listener.SetMeasurementEventCallback<long>((instrument, measurement, tags, state) =>
+            {
+                var values = new Dictionary<string, object?>();
+                foreach (KeyValuePair<string, object?> tag in tags)
+                {
+                    values[tag.Key] = tag.Value;
+                }
+
+                if ((string?)values[YubiKeyMetrics.CommandTag] == typeof(TCommand).Name)
+                {
+                    lock (outcomes)
+                    {
+                        outcomes.Add($"{values[YubiKeyMetrics.ApplicationTag]}:{values[YubiKeyMetrics.OutcomeTag]}");
+                    }
+                }
+            });
+            listener.Start();
+
+            return listener;
+        }
+    }
+}
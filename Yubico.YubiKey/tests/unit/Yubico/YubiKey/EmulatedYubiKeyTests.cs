@@ -0,0 +1,154 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using System.Numerics;
+using System.Security.Cryptography;
+using Xunit;
+using Yubico.Core.Tlv;
+using Yubico.YubiKey.Oath;
+using Yubico.YubiKey.Piv;
+using Yubico.YubiKey.TestUtilities.Emulation;
+using HashAlgorithm = Yubico.YubiKey.Oath.HashAlgorithm;
+
+namespace Yubico.YubiKey
+{
+    public class EmulatedYubiKeyTests
+    {
+        [Fact]
+        public void AsYubiKeyDevice_ReportsEmulatedSerialAndVersion()
+        {
+            var emulated = new EmulatedYubiKey(12345678);
+
+            IYubiKeyDevice yubiKey = emulated.AsYubiKeyDevice();
+
+            Assert.Equal(12345678, yubiKey.SerialNumber);
+            Assert.Equal(new FirmwareVersion(5, 4, 3), yubiKey.FirmwareVersion);
+        }
+
+        [Fact]
+        public void PivSession_GenerateEccAndSign_SignatureVerifies()
+        {
+            var emulated = new EmulatedYubiKey(12345678);
+            byte[] digest = new byte[32];
+            RandomNumberGenerator.Fill(digest);
+
+            using var pivSession = new PivSession(emulated.AsYubiKeyDevice());
+            var simpleCollector = new SimpleKeyCollector(false);
+            pivSession.KeyCollector = simpleCollector.SimpleKeyCollectorDelegate;
+
+            var publicKey = (PivEccPublicKey)pivSession.GenerateKeyPair(PivSlot.Authentication, PivAlgorithm.EccP256);
+            byte[] signature = pivSession.Sign(PivSlot.Authentication, digest);
+
+            ReadOnlySpan<byte> point = publicKey.PublicPoint;
+            using var ecdsa = ECDsa.Create(new ECParameters
+            {
+                Curve = ECCurve.NamedCurves.nistP256,
+                Q = new ECPoint { X = point.Slice(1, 32).ToArray(), Y = point.Slice(33, 32).ToArray() },
+            });
+
+            Assert.True(ecdsa.VerifyHash(digest, DerToP1363(signature, 32)));
+        }
+
+        [Fact]
+        public void PivSession_GenerateRsaAndSign_RawPublicOperationRecoversInput()
+        {
+            var emulated = new EmulatedYubiKey(12345678);
+            byte[] block = new byte[128];
+            RandomNumberGenerator.Fill(block);
+            block[0] = 0x00;
+
+            using var pivSession = new PivSession(emulated.AsYubiKeyDevice());
+            var simpleCollector = new SimpleKeyCollector(false);
+            pivSession.KeyCollector = simpleCollector.SimpleKeyCollectorDelegate;
+
+            var publicKey = (PivRsaPublicKey)pivSession.GenerateKeyPair(PivSlot.Signing, PivAlgorithm.Rsa1024);
+            byte[] signature = pivSession.Sign(PivSlot.Signing, block);
+
+            var modulus = new BigInteger(publicKey.Modulus, isUnsigned: true, isBigEndian: true);
+            var exponent = new BigInteger(publicKey.PublicExponent, isUnsigned: true, isBigEndian: true);
+            var result = BigInteger.ModPow(new BigInteger(signature, isUnsigned: true, isBigEndian: true), exponent, modulus);
+
+            Assert.Equal(new BigInteger(block, isUnsigned: true, isBigEndian: true), result);
+        }
+
+        [Fact]
+        public void PivSession_WrongPin_DecrementsRetries()
+        {
+            var emulated = new EmulatedYubiKey(12345678);
+
+            using var pivSession = new PivSession(emulated.AsYubiKeyDevice());
+            bool isValid = pivSession.TryVerifyPin(new byte[] { 0x39, 0x39, 0x39, 0x39, 0x39, 0x39 }, out int? retriesRemaining);
+
+            Assert.False(isValid);
+            Assert.Equal(2, retriesRemaining);
+            Assert.Equal(2, emulated.Piv.PinRetriesRemaining);
+        }
+
+        // RFC 4226 appendix D, counters 0 and 1.
+        [Fact]
+        public void OathSession_HotpCredential_MatchesRfc4226Vectors()
+        {
+            var emulated = new EmulatedYubiKey(12345678);
+
+            using var oathSession = new OathSession(emulated.AsYubiKeyDevice());
+            var credential = new Credential(
+                "Yubico", "hotp@example.com", CredentialType.Hotp, HashAlgorithm.Sha1,
+                "GEZDGNBVGY3TQOJQGEZDGNBVGY3TQOJQ", CredentialPeriod.Undefined, 6, 0, false);
+            oathSession.AddCredential(credential);
+
+            Assert.Equal("755224", oathSession.CalculateCredential(credential).Value);
+            Assert.Equal("287082", oathSession.CalculateCredential(credential).Value);
+            Assert.Single(oathSession.GetCredentials());
+        }
+
+        [Fact]
+        public void CreateMany_KeysKeepSeparateState()
+        {
+            var keys = EmulatedYubiKey.CreateMany(3);
+
+            using (var oathSession = new OathSession(keys[1].AsYubiKeyDevice()))
+            {
+                oathSession.AddCredential(new Credential(
+                    "Yubico", "totp@example.com", CredentialType.Totp, HashAlgorithm.Sha1,
+                    "GEZDGNBVGY3TQOJQGEZDGNBVGY3TQOJQ", CredentialPeriod.Period30, 6, null, false));
+            }
+
+            Assert.Equal(10_000_001, keys[1].SerialNumber);
+            Assert.Equal(0, keys[0].Oath.CredentialCount);
+            Assert.Equal(1, keys[1].Oath.CredentialCount);
+            Assert.True(keys[1].CommandCount > keys[2].CommandCount);
+        }
+
+        private static byte[] DerToP1363(byte[] signature, int coordinateLength)
+        {
+            TlvReader sequence = new TlvReader(signature).ReadNestedTlv(0x30);
+            byte[] result = new byte[2 * coordinateLength];
+
+            for (int index = 0; index < 2; index++)
+            {
+                ReadOnlySpan<byte> integer = sequence.ReadValue(0x02).Span;
+                if (integer.Length > coordinateLength)
+                {
+                    integer = integer.Slice(integer.Length - coordinateLength);
+                }
+
+                integer.CopyTo(result.AsSpan(((index + 1) * coordinateLength) - integer.Length));
+            }
+
+            return result;
+        }
+    }
+}
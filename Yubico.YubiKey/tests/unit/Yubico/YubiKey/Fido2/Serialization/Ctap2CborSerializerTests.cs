@@ -208,5 +208,16 @@ namespace Yubico.YubiKey.Fido2.Serialization
 
             Assert.Equal(correctCborDataHex, Hex.BytesToHex(cborEncoded));
         }
+
+        [Theory]
+        [MemberData(nameof(GetTestDeviceInfo))]
+        internal void SerializeCommand_GivenObject_PrefixesCommandByteToSerializedCbor(DeviceInfo ctap2DeviceInfo, string correctCborDataHex)
+        {
+            byte[] first = Ctap2CborSerializer.SerializeCommand(0x02, ctap2DeviceInfo);
+            byte[] second = Ctap2CborSerializer.SerializeCommand(0x02, ctap2DeviceInfo);
+
+            Assert.Equal("02" + correctCborDataHex, Hex.BytesToHex(first));
+            Assert.Equal(first, second);
+        }
     }
 }
@@ -16,6 +16,7 @@ using Microsoft.VisualStudio.TestPlatform.ObjectModel.Client;
 using Moq;
 using System;
 using System.Collections.Generic;
+using System.Diagnostics.Metrics;
 using System.Linq;
 using Xunit;
 using Yubico.Core.Iso7816;
@@ -220,5 +221,44 @@ namespace Yubico.YubiKey.Pipelines
             Assert.Equal(new byte[] { 5, 6, 7, 8 }, observedApdus[1]);
             Assert.Equal(new byte[] { 9, 10 }, observedApdus[2]);
         }
+
+        [Fact]
+        public void Invoke_CommandApduWithLargeDataBuffer_RecordsChainLength()
+        {
+            // Arrange
+            var recorded = new List<int>();
+            using var listener = new MeterListener();
+            listener.InstrumentPublished = (instrument, l) =>
+            {
+                if (instrument == YubiKeyMetrics.CommandChainLength)
+                {
+                    l.EnableMeasurementEvents(instrument);
+                }
+            };
+            listener.SetMeasurementEventCallback<int>((instrument, measurement, tags, state) =>
+            {
+                foreach (KeyValuePair<string, object?> tag in tags)
+                {
+                    if (tag.Key == YubiKeyMetrics.CommandTag && (string?)tag.Value == nameof(CommandChainingTransformTests))
+                    {
+                        recorded.Add(measurement);
+                    }
+                }
+            });
+            listener.Start();
+
+            var mockTransform = new Mock<IApduTransform>();
+            var transform = new CommandChainingTransform(mockTransform.Object) { MaxSize = 4 };
+            var commandApdu = new CommandApdu
+            {
+                Data = new byte[] { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 }
+            };
+
+            // Act
+            _ = transform.Invoke(commandApdu, typeof(CommandChainingTransformTests), typeof(object));
+
+            // Assert
+            Assert.Equal(new[] { 3 }, recorded);
+        }
     }
 }
@@ -0,0 +1,105 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using Moq;
+using Xunit;
+using Yubico.Core.Devices.Hid;
+
+namespace Yubico.YubiKey.Pipelines
+{
+    public class CtapHidChannelRegistryTests
+    {
+        [Fact]
+        public void TryRent_AfterReturn_ReturnsSameChannel()
+        {
+            string deviceKey = UniqueDeviceKey();
+            CtapHidChannelRegistry.Return(deviceKey, 0x01020304);
+
+            bool found = CtapHidChannelRegistry.TryRent(deviceKey, out uint channelId);
+
+            Assert.True(found);
+            Assert.Equal(0x01020304u, channelId);
+        }
+
+        [Fact]
+        public void TryRent_ChannelAlreadyRented_ReturnsFalse()
+        {
+            string deviceKey = UniqueDeviceKey();
+            CtapHidChannelRegistry.Return(deviceKey, 0x01020304);
+            _ = CtapHidChannelRegistry.TryRent(deviceKey, out _);
+
+            Assert.False(CtapHidChannelRegistry.TryRent(deviceKey, out _));
+        }
+
+        [Fact]
+        public void Invalidate_GivenDevicePath_DropsIdleChannels()
+        {
+            var device = new Mock<IHidDevice>();
+            _ = device.SetupGet(d => d.Path).Returns(Guid.NewGuid().ToString());
+            string deviceKey = CtapHidChannelRegistry.GetDeviceKey(device.Object);
+            CtapHidChannelRegistry.Return(deviceKey, 0x01020304);
+
+            CtapHidChannelRegistry.Invalidate(device.Object.Path);
+
+            Assert.False(CtapHidChannelRegistry.TryRent(deviceKey, out _));
+        }
+
+        [Fact]
+        public void GetDeviceKey_DifferentProductIdSamePath_ReturnsDifferentKeys()
+        {
+            string path = Guid.NewGuid().ToString();
+            var first = new Mock<IHidDevice>();
+            _ = first.SetupGet(d => d.Path).Returns(path);
+            _ = first.SetupGet(d => d.ProductId).Returns(0x0407);
+            var second = new Mock<IHidDevice>();
+            _ = second.SetupGet(d => d.Path).Returns(path);
+            _ = second.SetupGet(d => d.ProductId).Returns(0x0402);
+
+            Assert.NotEqual(
+                CtapHidChannelRegistry.GetDeviceKey(first.Object),
+                CtapHidChannelRegistry.GetDeviceKey(second.Object));
+        }
+
+        [Fact]
+        public void Setup_IdleChannelAvailable_DoesNotSendInit()
+        {
+            string deviceKey = UniqueDeviceKey();
+            CtapHidChannelRegistry.Return(deviceKey, 0x01020304);
+            var connection = new Mock<IHidConnection>();
+            var transform = new FidoTransform(connection.Object, deviceKey);
+
+            transform.Setup();
+
+            Assert.True(transform.IsChannelIdAcquired);
+            connection.Verify(c => c.SetReport(It.IsAny<byte[]>()), Times.Never());
+        }
+
+        [Fact]
+        public void Cleanup_AfterSetupFromRegistry_ReturnsChannel()
+        {
+            string deviceKey = UniqueDeviceKey();
+            CtapHidChannelRegistry.Return(deviceKey, 0x01020304);
+            var transform = new FidoTransform(new Mock<IHidConnection>().Object, deviceKey);
+            transform.Setup();
+
+            transform.Cleanup();
+
+            Assert.True(CtapHidChannelRegistry.TryRent(deviceKey, out uint channelId));
+            Assert.Equal(0x01020304u, channelId);
+        }
+
+        private static string UniqueDeviceKey() => Guid.NewGuid().ToString() + "|1050|0407|";
+    }
+}
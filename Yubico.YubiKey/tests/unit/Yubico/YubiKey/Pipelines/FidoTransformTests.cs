@@ -0,0 +1,115 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using Moq;
+using Xunit;
+using Yubico.Core.Devices.Hid;
+using Yubico.Core.Iso7816;
+using Yubico.PlatformInterop;
+
+namespace Yubico.YubiKey.Pipelines
+{
+    public class FidoTransformTests
+    {
+        private const uint ChannelId = 0x01020304;
+
+        [Fact]
+        public void Constructor_GivenNullConnection_ThrowsArgumentNullException()
+        {
+#pragma warning disable CS8625 // Cannot convert null literal to non-nullable reference type.
+            _ = Assert.Throws<ArgumentNullException>(() => new FidoTransform(null));
+#pragma warning restore CS8625 // Cannot convert null literal to non-nullable reference type.
+        }
+
+        [Fact]
+        public void Invoke_KeepAlives_AreSkippedUntilResponse()
+        {
+            var connection = new Mock<IHidConnection>();
+            _ = connection.SetupSequence(c => c.GetReport())
+                .Returns(KeepAlivePacket(0x01))
+                .Returns(KeepAlivePacket(0x02))
+                .Returns(CborResponsePacket());
+
+            FidoTransform transform = CreateTransform(connection.Object);
+
+            ResponseApdu response = transform.Invoke(CborCommand(), typeof(object), typeof(object));
+
+            Assert.Equal(SWConstants.Success, response.SW);
+            connection.Verify(c => c.GetReport(), Times.Exactly(3));
+        }
+
+        [Fact]
+        public void Invoke_SetReportThrows_ClearsPacketBuffer()
+        {
+            byte[]? sentPacket = null;
+            var connection = new Mock<IHidConnection>();
+            _ = connection.Setup(c => c.SetReport(It.IsAny<byte[]>()))
+                .Callback<byte[]>(packet => sentPacket = packet)
+                .Throws(new PlatformApiException("SetReport failed."));
+
+            FidoTransform transform = CreateTransform(connection.Object);
+
+            _ = Assert.Throws<PlatformApiException>(
+                () => transform.Invoke(CborCommand(), typeof(object), typeof(object)));
+
+            Assert.NotNull(sentPacket);
+            Assert.All(sentPacket!, b => Assert.Equal(0, b));
+        }
+
+        private static FidoTransform CreateTransform(IHidConnection connection)
+        {
+            string deviceKey = Guid.NewGuid().ToString() + "|1050|0407|";
+            CtapHidChannelRegistry.Return(deviceKey, ChannelId);
+
+            var transform = new FidoTransform(connection, deviceKey);
+            transform.Setup();
+
+            return transform;
+        }
+
+        private static CommandApdu CborCommand() =>
+            new CommandApdu() { Ins = 0x10, Data = new byte[] { 0x04 } };
+
+        private static byte[] KeepAlivePacket(byte status)
+        {
+            byte[] packet = InitPacketHeader(0x3b, 1);
+            packet[7] = status;
+
+            return packet;
+        }
+
+        private static byte[] CborResponsePacket()
+        {
+            byte[] packet = InitPacketHeader(0x10, 1);
+            packet[7] = 0x00;
+
+            return packet;
+        }
+
+        private static byte[] InitPacketHeader(byte command, int length)
+        {
+            byte[] packet = new byte[64];
+            packet[0] = 0x01;
+            packet[1] = 0x02;
+            packet[2] = 0x03;
+            packet[3] = 0x04;
+            packet[4] = (byte)(command | 0x80);
+            packet[5] = (byte)(length >> 8);
+            packet[6] = (byte)length;
+
+            return packet;
+        }
+    }
+}
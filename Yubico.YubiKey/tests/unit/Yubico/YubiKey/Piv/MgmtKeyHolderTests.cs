@@ -0,0 +1,78 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using System.Security.Cryptography;
+using Xunit;
+
+namespace Yubico.YubiKey.Piv
+{
+    public class MgmtKeyHolderTests
+    {
+        [Fact]
+        public void SetKeyData_Buffer_KeepsKeyOfAlgorithmLength()
+        {
+            byte[] key = new byte[32];
+            key.AsSpan().Fill(0x5A);
+            using var holder = new PivSession.MgmtKeyHolder();
+
+            holder.SetKeyData(key, PivAlgorithm.Aes128);
+
+            Assert.Equal(16, holder.KeyData.Length);
+            Assert.All(holder.KeyData.ToArray(), b => Assert.Equal((byte)0x5A, b));
+        }
+
+        [Fact]
+        public void SetKeyData_Random_FillsKeyOfAlgorithmLength()
+        {
+            using var holder = new PivSession.MgmtKeyHolder();
+
+            holder.SetKeyData(ReadOnlyMemory<byte>.Empty, PivAlgorithm.Aes256);
+
+            Assert.Equal(32, holder.KeyData.Length);
+        }
+
+        [Fact]
+        public void DeriveKeyData_MatchesPbkdf2()
+        {
+            byte[] pin = { 0x31, 0x32, 0x33, 0x34, 0x35, 0x36 };
+            byte[] salt = new byte[16];
+            salt.AsSpan().Fill(0x07);
+            using var holder = new PivSession.MgmtKeyHolder();
+
+            _ = holder.DeriveKeyData(pin, salt, PivAlgorithm.TripleDes);
+
+#pragma warning disable CA5379, CA5387 // PIN-derived management keys are defined with SHA-1 and 10,000 iterations.
+            using var kdf = new Rfc2898DeriveBytes(pin, salt, 10000);
+#pragma warning restore CA5379, CA5387
+            Assert.Equal(kdf.GetBytes(24), holder.KeyData.ToArray());
+        }
+
+        [Fact]
+        public void Dispose_ClearsKeyDataAndRejectsFurtherUse()
+        {
+            var holder = new PivSession.MgmtKeyHolder();
+            holder.SetKeyData(new byte[24], PivAlgorithm.TripleDes);
+
+            holder.Dispose();
+
+            Assert.True(holder.KeyData.IsEmpty);
+            _ = Assert.Throws<ObjectDisposedException>(
+                () => holder.SetKeyData(new byte[24], PivAlgorithm.TripleDes));
+            _ = Assert.Throws<ObjectDisposedException>(
+                () => holder.DeriveKeyData(new byte[6], new byte[16], PivAlgorithm.TripleDes));
+        }
+    }
+}
@@ -0,0 +1,67 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using System.Linq;
+using Xunit;
+
+namespace Yubico.YubiKey.Scp03
+{
+    public class SessionKeysTests
+    {
+        private static byte[] GetKey(byte value) => Enumerable.Repeat(value, 16).ToArray();
+
+        [Fact]
+        public void Constructor_CopiesKeysAndZeroesInputs()
+        {
+            byte[] mac = GetKey(0x11);
+            byte[] enc = GetKey(0x22);
+            byte[] rmac = GetKey(0x33);
+
+            using var keys = new SessionKeys(mac, enc, rmac);
+
+            Assert.Equal(GetKey(0x11), keys.SessionMacKey.ToArray());
+            Assert.Equal(GetKey(0x22), keys.SessionEncryptionKey.ToArray());
+            Assert.Equal(GetKey(0x33), keys.SessionRmacKey.ToArray());
+            Assert.All(mac.Concat(enc).Concat(rmac), b => Assert.Equal((byte)0, b));
+        }
+
+        [Fact]
+        public void Keys_AfterDispose_ThrowObjectDisposedException()
+        {
+            var keys = new SessionKeys(GetKey(0x11), GetKey(0x22), GetKey(0x33));
+
+            keys.Dispose();
+
+            _ = Assert.Throws<ObjectDisposedException>(() => keys.SessionMacKey.Length);
+            _ = Assert.Throws<ObjectDisposedException>(() => keys.SessionEncryptionKey.Length);
+            _ = Assert.Throws<ObjectDisposedException>(() => keys.SessionRmacKey.Length);
+        }
+
+        [Fact]
+        public void DeriveSessionKeys_UsesPooledStaticKeyCopies_MatchesDirectDerivation()
+        {
+            byte[] hostChallenge = GetKey(0x01).Take(8).ToArray();
+            byte[] cardChallenge = GetKey(0x02).Take(8).ToArray();
+            var staticKeys = new StaticKeys();
+
+            using SessionKeys keys = Derivation.DeriveSessionKeysFromStaticKeys(staticKeys, hostChallenge, cardChallenge);
+
+            byte[] expectedMac = Derivation.Derive(
+                Derivation.DDC_SMAC, 0x80, staticKeys.ChannelMacKey.ToArray(), hostChallenge, cardChallenge);
+            Assert.Equal(expectedMac, keys.SessionMacKey.ToArray());
+        }
+    }
+}
@@ -0,0 +1,120 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using Moq;
+using Xunit;
+using Yubico.Core.Iso7816;
+using Yubico.YubiKey.U2f.Commands;
+
+namespace Yubico.YubiKey.U2f
+{
+    public class U2fSessionTests
+    {
+        private static readonly byte[] _clientDataHash = new byte[32];
+
+        private readonly Mock<IYubiKeyConnection> _connectionMock = new Mock<IYubiKeyConnection>();
+        private readonly Mock<IYubiKeyDevice> _yubiKeyMock = new Mock<IYubiKeyDevice>();
+        private readonly List<byte> _checkedKeyHandles = new List<byte>();
+
+        public U2fSessionTests()
+        {
+            // A key handle whose first byte is 0x02 belongs to the YubiKey. Every other one is rejected.
+            _ = _connectionMock
+                .Setup(c => c.SendCommand(It.IsAny<AuthenticateCommand>()))
+                .Returns((IYubiKeyCommand<AuthenticateResponse> command) =>
+                {
+                    byte marker = ((AuthenticateCommand)command).KeyHandle.Span[0];
+                    _checkedKeyHandles.Add(marker);
+
+                    return new AuthenticateResponse(new ResponseApdu(
+                        Array.Empty<byte>(),
+                        marker == 0x02 ? SWConstants.ConditionsNotSatisfied : SWConstants.InvalidCommandDataParameter));
+                });
+            _ = _yubiKeyMock
+                .Setup(y => y.Connect(YubiKeyApplication.FidoU2f))
+                .Returns(_connectionMock.Object);
+        }
+
+        [Fact]
+        public void VerifyKeyHandles_MatchInMiddle_ReturnsIndexAndStops()
+        {
+            using var session = new U2fSession(_yubiKeyMock.Object);
+
+            int index = session.VerifyKeyHandles(_clientDataHash, Candidates(0x01, 0x02, 0x03));
+
+            Assert.Equal(1, index);
+            Assert.Equal(new byte[] { 0x01, 0x02 }, _checkedKeyHandles);
+        }
+
+        [Fact]
+        public void VerifyKeyHandles_NoMatch_ChecksAllAndReturnsMinusOne()
+        {
+            using var session = new U2fSession(_yubiKeyMock.Object);
+
+            int index = session.VerifyKeyHandles(_clientDataHash, Candidates(0x01, 0x03, 0x04));
+
+            Assert.Equal(-1, index);
+            Assert.Equal(new byte[] { 0x01, 0x03, 0x04 }, _checkedKeyHandles);
+        }
+
+        [Fact]
+        public void VerifyKeyHandles_InvalidLaterCandidate_ThrowsBeforeSendingAnything()
+        {
+            var candidates = Candidates(0x01, 0x02).ToList();
+            candidates.Add((new byte[32], new byte[10]));
+            using var session = new U2fSession(_yubiKeyMock.Object);
+
+            _ = Assert.Throws<ArgumentException>(() => session.VerifyKeyHandles(_clientDataHash, candidates));
+
+            Assert.Empty(_checkedKeyHandles);
+        }
+
+        [Fact]
+        public void VerifyKeyHandles_ConnectionFails_PropagatesAndSendsNoMore()
+        {
+            _ = _connectionMock
+                .Setup(c => c.SendCommand(It.IsAny<AuthenticateCommand>()))
+                .Throws(new InvalidOperationException());
+            using var session = new U2fSession(_yubiKeyMock.Object);
+
+            _ = Assert.Throws<InvalidOperationException>(
+                () => session.VerifyKeyHandles(_clientDataHash, Candidates(0x01, 0x02)));
+
+            _connectionMock.Verify(c => c.SendCommand(It.IsAny<AuthenticateCommand>()), Times.Once());
+        }
+
+        [Fact]
+        public void VerifyKeyHandles_NullCandidates_Throws()
+        {
+            using var session = new U2fSession(_yubiKeyMock.Object);
+
+            _ = Assert.Throws<ArgumentNullException>(() => session.VerifyKeyHandles(_clientDataHash, null!));
+        }
+
+        private static IReadOnlyList<(ReadOnlyMemory<byte> ApplicationId, ReadOnlyMemory<byte> KeyHandle)> Candidates(
+            params byte[] markers) =>
+            markers
+                .Select(m =>
+                {
+                    byte[] keyHandle = new byte[64];
+                    keyHandle[0] = m;
+                    return ((ReadOnlyMemory<byte>)new byte[32], (ReadOnlyMemory<byte>)keyHandle);
+                })
+                .ToList();
+    }
+}
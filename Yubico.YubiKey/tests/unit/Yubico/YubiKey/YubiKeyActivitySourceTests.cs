@@ -0,0 +1,133 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Linq;
+using Moq;
+using Xunit;
+using Yubico.Core.Iso7816;
+using Yubico.YubiKey.Pipelines;
+
+namespace Yubico.YubiKey
+{
+    public class YubiKeyActivitySourceTests
+    {
+        private static readonly ActivitySource _testSource = new ActivitySource("Yubico.YubiKey.UnitTests");
+
+        [Fact]
+        public void StartApdu_Listening_TagsCommandDataLength()
+        {
+            var command = new CommandApdu { Ins = 0x01, Data = new byte[] { 0x01, 0x02, 0x03 } };
+
+            List<Activity> spans = Capture(() =>
+            {
+                using Activity? activity = YubiKeyActivitySource.StartApdu("Test", command);
+                YubiKeyActivitySource.SetResponse(activity, new ResponseApdu(new byte[] { 0xAA, 0x69, 0x82 }));
+            });
+
+            Activity span = Assert.Single(spans);
+            Assert.Equal("Test", span.OperationName);
+            Assert.Equal(3, span.GetTagItem(YubiKeyActivitySource.CommandLengthTag));
+            Assert.Equal(1, span.GetTagItem(YubiKeyActivitySource.ResponseLengthTag));
+            Assert.Equal("6982", span.GetTagItem(YubiKeyActivitySource.StatusWordTag));
+        }
+
+        [Fact]
+        public void SetResponse_NullActivity_DoesNothing()
+        {
+            YubiKeyActivitySource.SetResponse(null, new ResponseApdu(new byte[] { 0x90, 0x00 }));
+        }
+
+        [Fact]
+        public void ResponseChainingTransform_ChainedResponse_TagsAssembledResponse()
+        {
+            var mockTransform = new Mock<IApduTransform>();
+            _ = mockTransform
+                .SetupSequence(x => x.Invoke(It.IsAny<CommandApdu>(), It.IsAny<Type>(), It.IsAny<Type>()))
+                .Returns(new ResponseApdu(new byte[] { 0x01, 0x02, 0x61, 0x02 }))
+                .Returns(new ResponseApdu(new byte[] { 0x03, 0x04, 0x90, 0x00 }));
+            var transform = new ResponseChainingTransform(mockTransform.Object);
+            var command = new CommandApdu { Ins = 0x01, Data = new byte[] { 0x01 } };
+
+            List<Activity> spans = Capture(() => _ = transform.Invoke(command, typeof(object), typeof(object)));
+
+            Activity span = Assert.Single(spans);
+            Assert.Equal(nameof(ResponseChainingTransform), span.OperationName);
+            Assert.Equal(1, span.GetTagItem(YubiKeyActivitySource.CommandLengthTag));
+            Assert.Equal(4, span.GetTagItem(YubiKeyActivitySource.ResponseLengthTag));
+            Assert.Equal("9000", span.GetTagItem(YubiKeyActivitySource.StatusWordTag));
+        }
+
+        [Fact]
+        public void NestedTransforms_EmitOneSpanPerTransform_ParentedOutsideIn()
+        {
+            var mockTransform = new Mock<IApduTransform>();
+            _ = mockTransform
+                .Setup(x => x.Invoke(It.IsAny<CommandApdu>(), It.IsAny<Type>(), It.IsAny<Type>()))
+                .Returns(new ResponseApdu(new byte[] { 0x90, 0x00 }));
+            var transform = new CommandChainingTransform(new ResponseChainingTransform(mockTransform.Object));
+
+            // Long enough to be sent as two chained commands.
+            var command = new CommandApdu { Ins = 0x01, Data = new byte[300] };
+
+            List<Activity> spans = Capture(() => _ = transform.Invoke(command, typeof(object), typeof(object)));
+
+            Activity outer = Assert.Single(spans, s => s.OperationName == nameof(CommandChainingTransform));
+            Assert.Equal(300, outer.GetTagItem(YubiKeyActivitySource.CommandLengthTag));
+
+            var inner = spans.Where(s => s.OperationName == nameof(ResponseChainingTransform)).ToList();
+            Assert.Equal(2, inner.Count);
+            Assert.All(inner, s => Assert.Same(outer, s.Parent));
+        }
+
+        // Runs the action under a root span of its own, and returns only the "Yubico.YubiKey" spans beneath that
+        // root, so that tests running in parallel cannot leak spans into each other's results.
+        private static List<Activity> Capture(Action action)
+        {
+            var stopped = new List<Activity>();
+            using var listener = new ActivityListener
+            {
+                ShouldListenTo = source =>
+                    source.Name == YubiKeyActivitySource.Name || source.Name == _testSource.Name,
+                Sample = (ref ActivityCreationOptions<ActivityContext> _) => ActivitySamplingResult.AllDataAndRecorded,
+                ActivityStopped = activity =>
+                {
+                    lock (stopped)
+                    {
+                        stopped.Add(activity);
+                    }
+                }
+            };
+            ActivitySource.AddActivityListener(listener);
+
+            ActivityTraceId traceId;
+            using (Activity? root = _testSource.StartActivity(nameof(Capture)))
+            {
+                Assert.NotNull(root);
+                traceId = root!.TraceId;
+                action();
+            }
+
+            lock (stopped)
+            {
+                return stopped
+                    .Where(a => a.Source.Name == YubiKeyActivitySource.Name && a.TraceId == traceId)
+                    .ToList();
+            }
+        }
+    }
+}
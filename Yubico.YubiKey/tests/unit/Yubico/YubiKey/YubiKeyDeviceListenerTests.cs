@@ -0,0 +1,34 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using Xunit;
+
+namespace Yubico.YubiKey
+{
+    public class YubiKeyDeviceListenerTests
+    {
+        [Fact]
+        public void ReaderFilter_SetAfterListenerCreated_ThrowsInvalidOperationException()
+        {
+            var filter = YubiKeyDeviceListener.CreateYubiKeyReaderFilter("Yubico*");
+            YubiKeyDeviceListener.ReaderFilter = filter;
+
+            Assert.Same(filter, YubiKeyDeviceListener.TakeReaderFilter());
+            _ = Assert.Throws<InvalidOperationException>(() => YubiKeyDeviceListener.ReaderFilter = null);
+            Assert.Same(filter, YubiKeyDeviceListener.ReaderFilter);
+        }
+    }
+}
@@ -0,0 +1,148 @@
+﻿// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using Moq;
+using Xunit;
+using Yubico.Core.Devices.SmartCard;
+using Yubico.Core.Iso7816;
+
+namespace Yubico.YubiKey
+{
+    public class YubiKeyKeepWarmTests
+    {
+        private readonly Mock<ISmartCardDevice> _smartCardDeviceMock = new Mock<ISmartCardDevice>();
+        private readonly Mock<ISmartCardConnection> _smartCardConnectionMock = new Mock<ISmartCardConnection>();
+        private readonly Mock<ISmartCardConnectionStatus> _statusMock;
+        private readonly YubiKeyDevice _yubiKey;
+
+        public YubiKeyKeepWarmTests()
+        {
+            _statusMock = _smartCardConnectionMock.As<ISmartCardConnectionStatus>();
+            _ = _statusMock
+                .Setup(x => x.GetStatus())
+                .Returns(new SmartCardConnectionStatus(SmartCardState.Specific, SmartCardProtocol.T1, null, 1));
+            _ = _smartCardDeviceMock.Setup(x => x.Path).Returns("Yubico YubiKey OTP+FIDO+CCID 00");
+            _ = _smartCardDeviceMock.Setup(x => x.Connect()).Returns(_smartCardConnectionMock.Object);
+
+            _yubiKey = new YubiKeyDevice(_smartCardDeviceMock.Object, null, null, new YubiKeyDeviceInfo());
+        }
+
+        [Fact]
+        public void CheckAll_AddedYubiKey_ReadsStatusWithoutTouchingCard()
+        {
+            using var keepWarm = new YubiKeyKeepWarm(TimeSpan.FromMinutes(1));
+            keepWarm.Add(_yubiKey);
+            keepWarm.Add(_yubiKey);
+
+            keepWarm.CheckAll();
+
+            bool cardWasReset;
+            _smartCardDeviceMock.Verify(x => x.Connect(), Times.Once());
+            _statusMock.Verify(x => x.GetStatus(), Times.Once());
+            _smartCardConnectionMock.Verify(x => x.BeginTransaction(out cardWasReset), Times.Never());
+            _smartCardConnectionMock.Verify(x => x.Transmit(It.IsAny<CommandApdu>()), Times.Never());
+        }
+
+        [Fact]
+        public void CheckAll_StatusFails_ClosesAndReopensConnection()
+        {
+            _ = _statusMock
+                .Setup(x => x.GetStatus())
+                .Throws(new PlatformInterop.SCardException("The card was removed."));
+            using var keepWarm = new YubiKeyKeepWarm(TimeSpan.FromMinutes(1));
+            keepWarm.Add(_yubiKey);
+
+            keepWarm.CheckAll();
+
+            _smartCardConnectionMock.Verify(x => x.Dispose(), Times.Once());
+            _smartCardDeviceMock.Verify(x => x.Connect(), Times.Exactly(2));
+        }
+
+        [Fact]
+        public void CheckAll_CardAway_ReopensOnceItIsBack()
+        {
+            _ = _statusMock
+                .Setup(x => x.GetStatus())
+                .Returns(new SmartCardConnectionStatus(SmartCardState.Absent, SmartCardProtocol.Unknown, null, 2));
+            using var keepWarm = new YubiKeyKeepWarm(TimeSpan.FromMinutes(1));
+            keepWarm.Add(_yubiKey);
+            _ = _smartCardDeviceMock
+                .Setup(x => x.Connect())
+                .Throws(new PlatformInterop.SCardException("The card was removed."));
+
+            keepWarm.CheckAll();
+            keepWarm.CheckAll();
+            _ = _smartCardDeviceMock.Setup(x => x.Connect()).Returns(_smartCardConnectionMock.Object);
+            keepWarm.CheckAll();
+
+            _smartCardDeviceMock.Verify(x => x.Connect(), Times.Exactly(4));
+            _statusMock.Verify(x => x.GetStatus(), Times.Once());
+        }
+
+        [Fact]
+        public void CheckAll_StatusThrowsInvalidOperation_DoesNotThrow()
+        {
+            _ = _statusMock.Setup(x => x.GetStatus()).Throws(new ObjectDisposedException("connection"));
+            using var keepWarm = new YubiKeyKeepWarm(TimeSpan.FromMinutes(1));
+            keepWarm.Add(_yubiKey);
+
+            keepWarm.CheckAll();
+        }
+
+        [Fact]
+        public void Add_ThreadAffinityYubiKey_ThrowsArgumentException()
+        {
+            _yubiKey.SmartCardConnectionOptions = new SmartCardConnectionOptions { ThreadAffinity = true };
+            using var keepWarm = new YubiKeyKeepWarm(TimeSpan.FromMinutes(1));
+
+            _ = Assert.Throws<ArgumentException>(() => keepWarm.Add(_yubiKey));
+            _smartCardDeviceMock.Verify(x => x.Connect(), Times.Never());
+        }
+
+        [Fact]
+        public void Remove_AddedYubiKey_ClosesConnection()
+        {
+            using var keepWarm = new YubiKeyKeepWarm(TimeSpan.FromMinutes(1));
+            keepWarm.Add(_yubiKey);
+
+            Assert.True(keepWarm.Remove(_yubiKey));
+            keepWarm.CheckAll();
+
+            _smartCardConnectionMock.Verify(x => x.Dispose(), Times.Once());
+            _statusMock.Verify(x => x.GetStatus(), Times.Never());
+        }
+
+        [Fact]
+        public void Add_AfterDispose_ThrowsObjectDisposedException()
+        {
+            var keepWarm = new YubiKeyKeepWarm(TimeSpan.FromMinutes(1));
+            keepWarm.Dispose();
+
+            _ = Assert.Throws<ObjectDisposedException>(() => keepWarm.Add(_yubiKey));
+            _smartCardDeviceMock.Verify(x => x.Connect(), Times.Never());
+        }
+
+        [Fact]
+        public void Add_ExclusiveYubiKey_ThrowsArgumentException()
+        {
+            _yubiKey.SmartCardConnectionOptions = new SmartCardConnectionOptions { Exclusive = true };
+            using var keepWarm = new YubiKeyKeepWarm(TimeSpan.FromMinutes(1));
+
+            _ = Assert.Throws<ArgumentException>(() => keepWarm.Add(_yubiKey));
+            _smartCardDeviceMock.Verify(x => x.Connect(), Times.Never());
+        }
+    }
+}
@@ -0,0 +1,50 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using Yubico.Core.Iso7816;
+
+namespace Yubico.YubiKey.TestUtilities.Emulation
+{
+    // The base class for the applications hosted by an EmulatedYubiKey. The
+    // key routes every APDU to the applet selected last, after reassembling
+    // chained commands, and calls Select each time the applet is selected.
+    public abstract class EmulatedApplet
+    {
+        protected EmulatedApplet(EmulatedYubiKey yubiKey)
+        {
+            YubiKey = yubiKey;
+        }
+
+        protected EmulatedYubiKey YubiKey { get; }
+
+        // The AID the applet answers to. The key matches a SELECT on this
+        // prefix, the way the real card does.
+        public abstract ReadOnlyMemory<byte> ApplicationId { get; }
+
+        // Called when the applet is selected. Returns the data of the SELECT
+        // response. Per-session state, such as a verified PIN, should be
+        // cleared here.
+        public abstract byte[] Select();
+
+        public abstract ResponseApdu Process(CommandApdu command);
+
+        protected static ResponseApdu Success(ReadOnlySpan<byte> data) =>
+            new ResponseApdu(data.ToArray(), SWConstants.Success);
+
+        protected static ResponseApdu Success() => new ResponseApdu(Array.Empty<byte>(), SWConstants.Success);
+
+        protected static ResponseApdu Status(short statusWord) => new ResponseApdu(Array.Empty<byte>(), statusWord);
+    }
+}
@@ -0,0 +1,93 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using System.Text;
+using Yubico.Core.Iso7816;
+using Yubico.Core.Tlv;
+
+namespace Yubico.YubiKey.TestUtilities.Emulation
+{
+    // The management application: GET DEVICE INFO, and SET DEVICE INFO
+    // accepted but ignored.
+    public sealed class EmulatedManagementApplet : EmulatedApplet
+    {
+        private const byte GetDeviceInfoInstruction = 0x1D;
+        private const byte SetDeviceInfoInstruction = 0x1C;
+
+        private const byte UsbPrePersCapabilitiesTag = 0x01;
+        private const byte SerialNumberTag = 0x02;
+        private const byte UsbEnabledCapabilitiesTag = 0x03;
+        private const byte FormFactorTag = 0x04;
+        private const byte FirmwareVersionTag = 0x05;
+
+        private static readonly byte[] ManagementAppId = new byte[] { 0xa0, 0x00, 0x00, 0x05, 0x27, 0x47, 0x11, 0x17 };
+
+        // An emulated key has no FIDO interface.
+        public YubiKeyCapabilities Capabilities { get; set; } =
+            YubiKeyCapabilities.Otp | YubiKeyCapabilities.Ccid | YubiKeyCapabilities.Piv | YubiKeyCapabilities.Oath;
+
+        public FormFactor FormFactor { get; set; } = FormFactor.UsbAKeychain;
+
+        public EmulatedManagementApplet(EmulatedYubiKey yubiKey)
+            : base(yubiKey)
+        {
+        }
+
+        public override ReadOnlyMemory<byte> ApplicationId => ManagementAppId;
+
+        public override byte[] Select()
+        {
+            FirmwareVersion version = YubiKey.FirmwareVersion;
+
+            return Encoding.ASCII.GetBytes($"{version.Major}.{version.Minor}.{version.Patch}");
+        }
+
+        public override ResponseApdu Process(CommandApdu command) =>
+            command.Ins switch
+            {
+                GetDeviceInfoInstruction => Success(EncodeDeviceInfo()),
+                SetDeviceInfoInstruction => Success(),
+                _ => Status(SWConstants.InsNotSupported),
+            };
+
+        public YubiKeyDeviceInfo GetDeviceInfo()
+        {
+            _ = YubiKeyDeviceInfo.TryCreateFromResponseData(EncodeDeviceInfo(), out YubiKeyDeviceInfo? deviceInfo);
+
+            return deviceInfo!;
+        }
+
+        // The GET DEVICE INFO response, which is also what the OTP application
+        // returns for its device info slot.
+        internal byte[] EncodeDeviceInfo()
+        {
+            FirmwareVersion version = YubiKey.FirmwareVersion;
+
+            var tlvWriter = new TlvWriter();
+            tlvWriter.WriteUInt16(UsbPrePersCapabilitiesTag, (ushort)Capabilities);
+            tlvWriter.WriteInt32(SerialNumberTag, YubiKey.SerialNumber);
+            tlvWriter.WriteUInt16(UsbEnabledCapabilitiesTag, (ushort)Capabilities);
+            tlvWriter.WriteByte(FormFactorTag, (byte)FormFactor);
+            tlvWriter.WriteValue(FirmwareVersionTag, new byte[] { version.Major, version.Minor, version.Patch });
+            byte[] tlvs = tlvWriter.Encode();
+
+            byte[] encoding = new byte[tlvs.Length + 1];
+            encoding[0] = (byte)tlvs.Length;
+            tlvs.CopyTo(encoding, 1);
+
+            return encoding;
+        }
+    }
+}
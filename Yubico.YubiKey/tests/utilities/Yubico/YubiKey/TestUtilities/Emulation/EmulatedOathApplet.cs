@@ -0,0 +1,352 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using System.Buffers.Binary;
+using System.Collections.Generic;
+using System.Linq;
+using System.Security.Cryptography;
+using Yubico.Core.Iso7816;
+using Yubico.Core.Tlv;
+
+namespace Yubico.YubiKey.TestUtilities.Emulation
+{
+    // The OATH application: credentials can be put, listed, renamed, deleted
+    // and calculated, singly or all at once, with HMAC-SHA1/256/512.
+    // Not emulated: the access password (SET CODE and VALIDATE are refused)
+    // and touch, which is reported but never waited for.
+    public sealed class EmulatedOathApplet : EmulatedApplet
+    {
+        private const byte PutInstruction = 0x01;
+        private const byte DeleteInstruction = 0x02;
+        private const byte ResetInstruction = 0x04;
+        private const byte RenameInstruction = 0x05;
+        private const byte ListInstruction = 0xA1;
+        private const byte CalculateInstruction = 0xA2;
+        private const byte CalculateAllInstruction = 0xA4;
+
+        private const int NameTag = 0x71;
+        private const int NameListTag = 0x72;
+        private const int SecretTag = 0x73;
+        private const int ChallengeTag = 0x74;
+        private const int FullResponseTag = 0x75;
+        private const int TruncatedResponseTag = 0x76;
+        private const int HotpTag = 0x77;
+        private const int PropertyTag = 0x78;
+        private const int VersionTag = 0x79;
+        private const int ImfTag = 0x7A;
+        private const int TouchTag = 0x7C;
+
+        private const byte TypeMask = 0xF0;
+        private const byte HotpType = 0x10;
+        private const byte RequireTouchProperty = 0x02;
+        private const byte TruncatedFormat = 0x01;
+
+        private static readonly byte[] OathAppId = new byte[] { 0xa0, 0x00, 0x00, 0x05, 0x27, 0x21, 0x01 };
+
+        // Credentials in the order they were put, which is the order the key
+        // lists them in.
+        private readonly List<Credential> _credentials = new List<Credential>();
+        private readonly byte[] _salt = new byte[8];
+
+        public EmulatedOathApplet(EmulatedYubiKey yubiKey)
+            : base(yubiKey)
+        {
+            RandomNumberGenerator.Fill(_salt);
+        }
+
+        public override ReadOnlyMemory<byte> ApplicationId => OathAppId;
+
+        public int CredentialCount => _credentials.Count;
+
+        public override byte[] Select()
+        {
+            FirmwareVersion version = YubiKey.FirmwareVersion;
+
+            var tlvWriter = new TlvWriter();
+            tlvWriter.WriteValue(VersionTag, new byte[] { version.Major, version.Minor, version.Patch });
+            tlvWriter.WriteValue(NameTag, _salt);
+
+            return tlvWriter.Encode();
+        }
+
+        public override ResponseApdu Process(CommandApdu command)
+        {
+            try
+            {
+                return command.Ins switch
+                {
+                    PutInstruction => Put(command.Data),
+                    DeleteInstruction => Delete(command.Data),
+                    ResetInstruction => Reset(),
+                    RenameInstruction => Rename(command.Data),
+                    ListInstruction => List(),
+                    CalculateInstruction => Calculate(command.Data, command.P2),
+                    CalculateAllInstruction => CalculateAll(command.Data, command.P2),
+                    _ => Status(SWConstants.InsNotSupported),
+                };
+            }
+            catch (TlvException)
+            {
+                return Status(SWConstants.InvalidCommandDataParameter);
+            }
+        }
+
+        // 71 name, 73 [type|algorithm][digits][secret], then optionally
+        // 7A with the initial HOTP counter. The property byte that requires
+        // touch is written as 78 02, a tag and a value without a length, so
+        // this is parsed by hand rather than with a TlvReader.
+        private ResponseApdu Put(ReadOnlyMemory<byte> data)
+        {
+            ReadOnlySpan<byte> encoding = data.Span;
+            byte[]? name = null;
+            byte[]? secret = null;
+            uint counter = 0;
+            bool requireTouch = false;
+
+            int offset = 0;
+            while (offset + 1 < encoding.Length)
+            {
+                byte tag = encoding[offset++];
+
+                if (tag == PropertyTag)
+                {
+                    requireTouch = (encoding[offset++] & RequireTouchProperty) != 0;
+                    continue;
+                }
+
+                int length = encoding[offset++];
+                if (length == 0x81 && offset < encoding.Length)
+                {
+                    length = encoding[offset++];
+                }
+
+                if (offset + length > encoding.Length)
+                {
+                    return Status(SWConstants.InvalidCommandDataParameter);
+                }
+
+                ReadOnlySpan<byte> value = encoding.Slice(offset, length);
+                offset += length;
+
+                switch (tag)
+                {
+                    case NameTag:
+                        name = value.ToArray();
+                        break;
+
+                    case SecretTag:
+                        secret = value.ToArray();
+                        break;
+
+                    case ImfTag when length == 4:
+                        counter = BinaryPrimitives.ReadUInt32BigEndian(value);
+                        break;
+                }
+            }
+
+            if (name is null || secret is null || secret.Length < 2)
+            {
+                return Status(SWConstants.InvalidCommandDataParameter);
+            }
+
+            var credential = new Credential(name, secret[0], secret[1], secret.AsSpan(2).ToArray())
+            {
+                Counter = counter,
+                RequireTouch = requireTouch,
+            };
+
+            _ = _credentials.RemoveAll(c => c.Name.SequenceEqual(credential.Name));
+            _credentials.Add(credential);
+
+            return Success();
+        }
+
+        private ResponseApdu Delete(ReadOnlyMemory<byte> data)
+        {
+            byte[] name = new TlvReader(data).ReadValue(NameTag).ToArray();
+
+            return _credentials.RemoveAll(c => c.Name.SequenceEqual(name)) > 0
+                ? Success()
+                : Status(SWConstants.DataNotFound);
+        }
+
+        private ResponseApdu Reset()
+        {
+            _credentials.Clear();
+            RandomNumberGenerator.Fill(_salt);
+
+            return Success();
+        }
+
+        private ResponseApdu Rename(ReadOnlyMemory<byte> data)
+        {
+            var tlvReader = new TlvReader(data);
+            byte[] oldName = tlvReader.ReadValue(NameTag).ToArray();
+            byte[] newName = tlvReader.ReadValue(NameTag).ToArray();
+
+            Credential? credential = Find(oldName);
+
+            if (credential is null)
+            {
+                return Status(SWConstants.DataNotFound);
+            }
+
+            if (!(Find(newName) is null))
+            {
+                return Status(SWConstants.FileAlreadyExists);
+            }
+
+            credential.Name = newName;
+
+            return Success();
+        }
+
+        private ResponseApdu List()
+        {
+            var tlvWriter = new TlvWriter();
+
+            foreach (Credential credential in _credentials)
+            {
+                byte[] value = new byte[credential.Name.Length + 1];
+                value[0] = credential.TypeAndAlgorithm;
+                credential.Name.CopyTo(value, 1);
+                tlvWriter.WriteValue(NameListTag, value);
+            }
+
+            return Success(tlvWriter.Encode());
+        }
+
+        private ResponseApdu Calculate(ReadOnlyMemory<byte> data, byte responseFormat)
+        {
+            var tlvReader = new TlvReader(data);
+            byte[] name = tlvReader.ReadValue(NameTag).ToArray();
+            ReadOnlySpan<byte> challenge = tlvReader.ReadValue(ChallengeTag).Span;
+
+            Credential? credential = Find(name);
+
+            if (credential is null)
+            {
+                return Status(SWConstants.DataNotFound);
+            }
+
+            var tlvWriter = new TlvWriter();
+            WriteResponse(tlvWriter, credential, challenge, responseFormat);
+
+            return Success(tlvWriter.Encode());
+        }
+
+        // HOTP and touch credentials are not calculated, since either would
+        // change state or need the user; their names come back with 77 or 7C
+        // and the number of digits.
+        private ResponseApdu CalculateAll(ReadOnlyMemory<byte> data, byte responseFormat)
+        {
+            ReadOnlySpan<byte> challenge = new TlvReader(data).ReadValue(ChallengeTag).Span;
+
+            var tlvWriter = new TlvWriter();
+
+            foreach (Credential credential in _credentials)
+            {
+                tlvWriter.WriteValue(NameTag, credential.Name);
+
+                if (credential.IsHotp)
+                {
+                    tlvWriter.WriteByte(HotpTag, credential.Digits);
+                }
+                else if (credential.RequireTouch)
+                {
+                    tlvWriter.WriteByte(TouchTag, credential.Digits);
+                }
+                else
+                {
+                    WriteResponse(tlvWriter, credential, challenge, responseFormat);
+                }
+            }
+
+            return Success(tlvWriter.Encode());
+        }
+
+        private Credential? Find(byte[] name) => _credentials.FirstOrDefault(c => c.Name.SequenceEqual(name));
+
+        // A HOTP credential ignores the challenge and uses its counter, which
+        // is then incremented.
+        private static void WriteResponse(TlvWriter tlvWriter, Credential credential, ReadOnlySpan<byte> challenge, byte responseFormat)
+        {
+            byte[] message = challenge.ToArray();
+
+            if (credential.IsHotp)
+            {
+                message = new byte[8];
+                BinaryPrimitives.WriteUInt64BigEndian(message, credential.Counter);
+                credential.Counter++;
+            }
+
+            byte[] hmac = credential.ComputeHmac(message);
+
+            if (responseFormat == TruncatedFormat)
+            {
+                // RFC 4226 dynamic truncation, without the final modulus.
+                int offset = hmac[hmac.Length - 1] & 0x0F;
+                byte[] truncated = new byte[5];
+                truncated[0] = credential.Digits;
+                hmac.AsSpan(offset, 4).CopyTo(truncated.AsSpan(1));
+                truncated[1] &= 0x7F;
+
+                tlvWriter.WriteValue(TruncatedResponseTag, truncated);
+            }
+            else
+            {
+                byte[] full = new byte[hmac.Length + 1];
+                full[0] = credential.Digits;
+                hmac.CopyTo(full, 1);
+
+                tlvWriter.WriteValue(FullResponseTag, full);
+            }
+        }
+
+        private sealed class Credential
+        {
+            private readonly byte[] _secret;
+
+            public byte[] Name { get; set; }
+            public byte TypeAndAlgorithm { get; }
+            public byte Digits { get; }
+            public bool RequireTouch { get; set; }
+            public uint Counter { get; set; }
+
+            public bool IsHotp => (TypeAndAlgorithm & TypeMask) == HotpType;
+
+            public Credential(byte[] name, byte typeAndAlgorithm, byte digits, byte[] secret)
+            {
+                Name = name;
+                TypeAndAlgorithm = typeAndAlgorithm;
+                Digits = digits;
+                _secret = secret;
+            }
+
+            public byte[] ComputeHmac(byte[] message)
+            {
+                using KeyedHashAlgorithm hmac = (TypeAndAlgorithm & 0x0F) switch
+                {
+                    0x02 => new HMACSHA256(_secret),
+                    0x03 => new HMACSHA512(_secret),
+                    _ => (KeyedHashAlgorithm)new HMACSHA1(_secret),
+                };
+
+                return hmac.ComputeHash(message);
+            }
+        }
+    }
+}
@@ -0,0 +1,228 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using System.Linq;
+using System.Security.Cryptography;
+using Yubico.Core.Iso7816;
+
+namespace Yubico.YubiKey.TestUtilities.Emulation
+{
+    // The OTP application as it is reached over CCID: the two slots can be
+    // configured, updated, swapped and deleted, and a slot configured for
+    // HMAC-SHA1 challenge-response answers challenges. The serial number and
+    // device info are readable as they are on a real key.
+    // Not emulated: generating Yubico OTPs, Yubico OTP challenge-response,
+    // NDEF, scan codes and touch, which is reported but never waited for.
+    public sealed class EmulatedOtpApplet : EmulatedApplet
+    {
+        private const byte RequestSlotInstruction = 0x01;
+        private const byte ReadStatusInstruction = 0x03;
+
+        private const byte ConfigureShortPressSlot = 0x01;
+        private const byte ConfigureLongPressSlot = 0x03;
+        private const byte UpdateShortPressSlot = 0x04;
+        private const byte UpdateLongPressSlot = 0x05;
+        private const byte SwapSlotsSlot = 0x06;
+        private const byte SerialNumberSlot = 0x10;
+        private const byte GetDeviceInfoSlot = 0x13;
+        private const byte HmacShortPressSlot = 0x30;
+        private const byte HmacLongPressSlot = 0x38;
+
+        // The layout of the slot configuration, see SlotConfigureBase.
+        private const int UidOffset = 16;
+        private const int AesKeyOffset = 22;
+        private const int AesKeyLength = 16;
+        private const int TicketFlagsOffset = 46;
+        private const int ConfigurationFlagsOffset = 47;
+        private const int ConfigurationLength = 52;
+
+        private const byte ChallengeResponseTicketFlag = 0x40;
+        private const byte HmacSha1ConfigurationFlags = 0x22;
+        private const byte HmacLessThan64BytesFlag = 0x04;
+        private const byte ButtonTriggerFlag = 0x08;
+
+        private const byte ShortPressValidMask = 0x01;
+        private const byte LongPressValidMask = 0x02;
+        private const byte ShortPressTouchMask = 0x04;
+        private const byte LongPressTouchMask = 0x08;
+
+        private const int MaximumHmacChallengeLength = 64;
+
+        private static readonly byte[] OtpAppId = new byte[] { 0xa0, 0x00, 0x00, 0x05, 0x27, 0x20, 0x01 };
+
+        // The configuration written to each slot, null if the slot is empty.
+        private readonly byte[]?[] _slots = new byte[]?[2];
+        private byte _sequenceNumber = 1;
+
+        public EmulatedOtpApplet(EmulatedYubiKey yubiKey)
+            : base(yubiKey)
+        {
+        }
+
+        public override ReadOnlyMemory<byte> ApplicationId => OtpAppId;
+
+        public bool ShortPressConfigured => !(_slots[0] is null);
+        public bool LongPressConfigured => !(_slots[1] is null);
+
+        public override byte[] Select() => GetStatus();
+
+        public override ResponseApdu Process(CommandApdu command)
+        {
+            if (command.Ins == ReadStatusInstruction)
+            {
+                return Success(GetStatus());
+            }
+
+            if (command.Ins != RequestSlotInstruction)
+            {
+                return Status(SWConstants.InsNotSupported);
+            }
+
+            switch (command.P1)
+            {
+                case ConfigureShortPressSlot:
+                case ConfigureLongPressSlot:
+                    return Configure(command.P1 == ConfigureShortPressSlot ? 0 : 1, command.Data.Span);
+
+                case UpdateShortPressSlot:
+                case UpdateLongPressSlot:
+                    return Update(command.P1 == UpdateShortPressSlot ? 0 : 1, command.Data.Span);
+
+                case SwapSlotsSlot:
+                    (_slots[0], _slots[1]) = (_slots[1], _slots[0]);
+                    _sequenceNumber++;
+
+                    return Success(GetStatus());
+
+                case SerialNumberSlot:
+                    return Success(new byte[]
+                    {
+                        (byte)(YubiKey.SerialNumber >> 24),
+                        (byte)(YubiKey.SerialNumber >> 16),
+                        (byte)(YubiKey.SerialNumber >> 8),
+                        (byte)YubiKey.SerialNumber,
+                    });
+
+                case GetDeviceInfoSlot:
+                    return Success(YubiKey.Management.EncodeDeviceInfo());
+
+                case HmacShortPressSlot:
+                case HmacLongPressSlot:
+                    return CalculateHmac(command.P1 == HmacShortPressSlot ? 0 : 1, command.Data.Span);
+
+                default:
+                    return Status(SWConstants.FunctionNotSupported);
+            }
+        }
+
+        // An all-zero configuration, which is what DeleteSlot writes, empties
+        // the slot.
+        private ResponseApdu Configure(int slot, ReadOnlySpan<byte> configuration)
+        {
+            if (configuration.Length < ConfigurationLength)
+            {
+                return Status(SWConstants.WrongLength);
+            }
+
+            byte[] stored = configuration.Slice(0, ConfigurationLength).ToArray();
+            _slots[slot] = stored.All(b => b == 0) ? null : stored;
+            _sequenceNumber++;
+
+            return Success(GetStatus());
+        }
+
+        // An update changes only the flags of a configured slot.
+        private ResponseApdu Update(int slot, ReadOnlySpan<byte> configuration)
+        {
+            byte[]? stored = _slots[slot];
+
+            if (stored is null || configuration.Length < ConfigurationLength)
+            {
+                return Status(SWConstants.ConditionsNotSatisfied);
+            }
+
+            configuration.Slice(TicketFlagsOffset - 1, 3).CopyTo(stored.AsSpan(TicketFlagsOffset - 1));
+            _sequenceNumber++;
+
+            return Success(GetStatus());
+        }
+
+        // The HMAC key is the 16 byte AES key field followed by the first four
+        // bytes of the UID field. With HMAC_LT64 set, a 64 byte challenge is
+        // taken to be padded with copies of its last byte.
+        private ResponseApdu CalculateHmac(int slot, ReadOnlySpan<byte> challenge)
+        {
+            byte[]? configuration = _slots[slot];
+
+            if (configuration is null
+                || (configuration[TicketFlagsOffset] & ChallengeResponseTicketFlag) == 0
+                || (configuration[ConfigurationFlagsOffset] & HmacSha1ConfigurationFlags) != HmacSha1ConfigurationFlags)
+            {
+                return Status(SWConstants.ConditionsNotSatisfied);
+            }
+
+            if (challenge.Length == MaximumHmacChallengeLength
+                && (configuration[ConfigurationFlagsOffset] & HmacLessThan64BytesFlag) != 0)
+            {
+                byte padding = challenge[challenge.Length - 1];
+                int length = challenge.Length;
+
+                while (length > 0 && challenge[length - 1] == padding)
+                {
+                    length--;
+                }
+
+                challenge = challenge.Slice(0, length);
+            }
+
+            byte[] key = new byte[AesKeyLength + 4];
+            configuration.AsSpan(AesKeyOffset, AesKeyLength).CopyTo(key);
+            configuration.AsSpan(UidOffset, 4).CopyTo(key.AsSpan(AesKeyLength));
+
+            using var hmac = new HMACSHA1(key);
+
+            return Success(hmac.ComputeHash(challenge.ToArray()));
+        }
+
+        // Version, sequence number, the slot and touch bits and the touch
+        // level.
+        private byte[] GetStatus()
+        {
+            FirmwareVersion version = YubiKey.FirmwareVersion;
+            byte touch = 0;
+
+            if (!(_slots[0] is null))
+            {
+                touch |= ShortPressValidMask;
+                if ((_slots[0]![ConfigurationFlagsOffset] & ButtonTriggerFlag) != 0)
+                {
+                    touch |= ShortPressTouchMask;
+                }
+            }
+
+            if (!(_slots[1] is null))
+            {
+                touch |= LongPressValidMask;
+                if ((_slots[1]![ConfigurationFlagsOffset] & ButtonTriggerFlag) != 0)
+                {
+                    touch |= LongPressTouchMask;
+                }
+            }
+
+            return new byte[] { version.Major, version.Minor, version.Patch, _sequenceNumber, touch, 0 };
+        }
+    }
+}
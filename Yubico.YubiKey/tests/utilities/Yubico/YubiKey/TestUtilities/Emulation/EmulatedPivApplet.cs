@@ -0,0 +1,757 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using System.Numerics;
+using System.Security.Cryptography;
+using Yubico.Core.Iso7816;
+using Yubico.Core.Tlv;
+using Yubico.YubiKey.Piv;
+using Yubico.YubiKey.Piv.Commands;
+
+namespace Yubico.YubiKey.TestUtilities.Emulation
+{
+    // The PIV application. It keeps a PIN, PUK and management key with the
+    // factory defaults, generates ECC P-256/P-384 and RSA 1024/2048 keys in
+    // any slot, signs and decrypts with them, stores data objects and answers
+    // GET METADATA.
+    // Not emulated: importing keys, attestation, key agreement, touch (a
+    // touch policy is recorded and reported, but never waited for) and
+    // PIN-protected management keys beyond storing the data objects.
+    public sealed class EmulatedPivApplet : EmulatedApplet
+    {
+        private const byte VerifyInstruction = 0x20;
+        private const byte ChangeReferenceInstruction = 0x24;
+        private const byte ResetRetryInstruction = 0x2C;
+        private const byte GenerateKeyPairInstruction = 0x47;
+        private const byte AuthenticateInstruction = 0x87;
+        private const byte GetDataInstruction = 0xCB;
+        private const byte PutDataInstruction = 0xDB;
+        private const byte GetMetadataInstruction = 0xF7;
+        private const byte GetSerialNumberInstruction = 0xF8;
+        private const byte SetPinRetriesInstruction = 0xFA;
+        private const byte ResetInstruction = 0xFB;
+        private const byte GetVersionInstruction = 0xFD;
+        private const byte SetManagementKeyInstruction = 0xFF;
+
+        private const int DynamicAuthenticationTag = 0x7C;
+        private const int WitnessTag = 0x80;
+        private const int ChallengeTag = 0x81;
+        private const int ResponseTag = 0x82;
+        private const int ExponentiationTag = 0x85;
+        private const int ControlReferenceTag = 0xAC;
+        private const int AlgorithmTag = 0x80;
+        private const int PinPolicyTag = 0xAA;
+        private const int TouchPolicyTag = 0xAB;
+        private const int PublicKeyTemplateTag = 0x7F49;
+        private const int ModulusTag = 0x81;
+        private const int PublicExponentTag = 0x82;
+        private const int PointTag = 0x86;
+        private const int DataObjectIdTag = 0x5C;
+        private const int DataTag = 0x53;
+
+        private const int PinLength = 8;
+        private const int DefaultRetries = 3;
+
+        private static readonly byte[] PivAppId = new byte[] { 0xa0, 0x00, 0x00, 0x03, 0x08 };
+
+        private static readonly byte[] SelectResponse = new byte[]
+        {
+            0x61, 0x11, 0x4F, 0x06, 0x00, 0x00, 0x10, 0x00, 0x01, 0x00,
+            0x79, 0x07, 0x4F, 0x05, 0xA0, 0x00, 0x00, 0x03, 0x08,
+        };
+
+        private static readonly byte[] DefaultPin = PadPin("123456");
+        private static readonly byte[] DefaultPuk = PadPin("12345678");
+
+        private static readonly byte[] DefaultManagementKey = new byte[]
+        {
+            0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+            0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+            0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+        };
+
+        private readonly Dictionary<byte, SlotKey> _keys = new Dictionary<byte, SlotKey>();
+        private readonly Dictionary<int, byte[]> _dataObjects = new Dictionary<int, byte[]>();
+
+        private byte[] _pin = DefaultPin;
+        private byte[] _puk = DefaultPuk;
+        private int _pinRetries = DefaultRetries;
+        private int _pukRetries = DefaultRetries;
+        private PivAlgorithm _managementKeyAlgorithm = PivAlgorithm.TripleDes;
+        private byte[] _managementKey = DefaultManagementKey;
+
+        // Per-session state, cleared on SELECT.
+        private bool _pinVerified;
+        private bool _pinJustVerified;
+        private bool _managementKeyAuthenticated;
+        private byte[]? _witness;
+        private byte[]? _challenge;
+
+        public int PinRetriesRemaining { get; private set; } = DefaultRetries;
+        public int PukRetriesRemaining { get; private set; } = DefaultRetries;
+
+        public EmulatedPivApplet(EmulatedYubiKey yubiKey)
+            : base(yubiKey)
+        {
+        }
+
+        public override ReadOnlyMemory<byte> ApplicationId => PivAppId;
+
+        public override byte[] Select()
+        {
+            _pinVerified = false;
+            _pinJustVerified = false;
+            _managementKeyAuthenticated = false;
+            _witness = null;
+            _challenge = null;
+
+            return SelectResponse;
+        }
+
+        public override ResponseApdu Process(CommandApdu command)
+        {
+            // A PIN policy of Always is satisfied only by a VERIFY immediately
+            // before the command.
+            bool pinJustVerified = _pinJustVerified;
+            _pinJustVerified = false;
+
+            try
+            {
+                return command.Ins switch
+                {
+                    VerifyInstruction => Verify(command.Data.Span),
+                    ChangeReferenceInstruction => ChangeReference(command.P2, command.Data.Span),
+                    ResetRetryInstruction => ResetRetry(command.Data.Span),
+                    AuthenticateInstruction when command.P2 == PivSlot.Management =>
+                        AuthenticateManagementKey(command.P1, command.Data),
+                    AuthenticateInstruction => Authenticate(command.P2, command.Data, pinJustVerified),
+                    GenerateKeyPairInstruction => GenerateKeyPair(command.P2, command.Data),
+                    GetDataInstruction => GetData(command.Data),
+                    PutDataInstruction => PutData(command.Data),
+                    GetMetadataInstruction => GetMetadata(command.P2),
+                    GetSerialNumberInstruction => Success(new byte[]
+                    {
+                        (byte)(YubiKey.SerialNumber >> 24),
+                        (byte)(YubiKey.SerialNumber >> 16),
+                        (byte)(YubiKey.SerialNumber >> 8),
+                        (byte)YubiKey.SerialNumber,
+                    }),
+                    SetPinRetriesInstruction => SetPinRetries(command.P1, command.P2),
+                    ResetInstruction => ResetApplication(),
+                    GetVersionInstruction => Success(new byte[]
+                    {
+                        YubiKey.FirmwareVersion.Major,
+                        YubiKey.FirmwareVersion.Minor,
+                        YubiKey.FirmwareVersion.Patch,
+                    }),
+                    SetManagementKeyInstruction => SetManagementKey(command.Data.Span),
+                    _ => Status(SWConstants.InsNotSupported),
+                };
+            }
+            catch (TlvException)
+            {
+                return Status(SWConstants.InvalidCommandDataParameter);
+            }
+        }
+
+        private ResponseApdu Verify(ReadOnlySpan<byte> pin)
+        {
+            if (pin.IsEmpty)
+            {
+                return _pinVerified ? Success() : Status((short)(SWConstants.VerifyFail | PinRetriesRemaining));
+            }
+
+            if (PinRetriesRemaining == 0)
+            {
+                return Status(SWConstants.AuthenticationMethodBlocked);
+            }
+
+            if (!pin.SequenceEqual(_pin))
+            {
+                _pinVerified = false;
+                PinRetriesRemaining--;
+
+                return Status((short)(SWConstants.VerifyFail | PinRetriesRemaining));
+            }
+
+            PinRetriesRemaining = _pinRetries;
+            _pinVerified = true;
+            _pinJustVerified = true;
+
+            return Success();
+        }
+
+        private ResponseApdu ChangeReference(byte reference, ReadOnlySpan<byte> data)
+        {
+            if (data.Length != 2 * PinLength)
+            {
+                return Status(SWConstants.InvalidCommandDataParameter);
+            }
+
+            bool isPuk = reference == PivSlot.Puk;
+            int remaining = isPuk ? PukRetriesRemaining : PinRetriesRemaining;
+
+            if (remaining == 0)
+            {
+                return Status(SWConstants.AuthenticationMethodBlocked);
+            }
+
+            if (!data.Slice(0, PinLength).SequenceEqual(isPuk ? _puk : _pin))
+            {
+                remaining--;
+                SetRemaining(isPuk, remaining);
+
+                return Status((short)(SWConstants.VerifyFail | remaining));
+            }
+
+            if (isPuk)
+            {
+                _puk = data.Slice(PinLength).ToArray();
+                PukRetriesRemaining = _pukRetries;
+            }
+            else
+            {
+                _pin = data.Slice(PinLength).ToArray();
+                PinRetriesRemaining = _pinRetries;
+            }
+
+            return Success();
+        }
+
+        private ResponseApdu ResetRetry(ReadOnlySpan<byte> data)
+        {
+            if (data.Length != 2 * PinLength)
+            {
+                return Status(SWConstants.InvalidCommandDataParameter);
+            }
+
+            if (PukRetriesRemaining == 0)
+            {
+                return Status(SWConstants.AuthenticationMethodBlocked);
+            }
+
+            if (!data.Slice(0, PinLength).SequenceEqual(_puk))
+            {
+                PukRetriesRemaining--;
+
+                return Status((short)(SWConstants.VerifyFail | PukRetriesRemaining));
+            }
+
+            _pin = data.Slice(PinLength).ToArray();
+            PinRetriesRemaining = _pinRetries;
+            PukRetriesRemaining = _pukRetries;
+
+            return Success();
+        }
+
+        private void SetRemaining(bool isPuk, int remaining)
+        {
+            if (isPuk)
+            {
+                PukRetriesRemaining = remaining;
+            }
+            else
+            {
+                PinRetriesRemaining = remaining;
+            }
+        }
+
+        // Mutual authentication is two commands: 80 00 asks for a witness,
+        // which the host decrypts and returns in 80 along with its own
+        // challenge in 81. Single authentication asks for a challenge with
+        // 81 00 and returns it encrypted in 82.
+        private ResponseApdu AuthenticateManagementKey(byte algorithm, ReadOnlyMemory<byte> data)
+        {
+            if (algorithm != (byte)_managementKeyAlgorithm)
+            {
+                return Status(SWConstants.IncorrectP1orP2);
+            }
+
+            Dictionary<int, ReadOnlyMemory<byte>> values = ReadDynamicAuthentication(data);
+            int blockSize = _managementKeyAlgorithm == PivAlgorithm.TripleDes ? 8 : 16;
+
+            if (values.TryGetValue(WitnessTag, out ReadOnlyMemory<byte> witness) && witness.IsEmpty)
+            {
+                _witness = RandomBytes(blockSize);
+
+                return Success(EncodeDynamicAuthentication(WitnessTag, TransformManagementKeyBlock(_witness, true)));
+            }
+
+            if (values.TryGetValue(ChallengeTag, out ReadOnlyMemory<byte> hostChallenge) && hostChallenge.IsEmpty)
+            {
+                _challenge = RandomBytes(blockSize);
+
+                return Success(EncodeDynamicAuthentication(ChallengeTag, _challenge));
+            }
+
+            if (!(_witness is null) && !witness.IsEmpty && !hostChallenge.IsEmpty)
+            {
+                bool matches = witness.Span.SequenceEqual(_witness);
+                _witness = null;
+
+                if (!matches)
+                {
+                    return Status(SWConstants.SecurityStatusNotSatisfied);
+                }
+
+                _managementKeyAuthenticated = true;
+
+                return Success(EncodeDynamicAuthentication(
+                    ResponseTag, TransformManagementKeyBlock(hostChallenge.Span, true)));
+            }
+
+            if (!(_challenge is null) && values.TryGetValue(ResponseTag, out ReadOnlyMemory<byte> response))
+            {
+                bool matches = response.Span.SequenceEqual(TransformManagementKeyBlock(_challenge, true));
+                _challenge = null;
+
+                if (!matches)
+                {
+                    return Status(SWConstants.SecurityStatusNotSatisfied);
+                }
+
+                _managementKeyAuthenticated = true;
+
+                return Success();
+            }
+
+            return Status(SWConstants.ConditionsNotSatisfied);
+        }
+
+        private ResponseApdu Authenticate(byte slot, ReadOnlyMemory<byte> data, bool pinJustVerified)
+        {
+            if (!_keys.TryGetValue(slot, out SlotKey? key))
+            {
+                return Status(SWConstants.InvalidCommandDataParameter);
+            }
+
+            bool pinSatisfied = key.PinPolicy switch
+            {
+                PivPinPolicy.Never => true,
+                PivPinPolicy.Always => pinJustVerified,
+                _ => _pinVerified,
+            };
+
+            if (!pinSatisfied)
+            {
+                return Status(SWConstants.SecurityStatusNotSatisfied);
+            }
+
+            Dictionary<int, ReadOnlyMemory<byte>> values = ReadDynamicAuthentication(data);
+
+            if (values.ContainsKey(ExponentiationTag))
+            {
+                return Status(SWConstants.FunctionNotSupported);
+            }
+
+            if (!values.TryGetValue(ChallengeTag, out ReadOnlyMemory<byte> input))
+            {
+                return Status(SWConstants.InvalidCommandDataParameter);
+            }
+
+            byte[] result = key.PrivateOperation(input.Span);
+
+            return Success(EncodeDynamicAuthentication(ResponseTag, result));
+        }
+
+        private ResponseApdu GenerateKeyPair(byte slot, ReadOnlyMemory<byte> data)
+        {
+            if (!_managementKeyAuthenticated)
+            {
+                return Status(SWConstants.SecurityStatusNotSatisfied);
+            }
+
+            var tlvReader = new TlvReader(data);
+            Dictionary<int, ReadOnlyMemory<byte>> values = ReadAll(tlvReader.ReadNestedTlv(ControlReferenceTag));
+
+            if (!values.TryGetValue(AlgorithmTag, out ReadOnlyMemory<byte> algorithm) || algorithm.Length != 1)
+            {
+                return Status(SWConstants.InvalidCommandDataParameter);
+            }
+
+            var pinPolicy = (PivPinPolicy)GetPolicy(values, PinPolicyTag);
+            var touchPolicy = (PivTouchPolicy)GetPolicy(values, TouchPolicyTag);
+
+            if (pinPolicy == PivPinPolicy.None)
+            {
+                pinPolicy = slot switch
+                {
+                    PivSlot.Signing => PivPinPolicy.Always,
+                    PivSlot.CardAuthentication => PivPinPolicy.Never,
+                    _ => PivPinPolicy.Once,
+                };
+            }
+
+            if (touchPolicy == PivTouchPolicy.None)
+            {
+                touchPolicy = PivTouchPolicy.Never;
+            }
+
+            SlotKey? key = SlotKey.Generate((PivAlgorithm)algorithm.Span[0], pinPolicy, touchPolicy);
+
+            if (key is null)
+            {
+                return Status(SWConstants.InvalidCommandDataParameter);
+            }
+
+            if (_keys.TryGetValue(slot, out SlotKey? previous))
+            {
+                previous.Dispose();
+            }
+
+            _keys[slot] = key;
+
+            var tlvWriter = new TlvWriter();
+            using (tlvWriter.WriteNestedTlv(PublicKeyTemplateTag))
+            {
+                tlvWriter.WriteEncoded(key.PublicKey);
+            }
+
+            return Success(tlvWriter.Encode());
+        }
+
+        private ResponseApdu GetData(ReadOnlyMemory<byte> data)
+        {
+            int objectId = ReadDataObjectId(new TlvReader(data));
+
+            return _dataObjects.TryGetValue(objectId, out byte[]? encoding)
+                ? Success(encoding)
+                : Status(SWConstants.FileOrApplicationNotFound);
+        }
+
+        private ResponseApdu PutData(ReadOnlyMemory<byte> data)
+        {
+            if (!_managementKeyAuthenticated)
+            {
+                return Status(SWConstants.SecurityStatusNotSatisfied);
+            }
+
+            var tlvReader = new TlvReader(data);
+            int objectId = ReadDataObjectId(tlvReader);
+            ReadOnlyMemory<byte> encoding = tlvReader.ReadEncoded(DataTag);
+
+            // Storing 53 00 deletes the object.
+            if (encoding.Length <= 2 && encoding.Span[encoding.Length - 1] == 0)
+            {
+                _ = _dataObjects.Remove(objectId);
+            }
+            else
+            {
+                _dataObjects[objectId] = encoding.ToArray();
+            }
+
+            return Success();
+        }
+
+        private ResponseApdu GetMetadata(byte slot)
+        {
+            var tlvWriter = new TlvWriter();
+
+            switch (slot)
+            {
+                case PivSlot.Pin:
+                case PivSlot.Puk:
+                    bool isPuk = slot == PivSlot.Puk;
+                    tlvWriter.WriteByte(1, (byte)PivAlgorithm.Pin);
+                    tlvWriter.WriteByte(5, (byte)((isPuk ? _puk : _pin).SequenceEqual(isPuk ? DefaultPuk : DefaultPin) ? 1 : 0));
+                    tlvWriter.WriteValue(6, new byte[]
+                    {
+                        (byte)(isPuk ? _pukRetries : _pinRetries),
+                        (byte)(isPuk ? PukRetriesRemaining : PinRetriesRemaining),
+                    });
+                    break;
+
+                case PivSlot.Management:
+                    tlvWriter.WriteByte(1, (byte)_managementKeyAlgorithm);
+                    tlvWriter.WriteValue(2, new byte[] { 0x00, (byte)PivTouchPolicy.Never });
+                    tlvWriter.WriteByte(5, (byte)(_managementKey.SequenceEqual(DefaultManagementKey) ? 1 : 0));
+                    break;
+
+                default:
+                    if (!_keys.TryGetValue(slot, out SlotKey? key))
+                    {
+                        return Status(SWConstants.FileOrApplicationNotFound);
+                    }
+
+                    tlvWriter.WriteByte(1, (byte)key.Algorithm);
+                    tlvWriter.WriteValue(2, new byte[] { (byte)key.PinPolicy, (byte)key.TouchPolicy });
+                    tlvWriter.WriteByte(3, 1);
+                    tlvWriter.WriteValue(4, key.PublicKey);
+                    break;
+            }
+
+            return Success(tlvWriter.Encode());
+        }
+
+        private ResponseApdu SetPinRetries(byte pinRetries, byte pukRetries)
+        {
+            if (!_managementKeyAuthenticated || !_pinVerified)
+            {
+                return Status(SWConstants.SecurityStatusNotSatisfied);
+            }
+
+            _pin = DefaultPin;
+            _puk = DefaultPuk;
+            _pinRetries = pinRetries;
+            _pukRetries = pukRetries;
+            PinRetriesRemaining = pinRetries;
+            PukRetriesRemaining = pukRetries;
+
+            return Success();
+        }
+
+        // The application can only be reset once both the PIN and PUK are
+        // blocked.
+        private ResponseApdu ResetApplication()
+        {
+            if (PinRetriesRemaining != 0 || PukRetriesRemaining != 0)
+            {
+                return Status(SWConstants.ConditionsNotSatisfied);
+            }
+
+            foreach (SlotKey key in _keys.Values)
+            {
+                key.Dispose();
+            }
+
+            _keys.Clear();
+            _dataObjects.Clear();
+            _pin = DefaultPin;
+            _puk = DefaultPuk;
+            _pinRetries = DefaultRetries;
+            _pukRetries = DefaultRetries;
+            PinRetriesRemaining = DefaultRetries;
+            PukRetriesRemaining = DefaultRetries;
+            _managementKeyAlgorithm = PivAlgorithm.TripleDes;
+            _managementKey = DefaultManagementKey;
+            _ = Select();
+
+            return Success();
+        }
+
+        // The data is the algorithm, 9B, the key length and the key.
+        private ResponseApdu SetManagementKey(ReadOnlySpan<byte> data)
+        {
+            if (!_managementKeyAuthenticated)
+            {
+                return Status(SWConstants.SecurityStatusNotSatisfied);
+            }
+
+            if (data.Length < 3 || data[1] != PivSlot.Management || data.Length != 3 + data[2])
+            {
+                return Status(SWConstants.InvalidCommandDataParameter);
+            }
+
+            _managementKeyAlgorithm = (PivAlgorithm)data[0];
+            _managementKey = data.Slice(3).ToArray();
+
+            return Success();
+        }
+
+        private byte[] TransformManagementKeyBlock(ReadOnlySpan<byte> block, bool isEncrypting)
+        {
+            using ISymmetricForManagementKey cipher = _managementKeyAlgorithm == PivAlgorithm.TripleDes
+                ? (ISymmetricForManagementKey)new TripleDesForManagementKey(_managementKey, isEncrypting)
+                : new AesForManagementKey(_managementKey, _managementKey.Length, isEncrypting);
+
+            byte[] input = block.ToArray();
+            byte[] output = new byte[input.Length];
+            _ = cipher.TransformBlock(input, 0, input.Length, output, 0);
+
+            return output;
+        }
+
+        private static Dictionary<int, ReadOnlyMemory<byte>> ReadDynamicAuthentication(ReadOnlyMemory<byte> data) =>
+            ReadAll(new TlvReader(data).ReadNestedTlv(DynamicAuthenticationTag));
+
+        private static Dictionary<int, ReadOnlyMemory<byte>> ReadAll(TlvReader tlvReader)
+        {
+            var values = new Dictionary<int, ReadOnlyMemory<byte>>();
+
+            while (tlvReader.HasData)
+            {
+                int tag = tlvReader.PeekTag();
+                values[tag] = tlvReader.ReadValue(tag);
+            }
+
+            return values;
+        }
+
+        private static byte[] EncodeDynamicAuthentication(int tag, ReadOnlySpan<byte> value)
+        {
+            var tlvWriter = new TlvWriter();
+            using (tlvWriter.WriteNestedTlv(DynamicAuthenticationTag))
+            {
+                tlvWriter.WriteValue(tag, value);
+            }
+
+            return tlvWriter.Encode();
+        }
+
+        private static byte GetPolicy(Dictionary<int, ReadOnlyMemory<byte>> values, int tag) =>
+            values.TryGetValue(tag, out ReadOnlyMemory<byte> value) && value.Length == 1 ? value.Span[0] : (byte)0;
+
+        private static int ReadDataObjectId(TlvReader tlvReader)
+        {
+            ReadOnlySpan<byte> id = tlvReader.ReadValue(DataObjectIdTag).Span;
+            int objectId = 0;
+
+            foreach (byte b in id)
+            {
+                objectId = (objectId << 8) | b;
+            }
+
+            return objectId;
+        }
+
+        private static byte[] RandomBytes(int count)
+        {
+            byte[] bytes = new byte[count];
+            RandomNumberGenerator.Fill(bytes);
+
+            return bytes;
+        }
+
+        private static byte[] PadPin(string pin)
+        {
+            byte[] padded = Enumerable.Repeat((byte)0xFF, PinLength).ToArray();
+            System.Text.Encoding.ASCII.GetBytes(pin).CopyTo(padded, 0);
+
+            return padded;
+        }
+
+        // A private key in a slot, with the policies it was generated with and
+        // its public key in the encoding GET METADATA returns (86 point, or
+        // 81 modulus 82 exponent).
+        private sealed class SlotKey : IDisposable
+        {
+            private readonly ECDsa? _ecdsa;
+            private readonly RSAParameters _rsaParameters;
+
+            public PivAlgorithm Algorithm { get; }
+            public PivPinPolicy PinPolicy { get; }
+            public PivTouchPolicy TouchPolicy { get; }
+            public byte[] PublicKey { get; }
+
+            private SlotKey(PivAlgorithm algorithm, PivPinPolicy pinPolicy, PivTouchPolicy touchPolicy, ECDsa? ecdsa, RSAParameters rsaParameters)
+            {
+                Algorithm = algorithm;
+                PinPolicy = pinPolicy;
+                TouchPolicy = touchPolicy;
+                _ecdsa = ecdsa;
+                _rsaParameters = rsaParameters;
+
+                var tlvWriter = new TlvWriter();
+
+                if (ecdsa is null)
+                {
+                    tlvWriter.WriteValue(ModulusTag, rsaParameters.Modulus);
+                    tlvWriter.WriteValue(PublicExponentTag, rsaParameters.Exponent);
+                }
+                else
+                {
+                    ECParameters parameters = ecdsa.ExportParameters(false);
+                    byte[] point = new byte[1 + parameters.Q.X.Length + parameters.Q.Y.Length];
+                    point[0] = 0x04;
+                    parameters.Q.X.CopyTo(point, 1);
+                    parameters.Q.Y.CopyTo(point, 1 + parameters.Q.X.Length);
+                    tlvWriter.WriteValue(PointTag, point);
+                }
+
+                PublicKey = tlvWriter.Encode();
+            }
+
+            public static SlotKey? Generate(PivAlgorithm algorithm, PivPinPolicy pinPolicy, PivTouchPolicy touchPolicy)
+            {
+                switch (algorithm)
+                {
+                    case PivAlgorithm.EccP256:
+                    case PivAlgorithm.EccP384:
+                        ECCurve curve = algorithm == PivAlgorithm.EccP256 ? ECCurve.NamedCurves.nistP256 : ECCurve.NamedCurves.nistP384;
+
+                        return new SlotKey(algorithm, pinPolicy, touchPolicy, ECDsa.Create(curve), default);
+
+                    case PivAlgorithm.Rsa1024:
+                    case PivAlgorithm.Rsa2048:
+                        using (var rsa = RSA.Create(algorithm == PivAlgorithm.Rsa1024 ? 1024 : 2048))
+                        {
+                            return new SlotKey(algorithm, pinPolicy, touchPolicy, null, rsa.ExportParameters(true));
+                        }
+
+                    default:
+                        return null;
+                }
+            }
+
+            // ECC keys sign the digest and return a DER signature. RSA keys do
+            // the raw private key operation on the already padded block, which
+            // is both signing and decrypting.
+            public byte[] PrivateOperation(ReadOnlySpan<byte> input)
+            {
+                if (!(_ecdsa is null))
+                {
+                    return ToDerSignature(_ecdsa.SignHash(input.ToArray()));
+                }
+
+                var message = new BigInteger(input, isUnsigned: true, isBigEndian: true);
+                var exponent = new BigInteger(_rsaParameters.D, isUnsigned: true, isBigEndian: true);
+                var modulus = new BigInteger(_rsaParameters.Modulus, isUnsigned: true, isBigEndian: true);
+                byte[] value = BigInteger.ModPow(message, exponent, modulus).ToByteArray(isUnsigned: true, isBigEndian: true);
+
+                byte[] result = new byte[_rsaParameters.Modulus!.Length];
+                value.CopyTo(result, result.Length - value.Length);
+
+                return result;
+            }
+
+            public void Dispose() => _ecdsa?.Dispose();
+
+            private static byte[] ToDerSignature(byte[] signature)
+            {
+                int half = signature.Length / 2;
+
+                var tlvWriter = new TlvWriter();
+                using (tlvWriter.WriteNestedTlv(0x30))
+                {
+                    tlvWriter.WriteValue(0x02, ToDerInteger(signature.AsSpan(0, half)));
+                    tlvWriter.WriteValue(0x02, ToDerInteger(signature.AsSpan(half)));
+                }
+
+                return tlvWriter.Encode();
+            }
+
+            private static byte[] ToDerInteger(ReadOnlySpan<byte> value)
+            {
+                while (value.Length > 1 && value[0] == 0)
+                {
+                    value = value.Slice(1);
+                }
+
+                if ((value[0] & 0x80) == 0)
+                {
+                    return value.ToArray();
+                }
+
+                byte[] integer = new byte[value.Length + 1];
+                value.CopyTo(integer.AsSpan(1));
+
+                return integer;
+            }
+        }
+    }
+}
@@ -0,0 +1,55 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using Yubico.Core.Devices.SmartCard;
+using Yubico.Core.Iso7816;
+
+namespace Yubico.YubiKey.TestUtilities.Emulation
+{
+    public sealed class EmulatedSmartCardConnection : ISmartCardConnection, ISmartCardConnectionStatus
+    {
+        private readonly EmulatedYubiKey _yubiKey;
+
+        public EmulatedSmartCardConnection(EmulatedYubiKey yubiKey)
+        {
+            _yubiKey = yubiKey;
+        }
+
+        // Nothing else can reset an emulated card, so a transaction has nothing
+        // to protect.
+        public IDisposable BeginTransaction(out bool cardWasReset)
+        {
+            cardWasReset = false;
+
+            return new EmptyTransaction();
+        }
+
+        public ResponseApdu Transmit(CommandApdu commandApdu) => _yubiKey.Transmit(commandApdu);
+
+        public SmartCardConnectionStatus GetStatus() =>
+            new SmartCardConnectionStatus(SmartCardState.Specific, SmartCardProtocol.T1, _yubiKey.Atr, 0);
+
+        public void Dispose()
+        {
+        }
+
+        private sealed class EmptyTransaction : IDisposable
+        {
+            public void Dispose()
+            {
+            }
+        }
+    }
+}
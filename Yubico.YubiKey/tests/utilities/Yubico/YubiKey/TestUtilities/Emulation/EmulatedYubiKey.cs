@@ -0,0 +1,157 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Threading;
+using Yubico.Core.Devices.SmartCard;
+using Yubico.Core.Iso7816;
+
+namespace Yubico.YubiKey.TestUtilities.Emulation
+{
+    // A software YubiKey, presented to the SDK as a smart card reader.
+    // It hosts PIV, OATH, Management and OTP applets that keep their state
+    // in memory and do real cryptography, so sessions built on top of it
+    // behave as they would against a key, minus touch and the hardware.
+    // Use AsYubiKeyDevice to hand it to the SDK, and Latency to make it
+    // answer as slowly as a real key.
+    // Many of these can run in one process, which is what makes it useful for
+    // load tests and benchmarks.
+    public sealed class EmulatedYubiKey : SmartCardDevice
+    {
+        private const byte SelectInstruction = 0xA4;
+        private const byte SelectByNameP1 = 0x04;
+        private const byte ChainingClaBit = 0x10;
+
+        private readonly object _lock = new object();
+        private readonly EmulatedApplet[] _applets;
+        private readonly MemoryStream _chainedData = new MemoryStream();
+        private EmulatedApplet? _selected;
+        private long _commandCount;
+
+        public int SerialNumber { get; }
+        public FirmwareVersion FirmwareVersion { get; }
+        public EmulatorLatency Latency { get; } = new EmulatorLatency();
+
+        public EmulatedManagementApplet Management { get; }
+        public EmulatedPivApplet Piv { get; }
+        public EmulatedOathApplet Oath { get; }
+        public EmulatedOtpApplet Otp { get; }
+
+        // The number of APDUs this key has processed, counting each link of a
+        // command chain.
+        public long CommandCount => Interlocked.Read(ref _commandCount);
+
+        public EmulatedYubiKey(int serialNumber)
+            : this(serialNumber, new FirmwareVersion(5, 4, 3))
+        {
+        }
+
+        public EmulatedYubiKey(int serialNumber, FirmwareVersion firmwareVersion)
+            : base("emulated:" + serialNumber.ToString(System.Globalization.CultureInfo.InvariantCulture), null)
+        {
+            SerialNumber = serialNumber;
+            FirmwareVersion = firmwareVersion;
+
+            Management = new EmulatedManagementApplet(this);
+            Piv = new EmulatedPivApplet(this);
+            Oath = new EmulatedOathApplet(this);
+            Otp = new EmulatedOtpApplet(this);
+            _applets = new EmulatedApplet[] { Management, Piv, Oath, Otp };
+        }
+
+        // Creates count keys with consecutive serial numbers.
+        public static IReadOnlyList<EmulatedYubiKey> CreateMany(int count, int firstSerialNumber = 10_000_000) =>
+            Enumerable.Range(firstSerialNumber, count).Select(serial => new EmulatedYubiKey(serial)).ToList();
+
+        public override ISmartCardConnection Connect() => new EmulatedSmartCardConnection(this);
+
+        // A YubiKeyDevice that reaches this key over its smart card interface.
+        public IYubiKeyDevice AsYubiKeyDevice() => new YubiKeyDevice(this, Management.GetDeviceInfo());
+
+        internal ResponseApdu Transmit(CommandApdu command)
+        {
+            lock (_lock)
+            {
+                _ = Interlocked.Increment(ref _commandCount);
+
+                ResponseApdu response = Dispatch(command);
+                Latency.Wait(command.Ins);
+
+                return response;
+            }
+        }
+
+        private ResponseApdu Dispatch(CommandApdu command)
+        {
+            if (command.Ins == SelectInstruction && command.P1 == SelectByNameP1)
+            {
+                return Select(command.Data.Span);
+            }
+
+            if (_selected is null)
+            {
+                return new ResponseApdu(Array.Empty<byte>(), SWConstants.ConditionsNotSatisfied);
+            }
+
+            if ((command.Cla & ChainingClaBit) != 0)
+            {
+                _chainedData.Write(command.Data.Span);
+
+                return new ResponseApdu(Array.Empty<byte>(), SWConstants.Success);
+            }
+
+            if (_chainedData.Length > 0)
+            {
+                _chainedData.Write(command.Data.Span);
+                command = new CommandApdu
+                {
+                    Cla = command.Cla,
+                    Ins = command.Ins,
+                    P1 = command.P1,
+                    P2 = command.P2,
+                    Data = _chainedData.ToArray(),
+                    Ne = command.Ne,
+                };
+                _chainedData.SetLength(0);
+            }
+
+            return _selected.Process(command);
+        }
+
+        private ResponseApdu Select(ReadOnlySpan<byte> applicationId)
+        {
+            _chainedData.SetLength(0);
+
+            foreach (EmulatedApplet applet in _applets)
+            {
+                ReadOnlySpan<byte> appletId = applet.ApplicationId.Span;
+                int length = Math.Min(appletId.Length, applicationId.Length);
+
+                if (length > 0 && appletId.Slice(0, length).SequenceEqual(applicationId.Slice(0, length)))
+                {
+                    _selected = applet;
+
+                    return new ResponseApdu(applet.Select(), SWConstants.Success);
+                }
+            }
+
+            _selected = null;
+
+            return new ResponseApdu(Array.Empty<byte>(), SWConstants.FileOrApplicationNotFound);
+        }
+    }
+}
@@ -0,0 +1,61 @@
+// Copyright 2022 Yubico AB
+//
+// Licensed under the Apache License, Version 2.0 (the "License").
+// You may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+using System;
+using System.Diagnostics;
+using System.Threading;
+
+namespace Yubico.YubiKey.TestUtilities.Emulation
+{
+    // How long an EmulatedYubiKey takes to answer, by APDU instruction. The
+    // key holds its lock while it waits, so, like a real key, it processes one
+    // command at a time no matter how many threads are sending.
+    public sealed class EmulatorLatency
+    {
+        private readonly TimeSpan?[] _perInstruction = new TimeSpan?[256];
+
+        // The latency of any instruction that has not been given its own.
+        public TimeSpan Default { get; set; }
+
+        public TimeSpan this[byte instruction]
+        {
+            get => _perInstruction[instruction] ?? Default;
+            set => _perInstruction[instruction] = value;
+        }
+
+        internal void Wait(byte instruction)
+        {
+            TimeSpan latency = this[instruction];
+
+            if (latency <= TimeSpan.Zero)
+            {
+                return;
+            }
+
+            // Thread.Sleep is only good to a millisecond or so, which is the
+            // same order as many APDUs. Sleep for most of it and spin the rest.
+            long deadline = Stopwatch.GetTimestamp() + (long)(latency.TotalSeconds * Stopwatch.Frequency);
+
+            if (latency > TimeSpan.FromMilliseconds(2))
+            {
+                Thread.Sleep(latency - TimeSpan.FromMilliseconds(2));
+            }
+
+            while (Stopwatch.GetTimestamp() < deadline)
+            {
+                Thread.SpinWait(20);
+            }
+        }
+    }
+}